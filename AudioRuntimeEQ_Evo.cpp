@@ -5,7 +5,12 @@
 
 #include <Arduino.h>
 #include <math.h>
+#include <string.h>
+#include <atomic>
 #include "Audio.h"
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
+#include <FS.h>
 
 #ifndef ENABLE_RUNTIME_EQ
 #define ENABLE_RUNTIME_EQ 1
@@ -15,6 +20,21 @@
 #define ENABLE_RUNTIME_ANALYZER 1
 #endif
 
+// Kompensacja głośności (loudness) zależna od volumeValue
+#ifndef ENABLE_RUNTIME_LOUDNESS
+#define ENABLE_RUNTIME_LOUDNESS 1
+#endif
+
+// Stopień mid/side (szerokość stereo + mono basu)
+#ifndef ENABLE_RUNTIME_STEREO_WIDTH
+#define ENABLE_RUNTIME_STEREO_WIDTH 1
+#endif
+
+// Tryb liniowo-fazowy (FIR, splot partycjonowany FFT) – ok. 50 kB RAM po włączeniu
+#ifndef ENABLE_RUNTIME_EQ_FIR
+#define ENABLE_RUNTIME_EQ_FIR 1
+#endif
+
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
 #endif
@@ -32,6 +52,7 @@ extern bool  eqAnalyzerNormalize;
 extern bool  eqAnalyzerAGC;
 extern uint8_t volumeValue;  // dodajemy extern do volumeValue
 extern uint8_t maxVolume;   // from main.cpp - max volume steps (21 or 42)
+extern fs::FS& getStorage();
 
 // ─────────────────────────────────────
 // Konfiguracja korektora
@@ -46,18 +67,15 @@ static const int CODEC_PCM         = 0;   // dodane: PCM (surowy dźwięk)
 //#define ANALYZER_AGC_SPEED    (0.01f)  // szybkość reakcji AGC (0.01 = wolno, 0.001 = szybko)
 
 static bool  eq_inited  = false;
+static bool  eq_fir_was_on = false;   // doFIR z poprzedniego callbacku (reset stanów przy przełączeniu)
 static float fs_rate    = 48000.0f;
 static bool  eq_is_flac = false;
 static int   last_codec = -1;
 
-// częstotliwości środkowe 16 pasm (log 20..20k)
-static float center_freqs[EQ_BANDS];
-
-// ostatnie zastosowane gainy (dla sprawdzania zmian)
-static float last_gains[EQ_BANDS];
-
-// współczynniki biquadów
-static float b0_c[EQ_BANDS], b1_c[EQ_BANDS], b2_c[EQ_BANDS], a1_c[EQ_BANDS], a2_c[EQ_BANDS];
+// współczynniki biquada (znormalizowane przez a0)
+struct BiquadCoeffs {
+    float b0, b1, b2, a1, a2;
+};
 
 // stan filtrów: [pasmo][kanał]
 struct BiquadState {
@@ -66,6 +84,71 @@ struct BiquadState {
 };
 static BiquadState state[EQ_BANDS][2];
 
+// Tryb parametryczny – definicje pasm (lustro UI, zapisywane w /peq.cfg)
+static const char* kPeqCfgPath = "/peq.cfg";
+static EqPeqBand   eqPeqBands[EQ_BANDS];
+static bool        eqPeqBandsInited = false;
+static bool        eqParametric     = false;
+
+// fs, dla którego publikujący liczy współczynniki (ustawia wątek audio)
+static std::atomic<uint32_t> eqCoeffFs{48000};
+
+// ─────────────────────────────────────
+// Skrzynka parametrów UI → wątek audio
+// ─────────────────────────────────────
+struct LoudBank;   // tablica półek loudness dla wszystkich kroków głośności
+
+// Web/pilot zapisują kompletny blok parametrów i podbijają numer sekwencji
+// (nieparzysty = zapis w toku). Callback audio porównuje tylko jeden uint32
+// i kopiuje blok wyłącznie po zmianie – bez skanowania 16 floatów i bez
+// rozerwanych aktualizacji.
+struct EqParamBlock {
+    float gains[EQ_BANDS];
+    bool  eqEnabled;
+    bool  analyzerEnabled;
+    float sensitivity;
+    bool  agc;
+    bool  normalize;
+    bool  linearPhase;
+    bool  loudness;
+    float stereoWidth;      // 0 = mono, 1 = bez zmian, 2 = poszerzenie
+    float bassMonoHz;       // 0 = wyłączone, inaczej crossover HPF kanału S
+    bool  parametric;       // pasma z eqPeqBands zamiast grafika 16 × peak Q=1
+
+    // Współczynniki liczy publikujący (poza wątkiem audio). Lista aktywnych
+    // pasm jest zwarta, więc pasma wyłączone / 0 dB nie kosztują ani cyklu.
+    float        coeffFs;
+    uint8_t      activeCount;
+    uint8_t      activeBand[EQ_BANDS];
+    BiquadCoeffs coeffs[EQ_BANDS];
+    BiquadCoeffs msHpf;     // HPF kanału S (mono basu), jednostkowy gdy bassMonoHz = 0
+
+    // Gotowa tablica loudness (buduje eqWorker); wpisywana przy zapisie bloku
+    const LoudBank* loud;
+};
+
+static EqParamBlock          eqParamShared;          // zapisywany tylko pod eqParamMux
+static const LoudBank*       loudReady = nullptr;    // najnowszy bank loudness (zmieniany pod eqParamMux)
+static std::atomic<uint32_t> eqParamSeq{0};          // 0 = jeszcze nic nie opublikowano
+static portMUX_TYPE          eqParamMux = portMUX_INITIALIZER_UNLOCKED;
+
+static EqParamBlock eqParamAudio = {                 // lokalna kopia wątku audio
+    {0}, false, false, DEFAULT_ANALYZER_SENSITIVITY, false, false, false, false, 1.0f, 0.0f
+};
+static uint32_t     eqParamAudioSeq = 0;
+
+// Banki loudness, których eqWorker nie może nadpisać: loudInUse = bank z kopii
+// wątku audio, loudClaim = bank z bloku, który audio właśnie kopiuje (zajęty
+// przed kopią, zwalniany zaraz po niej – krótko, jak firBlockSeq dla FIR).
+static std::atomic<const LoudBank*> loudInUse{nullptr};
+static std::atomic<const LoudBank*> loudClaim{nullptr};
+static bool loudRequested = false;                   // audio już poprosiło eqWorker o tablicę
+
+static bool eqLinearPhase = false;                   // lustro UI dla trybu FIR
+static bool eqLoudness    = false;                   // lustro UI dla loudness
+static float eqStereoWidth = 1.0f;                   // lustro UI dla mid/side
+static float eqBassMonoHz  = 0.0f;
+
 // ─────────────────────────────────────
 // Konfiguracja analizatora (FFT)
 // ─────────────────────────────────────
@@ -157,50 +240,201 @@ static void analyzer_init_tables()
 // Pomocnicze – EQ
 // ─────────────────────────────────────
 
-static void compute_center_freqs() {
+// częstotliwość środkowa pasma grafika (log 20..20k)
+static float eq_center_freq(int band) {
     const float f0 = 20.0f;
     const float f1 = 20000.0f;
+    float t = (float)band / (float)(EQ_BANDS - 1);
+    return f0 * powf(f1 / f0, t);
+}
+
+// Biquad RBJ (Audio EQ Cookbook) dowolnego typu
+static BiquadCoeffs eq_design_biquad(uint8_t type, float f0, float Q, float gainDb, float fs) {
+    if (f0 > 0.45f * fs) f0 = 0.45f * fs;
+    if (Q < 0.1f) Q = 0.1f;
+
+    float A     = powf(10.0f, gainDb / 40.0f);
+    float w0    = 2.0f * (float)M_PI * f0 / fs;
+    float cosw0 = cosf(w0);
+    float alpha = sinf(w0) / (2.0f * Q);
+    float sA2a  = 2.0f * sqrtf(A) * alpha;
+
+    float b0 = 1.0f, b1 = 0.0f, b2 = 0.0f, a0 = 1.0f, a1 = 0.0f, a2 = 0.0f;
+    switch (type) {
+        case PEQ_PEAK:
+            b0 = 1.0f + alpha * A;
+            b1 = -2.0f * cosw0;
+            b2 = 1.0f - alpha * A;
+            a0 = 1.0f + alpha / A;
+            a1 = -2.0f * cosw0;
+            a2 = 1.0f - alpha / A;
+            break;
+        case PEQ_LOWSHELF:
+            b0 =        A * ((A + 1.0f) - (A - 1.0f) * cosw0 + sA2a);
+            b1 = 2.0f * A * ((A - 1.0f) - (A + 1.0f) * cosw0);
+            b2 =        A * ((A + 1.0f) - (A - 1.0f) * cosw0 - sA2a);
+            a0 =             (A + 1.0f) + (A - 1.0f) * cosw0 + sA2a;
+            a1 =    -2.0f * ((A - 1.0f) + (A + 1.0f) * cosw0);
+            a2 =             (A + 1.0f) + (A - 1.0f) * cosw0 - sA2a;
+            break;
+        case PEQ_HIGHSHELF:
+            b0 =         A * ((A + 1.0f) + (A - 1.0f) * cosw0 + sA2a);
+            b1 = -2.0f * A * ((A - 1.0f) + (A + 1.0f) * cosw0);
+            b2 =         A * ((A + 1.0f) + (A - 1.0f) * cosw0 - sA2a);
+            a0 =              (A + 1.0f) - (A - 1.0f) * cosw0 + sA2a;
+            a1 =      2.0f * ((A - 1.0f) - (A + 1.0f) * cosw0);
+            a2 =              (A + 1.0f) - (A - 1.0f) * cosw0 - sA2a;
+            break;
+        case PEQ_HIGHPASS:
+            b0 =  (1.0f + cosw0) * 0.5f;
+            b1 = -(1.0f + cosw0);
+            b2 =  (1.0f + cosw0) * 0.5f;
+            a0 =  1.0f + alpha;
+            a1 = -2.0f * cosw0;
+            a2 =  1.0f - alpha;
+            break;
+        case PEQ_LOWPASS:
+            b0 = (1.0f - cosw0) * 0.5f;
+            b1 =  1.0f - cosw0;
+            b2 = (1.0f - cosw0) * 0.5f;
+            a0 =  1.0f + alpha;
+            a1 = -2.0f * cosw0;
+            a2 =  1.0f - alpha;
+            break;
+        case PEQ_NOTCH:
+            b0 =  1.0f;
+            b1 = -2.0f * cosw0;
+            b2 =  1.0f;
+            a0 =  1.0f + alpha;
+            a1 = -2.0f * cosw0;
+            a2 =  1.0f - alpha;
+            break;
+        default:
+            break;
+    }
+    BiquadCoeffs c = { b0 / a0, b1 / a0, b2 / a0, a1 / a0, a2 / a0 };
+    return c;
+}
+
+// Domyślne pasma parametryczne: jak grafik (peak Q=1 na środkach pasm, 0 dB)
+static void eq_peq_defaults() {
     for (int i = 0; i < EQ_BANDS; ++i) {
-        float t = (float)i / (float)(EQ_BANDS - 1);
-        center_freqs[i] = f0 * powf(f1 / f0, t);
+        eqPeqBands[i].type   = PEQ_PEAK;
+        eqPeqBands[i].freq   = eq_center_freq(i);
+        eqPeqBands[i].q      = 1.0f;
+        eqPeqBands[i].gainDb = 0.0f;
     }
+    eqPeqBandsInited = true;
 }
 
-static void recompute_coeffs(const float gains_db[EQ_BANDS]) {
-    const float Q = 1.0f;  // stałe Q dla prostego grafika
+// Współczynniki + zwarta lista aktywnych pasm dla publikowanego bloku.
+// Pasmo jest pomijane, gdy jest wyłączone albo (peak/półka) ma ~0 dB.
+static void eq_build_coeffs(EqParamBlock& p) {
+    if (!eqPeqBandsInited) eq_peq_defaults();
+
+    float fs = (float)eqCoeffFs.load(std::memory_order_acquire);
+    p.coeffFs     = fs;
+    p.activeCount = 0;
 
     for (int i = 0; i < EQ_BANDS; ++i) {
-        float gdb = gains_db[i];
-
-        // blisko 0 dB → bypass
-        if (fabsf(gdb) < 0.25f) {
-            b0_c[i] = 1.0f;
-            b1_c[i] = 0.0f;
-            b2_c[i] = 0.0f;
-            a1_c[i] = 0.0f;
-            a2_c[i] = 0.0f;
-            continue;
+        uint8_t type;
+        float   f, q, g;
+        if (p.parametric) {
+            type = eqPeqBands[i].type;
+            f    = eqPeqBands[i].freq;
+            q    = eqPeqBands[i].q;
+            g    = eqPeqBands[i].gainDb;
+        } else {
+            type = PEQ_PEAK;
+            f    = eq_center_freq(i);
+            q    = 1.0f;              // stałe Q dla prostego grafika
+            g    = p.gains[i];
+        }
+
+        bool gainType = (type == PEQ_PEAK || type == PEQ_LOWSHELF || type == PEQ_HIGHSHELF);
+        if (type == PEQ_OFF || (gainType && fabsf(g) < 0.25f)) {
+            continue;   // blisko 0 dB → bypass
         }
 
-        float A     = powf(10.0f, gdb / 40.0f);
-        float w0    = 2.0f * (float)M_PI * center_freqs[i] / fs_rate;
-        float cosw0 = cosf(w0);
-        float sinw0 = sinf(w0);
-        float alpha = sinw0 / (2.0f * Q);
+        p.coeffs[i] = eq_design_biquad(type, f, q, g, fs);
+        p.activeBand[p.activeCount++] = (uint8_t)i;
+    }
+
+    // crossover mono basu: HPF RBJ Butterworth na kanale S
+    if (p.bassMonoHz > 0.0f) {
+        p.msHpf = eq_design_biquad(PEQ_HIGHPASS, p.bassMonoHz, 0.7071f, 0.0f, fs);
+    } else {
+        p.msHpf = {1.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+    }
+}
+
+// ─────────────────────────────────────
+// Publikacja / odbiór bloku parametrów
+// ─────────────────────────────────────
+
+// Strona UI: może być wołana z loop() i z zadania serwera WWW jednocześnie,
+// więc zapisujący są serializowani; czytelnik (audio) nigdy nie czeka.
+static void eq_params_write(const EqParamBlock& p) {
+    portENTER_CRITICAL(&eqParamMux);
+    uint32_t seq = eqParamSeq.load(std::memory_order_relaxed);
+    eqParamSeq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    memcpy(&eqParamShared, &p, sizeof(EqParamBlock));
+    eqParamShared.loud = loudReady;   // pod muteksem – blok zawsze z najnowszym bankiem
+    eqParamSeq.store(seq + 2, std::memory_order_release);
+    portEXIT_CRITICAL(&eqParamMux);
+}
 
-        // peaking EQ (RBJ Audio Cookbook)
-        float a0 = 1.0f + alpha / A;
-        float b0 = 1.0f + alpha * A;
-        float b1 = -2.0f * cosw0;
-        float b2 = 1.0f - alpha * A;
-        float a1 = -2.0f * cosw0;
-        float a2 = 1.0f - alpha / A;
+// Strona audio: jedno porównanie na callback; true = przyszedł nowy blok.
+// Przy trafieniu w trwający zapis zostajemy przy starej kopii do następnego callbacku.
+static bool eq_params_fetch() {
+    uint32_t seq = eqParamSeq.load(std::memory_order_acquire);
+    if (seq == eqParamAudioSeq || (seq & 1u)) {
+        return false;
+    }
+    // bank zajęty przed kopią – eqWorker, który go jeszcze nie widzi w
+    // eqParamShared, zobaczy go tutaj (a po udanej kopii w loudInUse)
+    loudClaim.store(eqParamShared.loud);
+    EqParamBlock tmp;
+    memcpy(&tmp, &eqParamShared, sizeof(EqParamBlock));
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (eqParamSeq.load() != seq) {
+        loudClaim.store(nullptr);
+        return false;
+    }
+    // zmiana trybu grafik ↔ parametryczny: stany filtrów nie pasują do nowych pasm
+    bool modeChanged = (tmp.parametric != eqParamAudio.parametric);
+
+    eqParamAudio    = tmp;
+    eqParamAudioSeq = seq;
+    loudInUse.store(eqParamAudio.loud);
+    loudClaim.store(nullptr);
+    loudRequested = false;
+
+    // pasma nieaktywne startują od zera po ponownym włączeniu
+    bool active[EQ_BANDS] = {false};
+    for (int k = 0; k < eqParamAudio.activeCount; ++k) active[eqParamAudio.activeBand[k]] = true;
+    for (int i = 0; i < EQ_BANDS; ++i) {
+        if (modeChanged || !active[i]) {
+            state[i][0] = {0,0,0,0};
+            state[i][1] = {0,0,0,0};
+        }
+    }
+    return true;
+}
 
-        b0_c[i] = b0 / a0;
-        b1_c[i] = b1 / a0;
-        b2_c[i] = b2 / a0;
-        a1_c[i] = a1 / a0;
-        a2_c[i] = a2 / a0;
+// Odczyt dla innych wątków (projektant FIR) – ponawia aż trafi w stabilny blok.
+static void eq_params_read(EqParamBlock& out) {
+    for (;;) {
+        uint32_t seq = eqParamSeq.load(std::memory_order_acquire);
+        if (!(seq & 1u)) {
+            memcpy(&out, &eqParamShared, sizeof(EqParamBlock));
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (eqParamSeq.load(std::memory_order_relaxed) == seq) {
+                return;
+            }
+        }
+        vTaskDelay(1);
     }
 }
 
@@ -255,6 +489,441 @@ static void fft_complex(float re[], float im[], int N) {
     }
 }
 
+// ─────────────────────────────────────
+// Zadanie robocze EQ (niski priorytet, poza wątkiem audio)
+// ─────────────────────────────────────
+// Ciężkie przeliczenia – współczynniki po zmianie fs, projekt FIR – robi
+// zadanie eqWorker. Wątek audio tylko ustawia bity powiadomienia.
+static const uint32_t EQ_WORK_REPUBLISH  = 1u << 0;   // przelicz współczynniki (np. nowe fs)
+static const uint32_t EQ_WORK_FIR_DESIGN = 1u << 1;   // zaprojektuj FIR do wolnego banku
+static const uint32_t EQ_WORK_LOUD_TABLE = 1u << 2;   // tablica loudness dla nowego fs / maxVolume
+
+static TaskHandle_t eqWorkerHandle = nullptr;
+
+static void eq_worker_request(uint32_t bits) {
+    if (eqWorkerHandle) xTaskNotify(eqWorkerHandle, bits, eSetBits);
+}
+
+static bool eq_worker_start();
+#if ENABLE_RUNTIME_LOUDNESS
+static bool loud_build_run();
+static bool loud_table_stale(float fs);
+#endif
+
+// ─────────────────────────────────────
+// Tryb liniowo-fazowy: FIR + splot partycjonowany (overlap-save)
+// ─────────────────────────────────────
+// FIR o FIR_TAPS współczynnikach projektowany metodą próbkowania
+// charakterystyki z 16 gainów, dzielony na FIR_PARTS partycji po FIR_BLOCK
+// próbek. Kanały L/R jadą jako jeden sygnał zespolony (L + jR) – filtr jest
+// rzeczywisty, więc jedno FFT obsługuje oba kanały. Opóźnienie bloku to
+// FIR_BLOCK próbek, plus FIR_TAPS/2 opóźnienia grupowego samego filtra.
+// Projekt odbywa się w osobnym zadaniu do nieaktywnego banku, a callback
+// audio przełącza bank atomowo na początku bloku.
+#if ENABLE_RUNTIME_EQ_FIR
+static const int FIR_BLOCK = 128;                    // B – próbek na blok
+static const int FIR_FFT   = 2 * FIR_BLOCK;          // N – rozmiar FFT
+static const int FIR_TAPS  = 1024;                   // długość filtra (~47 Hz rozdzielczości @48k)
+static const int FIR_PARTS = FIR_TAPS / FIR_BLOCK;   // P – liczba partycji
+
+struct FirSpectrum {
+    float re[FIR_FFT];
+    float im[FIR_FFT];
+};
+
+static FirSpectrum* firBank[2]   = {nullptr, nullptr};  // widma partycji filtra (podwójny bufor)
+static FirSpectrum* firFdl       = nullptr;             // linia opóźniająca widm wejścia (P slotów)
+static FirSpectrum* firWork      = nullptr;             // FFT bieżącego okna + akumulator
+static int          firFdlHead   = 0;
+
+static float firInL[FIR_BLOCK],   firInR[FIR_BLOCK];    // zbierany blok
+static float firPrevL[FIR_BLOCK], firPrevR[FIR_BLOCK];  // poprzedni blok (overlap-save)
+static float firOutL[FIR_BLOCK],  firOutR[FIR_BLOCK];   // wynik oddawany z opóźnieniem B
+static int   firPos = 0;
+
+static std::atomic<int>      firActiveBank{0};
+static std::atomic<uint32_t> firBlockSeq{0};      // nieparzysty = blok w toku (licznik bloków ×2)
+static std::atomic<bool>     firReady{false};
+
+// statystyki obciążenia (mierzone na urządzeniu w callbacku audio)
+static uint32_t firStatBlocks = 0;
+static uint32_t firStatAvgUs  = 0;
+static uint32_t firStatMaxUs  = 0;
+
+static void* fir_alloc(size_t bytes) {
+    void* p = heap_caps_malloc(bytes, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if (!p) p = ps_malloc(bytes);
+    if (p) memset(p, 0, bytes);
+    return p;
+}
+
+// Gain [dB] dla częstotliwości f – interpolacja w skali log między środkami pasm
+static float fir_gain_at(const float gains[EQ_BANDS], float f) {
+    const float f0 = 20.0f;
+    const float f1 = 20000.0f;
+    if (f <= f0) return gains[0];
+    if (f >= f1) return gains[EQ_BANDS - 1];
+    float t = logf(f / f0) / logf(f1 / f0) * (float)(EQ_BANDS - 1);
+    int   i = (int)t;
+    if (i >= EQ_BANDS - 1) return gains[EQ_BANDS - 1];
+    float frac = t - (float)i;
+    return gains[i] + (gains[i + 1] - gains[i]) * frac;
+}
+
+// Projekt filtra do banku 'dst' (wątek projektanta, nie audio)
+static bool fir_design(FirSpectrum* dst, const float gains[EQ_BANDS], float fs) {
+    float* re = (float*)malloc(sizeof(float) * FIR_TAPS);
+    float* im = (float*)malloc(sizeof(float) * FIR_TAPS);
+    if (!re || !im) {
+        free(re);
+        free(im);
+        return false;
+    }
+
+    // charakterystyka zero-fazowa (rzeczywista, parzysta)
+    for (int k = 0; k <= FIR_TAPS / 2; ++k) {
+        float f   = (float)k * fs / (float)FIR_TAPS;
+        float mag = powf(10.0f, fir_gain_at(gains, f) / 20.0f);
+        re[k] = mag;
+        if (k > 0 && k < FIR_TAPS / 2) re[FIR_TAPS - k] = mag;
+    }
+    for (int k = 0; k < FIR_TAPS; ++k) im[k] = 0.0f;
+
+    // widmo parzyste → FFT daje odpowiedź impulsową (z dokładnością do skali)
+    fft_complex(re, im, FIR_TAPS);
+
+    // przesunięcie o TAPS/2 (filtr przyczynowy, liniowa faza) + okno Blackmana
+    float* h = im;  // im nie jest już potrzebne
+    const float invT = 1.0f / (float)FIR_TAPS;
+    for (int n = 0; n < FIR_TAPS; ++n) {
+        int   src = (n + FIR_TAPS / 2) & (FIR_TAPS - 1);
+        float ph  = 2.0f * (float)M_PI * (float)n / (float)FIR_TAPS;
+        float w   = 0.42f - 0.5f * cosf(ph) + 0.08f * cosf(2.0f * ph);
+        h[n] = re[src] * invT * w;
+    }
+
+    // widma partycji; 1/N odwrotnego FFT wliczone od razu w filtr
+    const float invN = 1.0f / (float)FIR_FFT;
+    for (int p = 0; p < FIR_PARTS; ++p) {
+        FirSpectrum& part = dst[p];
+        for (int i = 0; i < FIR_FFT; ++i) {
+            part.re[i] = (i < FIR_BLOCK) ? h[p * FIR_BLOCK + i] * invN : 0.0f;
+            part.im[i] = 0.0f;
+        }
+        fft_complex(part.re, part.im, FIR_FFT);
+    }
+
+    free(re);
+    free(im);
+    return true;
+}
+
+static void fir_reset_state() {
+    if (firFdl) memset(firFdl, 0, sizeof(FirSpectrum) * FIR_PARTS);
+    memset(firInL, 0, sizeof(firInL));     memset(firInR, 0, sizeof(firInR));
+    memset(firPrevL, 0, sizeof(firPrevL)); memset(firPrevR, 0, sizeof(firPrevR));
+    memset(firOutL, 0, sizeof(firOutL));   memset(firOutR, 0, sizeof(firOutR));
+    firPos = 0;
+    firFdlHead = 0;
+}
+
+// Projekt do nieaktywnego banku i zamiana (wołane z zadania eqWorker)
+static void fir_design_run() {
+    EqParamBlock p;
+    eq_params_read(p);
+    if (!p.linearPhase || !firBank[0]) return;
+
+    int target = firActiveBank.load() ^ 1;
+
+    // Bank docelowy mógł czytać tylko blok rozpoczęty przed ostatnią zamianą.
+    // Blok podbija licznik przed odczytem aktywnego banku, więc każdy blok
+    // zaczęty po tym odczycie licznika widzi już bank != target – wystarczy
+    // doczekać końca bloku trwającego teraz.
+    uint32_t blk = firBlockSeq.load();
+    if (blk & 1u) {
+        while (firBlockSeq.load() == blk) vTaskDelay(1);
+    }
+
+    float fs = (float)eqCoeffFs.load(std::memory_order_acquire);
+    if (fir_design(firBank[target], p.gains, fs)) {
+        firActiveBank.store(target, std::memory_order_release);
+        firReady.store(true, std::memory_order_release);
+    }
+}
+
+static void fir_request_design() {
+    eq_worker_request(EQ_WORK_FIR_DESIGN);
+}
+
+// Pierwsze włączenie trybu – bufory i zadanie tworzone leniwie
+static bool fir_init() {
+    if (firBank[0]) return eq_worker_start();
+
+    firBank[0] = (FirSpectrum*)fir_alloc(sizeof(FirSpectrum) * FIR_PARTS);
+    firBank[1] = (FirSpectrum*)fir_alloc(sizeof(FirSpectrum) * FIR_PARTS);
+    firFdl     = (FirSpectrum*)fir_alloc(sizeof(FirSpectrum) * FIR_PARTS);
+    firWork    = (FirSpectrum*)fir_alloc(sizeof(FirSpectrum) * 2);
+    if (!firBank[0] || !firBank[1] || !firFdl || !firWork) {
+        Serial.println("EQ FIR: brak pamięci, tryb liniowo-fazowy niedostępny");
+        return false;
+    }
+    fir_reset_state();
+    return eq_worker_start();
+}
+
+// Jeden blok overlap-save (wątek audio)
+static void fir_process_block() {
+    int64_t t0 = esp_timer_get_time();
+
+    // najpierw znacznik bloku, dopiero potem wybór banku (kolejność seq_cst – patrz fir_design_run)
+    firBlockSeq.fetch_add(1);
+    int bank = firActiveBank.load();
+    const FirSpectrum* H = firBank[bank];
+
+    // okno [poprzedni blok | bieżący blok] jako L + jR
+    FirSpectrum& X   = firWork[0];
+    FirSpectrum& acc = firWork[1];
+    for (int i = 0; i < FIR_BLOCK; ++i) {
+        X.re[i]             = firPrevL[i];
+        X.im[i]             = firPrevR[i];
+        X.re[FIR_BLOCK + i] = firInL[i];
+        X.im[FIR_BLOCK + i] = firInR[i];
+    }
+    memcpy(firPrevL, firInL, sizeof(firInL));
+    memcpy(firPrevR, firInR, sizeof(firInR));
+
+    fft_complex(X.re, X.im, FIR_FFT);
+
+    // nowe widmo na czoło linii opóźniającej
+    firFdlHead = (firFdlHead + FIR_PARTS - 1) % FIR_PARTS;
+    memcpy(&firFdl[firFdlHead], &X, sizeof(FirSpectrum));
+
+    // suma iloczynów widm: Y = Σ X[k-p] · H[p]
+    memset(&acc, 0, sizeof(FirSpectrum));
+    int slot = firFdlHead;
+    for (int p = 0; p < FIR_PARTS; ++p) {
+        const FirSpectrum& xs = firFdl[slot];
+        const FirSpectrum& hs = H[p];
+        for (int k = 0; k < FIR_FFT; ++k) {
+            float xr = xs.re[k], xi = xs.im[k];
+            float hr = hs.re[k], hi = hs.im[k];
+            acc.re[k] += xr * hr - xi * hi;
+            acc.im[k] += xr * hi + xi * hr;
+        }
+        if (++slot >= FIR_PARTS) slot = 0;
+    }
+
+    // IFFT przez sprzężenie: y = conj(FFT(conj(Y))) (1/N jest już w H)
+    for (int k = 0; k < FIR_FFT; ++k) acc.im[k] = -acc.im[k];
+    fft_complex(acc.re, acc.im, FIR_FFT);
+
+    // overlap-save: poprawna jest tylko druga połowa okna
+    for (int i = 0; i < FIR_BLOCK; ++i) {
+        firOutL[i] =  acc.re[FIR_BLOCK + i];
+        firOutR[i] = -acc.im[FIR_BLOCK + i];
+    }
+
+    firBlockSeq.fetch_add(1, std::memory_order_release);
+
+    uint32_t us = (uint32_t)(esp_timer_get_time() - t0);
+    firStatBlocks++;
+    firStatAvgUs = (firStatBlocks == 1) ? us : (firStatAvgUs * 15 + us) / 16;
+    if (us > firStatMaxUs) firStatMaxUs = us;
+}
+
+// Próbka wchodzi, próbka sprzed FIR_BLOCK wychodzi
+static inline void fir_push_pop(float& yL, float& yR) {
+    firInL[firPos] = yL;
+    firInR[firPos] = yR;
+    yL = firOutL[firPos];
+    yR = firOutR[firPos];
+    if (++firPos >= FIR_BLOCK) {
+        firPos = 0;
+        fir_process_block();
+    }
+}
+#endif // ENABLE_RUNTIME_EQ_FIR
+
+static void eq_worker_task(void* arg) {
+    (void)arg;
+    for (;;) {
+        uint32_t bits = 0;
+        xTaskNotifyWait(0, 0xFFFFFFFFu, &bits, portMAX_DELAY);
+
+#if ENABLE_RUNTIME_LOUDNESS
+        // nowa tablica wchodzi do toru razem z ponowną publikacją bloku
+        if ((bits & (EQ_WORK_LOUD_TABLE | EQ_WORK_REPUBLISH)) && loud_build_run()) {
+            bits |= EQ_WORK_REPUBLISH;
+        }
+#endif
+        if (bits & EQ_WORK_REPUBLISH) {
+            eq_params_publish();
+        }
+#if ENABLE_RUNTIME_EQ_FIR
+        if (bits & EQ_WORK_FIR_DESIGN) {
+            fir_design_run();
+        }
+#endif
+    }
+}
+
+static bool eq_worker_start() {
+    if (eqWorkerHandle) return true;
+    if (xTaskCreatePinnedToCore(eq_worker_task, "eqWorker", 4096, nullptr, 1,
+                                &eqWorkerHandle, 0) != pdPASS) {
+        eqWorkerHandle = nullptr;
+        return false;
+    }
+    return true;
+}
+
+// ─────────────────────────────────────
+// Loudness – kontur równej głośności wg kroku głośności
+// ─────────────────────────────────────
+// Przy cichym słuchaniu ucho traci basy (i trochę góry) – krzywe ISO 226
+// rozjeżdżają się o ~10-15 dB przy 100 Hz między 80 a 40 fonów. Przybliżamy
+// to półką niską 100 Hz i wysoką 8 kHz, których wzmocnienie rośnie z
+// tłumieniem głośności. Współczynniki liczy z góry eqWorker dla każdego kroku
+// 0..maxVolume, więc zmiana głośności w callbacku to tylko indeks w tablicy.
+// Gotowa tablica (jeden z trzech banków) jedzie do audio wskaźnikiem w
+// bloku parametrów; nowa powstaje w banku, którego nie ma ani w ostatnim
+// bloku, ani w kopii wątku audio.
+#if ENABLE_RUNTIME_LOUDNESS
+static const int   LOUD_MAX_STEPS    = 42;       // największy maxVolume w main.cpp
+static const float LOUD_LOW_HZ       = 100.0f;
+static const float LOUD_HIGH_HZ      = 8000.0f;
+static const float LOUD_LOW_PER_DB   = 0.40f;    // dB podbicia basu na dB tłumienia
+static const float LOUD_HIGH_PER_DB  = 0.15f;    // dB podbicia góry na dB tłumienia
+static const float LOUD_LOW_MAX_DB   = 12.0f;
+static const float LOUD_HIGH_MAX_DB  = 6.0f;
+static const float LOUD_MAX_ATTEN_DB = 40.0f;
+
+struct LoudBank {
+    BiquadCoeffs low[LOUD_MAX_STEPS + 1];
+    BiquadCoeffs high[LOUD_MAX_STEPS + 1];
+    bool         active[LOUD_MAX_STEPS + 1];   // false = krok bez korekcji (bypass)
+    float        fs;
+    uint8_t      steps;
+};
+
+// 4 banki: gotowy, ten w eqParamShared, loudInUse i loudClaim – zawsze zostaje wolny,
+// gdy loudClaim jest pusty
+static const int LOUD_BANKS = 4;
+static LoudBank*   loudBanks[LOUD_BANKS] = {nullptr};                // alokowane przy pierwszej tablicy
+static BiquadState loudState[2][2];                               // [półka][kanał] – tylko wątek audio
+static bool        loudWasOn = false;                             // doLoud z poprzedniego callbacku
+
+static uint8_t loud_steps(uint8_t steps) {
+    if (steps == 0) steps = 1;
+    return (steps > LOUD_MAX_STEPS) ? LOUD_MAX_STEPS : steps;
+}
+
+// true = brak tablicy albo liczona dla innego fs / maxVolume
+static bool loud_table_stale(float fs) {
+    const LoudBank* b = loudReady;
+    return !b || b->fs != fs || b->steps != loud_steps(maxVolume);
+}
+
+// Tablica dla wszystkich kroków (eqWorker)
+static void loud_build_table(LoudBank& t, float fs, uint8_t steps) {
+    steps = loud_steps(steps);
+
+    for (int v = 0; v <= steps; ++v) {
+        // tłumienie wynikające z liniowego volNorm = v / steps
+        float atten = (v == 0) ? LOUD_MAX_ATTEN_DB
+                               : -20.0f * log10f((float)v / (float)steps);
+        if (atten > LOUD_MAX_ATTEN_DB) atten = LOUD_MAX_ATTEN_DB;
+
+        float lowDb  = fminf(LOUD_LOW_MAX_DB,  atten * LOUD_LOW_PER_DB);
+        float highDb = fminf(LOUD_HIGH_MAX_DB, atten * LOUD_HIGH_PER_DB);
+
+        t.active[v] = (lowDb >= 0.1f || highDb >= 0.1f);
+        // półki RBJ ze zboczem S = 1 (Q = 1/√2)
+        t.low[v]    = eq_design_biquad(PEQ_LOWSHELF,  LOUD_LOW_HZ,  0.7071f, lowDb,  fs);
+        t.high[v]   = eq_design_biquad(PEQ_HIGHSHELF, LOUD_HIGH_HZ, 0.7071f, highDb, fs);
+    }
+    t.fs    = fs;
+    t.steps = steps;
+}
+
+// Nowa tablica, gdy loudness jest włączony, a gotowa nie pasuje (eqWorker).
+// true = podmieniono bank – trzeba opublikować blok.
+static bool loud_build_run() {
+    float fs = (float)eqCoeffFs.load(std::memory_order_acquire);
+    if (!eqLoudness || !loud_table_stale(fs)) return false;
+
+    // Kolejność odczytów ma znaczenie: eqParamShared, potem loudClaim, potem
+    // loudInUse (audio ustawia loudInUse przed wyczyszczeniem loudClaim).
+    // Bank wybrany tutaj nie trafi do audio, zanim go nie opublikujemy.
+    LoudBank* dst = nullptr;
+    for (;;) {
+        portENTER_CRITICAL(&eqParamMux);
+        const LoudBank* ready  = loudReady;
+        const LoudBank* shared = eqParamShared.loud;
+        portEXIT_CRITICAL(&eqParamMux);
+        const LoudBank* claim = loudClaim.load();
+        const LoudBank* used  = loudInUse.load();
+
+        for (int i = 0; i < LOUD_BANKS && !dst; ++i) {
+            if (!loudBanks[i]) {
+                loudBanks[i] = (LoudBank*)heap_caps_malloc(sizeof(LoudBank), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+                if (!loudBanks[i]) return false;
+            }
+            const LoudBank* b = loudBanks[i];
+            if (b != ready && b != shared && b != claim && b != used) dst = loudBanks[i];
+        }
+        if (dst) break;
+        vTaskDelay(1);   // wszystkie zajęte – audio właśnie kopiuje blok (loudClaim)
+    }
+
+    loud_build_table(*dst, fs, maxVolume);
+    portENTER_CRITICAL(&eqParamMux);
+    loudReady = dst;
+    portEXIT_CRITICAL(&eqParamMux);
+    return true;
+}
+
+static inline float loud_biquad(const BiquadCoeffs& c, BiquadState& st, float x) {
+    float y = c.b0 * x + c.b1 * st.x1 + c.b2 * st.x2 - c.a1 * st.y1 - c.a2 * st.y2;
+    st.x2 = st.x1;
+    st.x1 = x;
+    st.y2 = st.y1;
+    st.y1 = y;
+    return y;
+}
+#endif // ENABLE_RUNTIME_LOUDNESS
+
+// ─────────────────────────────────────
+// Mid/side – szerokość stereo i mono basu
+// ─────────────────────────────────────
+// M = (L+R)/2, S = (L-R)/2; S przechodzi przez HPF (crossover mono basu)
+// i jest skalowany szerokością, potem L = M+S', R = M-S'. Liczone w tej
+// samej pętli float co korektor, przed biquadami – bez dodatkowego
+// przebiegu i kwantyzacji do int16. HPF projektuje publikujący
+// (EqParamBlock::msHpf); wyłączony crossover to biquad jednostkowy.
+#if ENABLE_RUNTIME_STEREO_WIDTH
+static BiquadState msState = {0, 0, 0, 0};
+static bool        msWasOn = false;   // mid/side w poprzednim callbacku
+
+static inline bool stereo_is_active() {
+    return eqParamAudio.stereoWidth != 1.0f || eqParamAudio.bassMonoHz > 0.0f;
+}
+#endif // ENABLE_RUNTIME_STEREO_WIDTH
+
+// ─────────────────────────────────────
+// Pomiar kosztu etapów DSP (na urządzeniu)
+// ─────────────────────────────────────
+static uint32_t dspStatCallbacks  = 0;
+static uint32_t dspStatFrames     = 0;
+static uint32_t dspStatEqAvgUs    = 0;   // pętla mid/side/EQ/loudness/volume (średnia krocząca)
+static uint32_t dspStatEqMaxUs    = 0;
+static uint32_t dspStatLastFrames = 0;
+
+static inline void dsp_stat_update(uint32_t& avg, uint32_t& mx, uint32_t us) {
+    avg = (dspStatCallbacks <= 1) ? us : (avg * 15 + us) / 16;
+    if (us > mx) mx = us;
+}
+
 // Liczy analizator z aktualnego bufora próbek
 static void analyzer_compute_from_buffer() {
 #if ENABLE_RUNTIME_ANALYZER
@@ -501,12 +1170,272 @@ void eq_set_all_gains(const float in[RUNTIME_EQ_BANDS]) {
         eqBandGains[i] = g;
     }
 
-    if (eq_inited) {
-        for (int i = 0; i < EQ_BANDS; ++i) {
-            last_gains[i] = (i < RUNTIME_EQ_BANDS) ? eqBandGains[i] : 0.0f;
+    // współczynniki przelicza wątek audio po odebraniu nowego bloku
+    eq_params_publish();
+}
+
+void eq_params_publish() {
+    EqParamBlock p;
+    for (int i = 0; i < EQ_BANDS; ++i) {
+        p.gains[i] = (i < RUNTIME_EQ_BANDS) ? eqBandGains[i] : 0.0f;
+    }
+    p.eqEnabled       = eqEnabled;
+    p.analyzerEnabled = eqAnalyzerEnabled;
+    p.sensitivity     = analyzerCurrentSensitivity;
+    p.agc             = eqAnalyzerAGC;
+    p.normalize       = eqAnalyzerNormalize;
+    p.linearPhase     = eqLinearPhase;
+    p.loudness        = eqLoudness;
+    p.stereoWidth     = eqStereoWidth;
+    p.bassMonoHz      = eqBassMonoHz;
+    p.parametric      = eqParametric;
+    eq_build_coeffs(p);
+    eq_params_write(p);
+    eq_worker_start();
+#if ENABLE_RUNTIME_LOUDNESS
+    if (eqLoudness && loud_table_stale(p.coeffFs)) eq_worker_request(EQ_WORK_LOUD_TABLE);
+#endif
+#if ENABLE_RUNTIME_EQ_FIR
+    if (eqLinearPhase) fir_request_design();
+#endif
+}
+
+void eq_runtime_init() {
+    if (!eqPeqBandsInited) eq_peq_defaults();
+    uint32_t sr = audio.getSampleRate();
+    if (sr > 0) eqCoeffFs.store(sr, std::memory_order_release);
+    eq_worker_start();
+    eq_params_publish();
+}
+
+uint32_t eq_params_get_seq() {
+    return eqParamSeq.load(std::memory_order_acquire);
+}
+
+void eq_set_enabled(bool enabled) {
+    eqEnabled = enabled;
+    eq_params_publish();
+}
+
+bool eq_get_enabled() {
+    return eqEnabled;
+}
+
+void eq_set_analyzer_enabled(bool enabled) {
+    eqAnalyzerEnabled = enabled;
+    eq_params_publish();
+}
+
+void eq_set_linear_phase(bool enabled) {
+#if ENABLE_RUNTIME_EQ_FIR
+    if (enabled && !fir_init()) {
+        enabled = false;
+    }
+    eqLinearPhase = enabled;
+    eq_params_publish();
+#else
+    (void)enabled;
+#endif
+}
+
+bool eq_get_linear_phase() {
+    return eqLinearPhase;
+}
+
+void eq_set_loudness(bool enabled) {
+#if ENABLE_RUNTIME_LOUDNESS
+    eqLoudness = enabled;
+    eq_params_publish();
+#else
+    (void)enabled;
+#endif
+}
+
+bool eq_get_loudness() {
+    return eqLoudness;
+}
+
+void eq_set_stereo_width(float width) {
+    if (width < 0.0f) width = 0.0f;
+    if (width > 2.0f) width = 2.0f;
+    eqStereoWidth = width;
+    eq_params_publish();
+}
+
+float eq_get_stereo_width() {
+    return eqStereoWidth;
+}
+
+void eq_set_bass_mono(float crossoverHz) {
+    if (crossoverHz < 0.0f) crossoverHz = 0.0f;
+    if (crossoverHz > 0.0f && crossoverHz < 40.0f) crossoverHz = 40.0f;
+    if (crossoverHz > 300.0f) crossoverHz = 300.0f;
+    eqBassMonoHz = crossoverHz;
+    eq_params_publish();
+}
+
+float eq_get_bass_mono() {
+    return eqBassMonoHz;
+}
+
+// ─────────────────────────────────────
+// Tryb parametryczny – API i zapis
+// ─────────────────────────────────────
+
+void eq_peq_set_mode(bool parametric) {
+    eqParametric = parametric;
+    eq_params_publish();
+}
+
+bool eq_peq_get_mode() {
+    return eqParametric;
+}
+
+static void eq_peq_clamp(EqPeqBand& b) {
+    if (b.type >= PEQ_TYPE_COUNT) b.type = PEQ_OFF;
+    if (b.freq < 20.0f)     b.freq = 20.0f;
+    if (b.freq > 20000.0f)  b.freq = 20000.0f;
+    if (b.q < 0.1f)         b.q = 0.1f;
+    if (b.q > 18.0f)        b.q = 18.0f;
+    if (b.gainDb >  18.0f)  b.gainDb =  18.0f;
+    if (b.gainDb < -18.0f)  b.gainDb = -18.0f;
+}
+
+bool eq_peq_set_band(int band, const EqPeqBand& b) {
+    if (band < 0 || band >= EQ_BANDS) return false;
+    if (!eqPeqBandsInited) eq_peq_defaults();
+    EqPeqBand c = b;
+    eq_peq_clamp(c);
+    eqPeqBands[band] = c;
+    eq_params_publish();
+    return true;
+}
+
+bool eq_peq_get_band(int band, EqPeqBand* out) {
+    if (!out || band < 0 || band >= EQ_BANDS) return false;
+    if (!eqPeqBandsInited) eq_peq_defaults();
+    *out = eqPeqBands[band];
+    return true;
+}
+
+void eq_peq_load() {
+    eq_peq_defaults();
+    bool parametric = false;
+
+    File f = getStorage().open(kPeqCfgPath, FILE_READ);
+    if (f) {
+        while (f.available()) {
+            String line = f.readStringUntil('\n');
+            line.trim();
+            if (!line.length() || line.startsWith("#")) continue;
+
+            int eq = line.indexOf('=');
+            if (eq <= 0) continue;
+            String k = line.substring(0, eq);
+            String v = line.substring(eq + 1);
+            k.trim();
+            v.trim();
+
+            if (k == "mode") {
+                parametric = v.toInt() != 0;
+            } else if (k.startsWith("b")) {
+                // bN=typ,freq,q,gain
+                int band = k.substring(1).toInt();
+                if (band < 0 || band >= EQ_BANDS) continue;
+                EqPeqBand b = eqPeqBands[band];
+                int c1 = v.indexOf(',');
+                int c2 = (c1 >= 0) ? v.indexOf(',', c1 + 1) : -1;
+                int c3 = (c2 >= 0) ? v.indexOf(',', c2 + 1) : -1;
+                if (c3 < 0) continue;
+                b.type   = (uint8_t)v.substring(0, c1).toInt();
+                b.freq   = v.substring(c1 + 1, c2).toFloat();
+                b.q      = v.substring(c2 + 1, c3).toFloat();
+                b.gainDb = v.substring(c3 + 1).toFloat();
+                eq_peq_clamp(b);
+                eqPeqBands[band] = b;
+            }
         }
-        recompute_coeffs(last_gains);
+        f.close();
     }
+
+    eqParametric = parametric;
+    eq_params_publish();
+}
+
+void eq_peq_save() {
+    if (!eqPeqBandsInited) eq_peq_defaults();
+    File f = getStorage().open(kPeqCfgPath, FILE_WRITE);
+    if (!f) return;
+
+    f.println("# Parametric EQ cfg");
+    f.println("# bN=type,freq,q,gain  (type: 0 off,1 peak,2 lowshelf,3 highshelf,4 hp,5 lp,6 notch)");
+    f.printf("mode=%u\n", eqParametric ? 1 : 0);
+    for (int i = 0; i < EQ_BANDS; ++i) {
+        const EqPeqBand& b = eqPeqBands[i];
+        f.printf("b%d=%u,%.1f,%.3f,%.2f\n", i, b.type, b.freq, b.q, b.gainDb);
+    }
+    f.close();
+}
+
+String eq_peq_to_json() {
+    if (!eqPeqBandsInited) eq_peq_defaults();
+    String s;
+    s.reserve(700);
+    s += "{\"mode\":" + String(eqParametric ? 1 : 0) + ",\"bands\":[";
+    for (int i = 0; i < EQ_BANDS; ++i) {
+        const EqPeqBand& b = eqPeqBands[i];
+        if (i) s += ",";
+        s += "{\"t\":" + String(b.type);
+        s += ",\"f\":" + String(b.freq, 1);
+        s += ",\"q\":" + String(b.q, 3);
+        s += ",\"g\":" + String(b.gainDb, 2) + "}";
+    }
+    s += "]}";
+    return s;
+}
+
+void eq_get_dsp_stats(EqDspStats* out) {
+    if (!out) return;
+    out->callbacks  = dspStatCallbacks;
+    out->frames     = dspStatFrames;
+    out->eqAvgUs    = dspStatEqAvgUs;
+    out->eqMaxUs    = dspStatEqMaxUs;
+    float blockUs   = (fs_rate > 0.0f) ? (float)dspStatLastFrames * 1000000.0f / fs_rate : 0.0f;
+    out->loadPct    = (blockUs > 0.0f)
+                    ? 100.0f * (float)dspStatEqAvgUs / blockUs
+                    : 0.0f;
+}
+
+void eq_reset_dsp_stats() {
+    dspStatCallbacks  = 0;
+    dspStatFrames     = 0;
+    dspStatEqAvgUs    = 0;
+    dspStatEqMaxUs    = 0;
+}
+
+void eq_fir_get_stats(EqFirStats* out) {
+    if (!out) return;
+#if ENABLE_RUNTIME_EQ_FIR
+    out->blocks         = firStatBlocks;
+    out->avgUs          = firStatAvgUs;
+    out->maxUs          = firStatMaxUs;
+    float budgetUs      = (float)FIR_BLOCK * 1000000.0f / fs_rate;
+    out->loadPct        = 100.0f * (float)firStatAvgUs / budgetUs;
+    out->blockSamples   = FIR_BLOCK;
+    out->taps           = FIR_TAPS;
+    out->latencySamples = FIR_BLOCK + FIR_TAPS / 2;
+    out->active         = eqLinearPhase && firReady.load(std::memory_order_acquire);
+#else
+    memset(out, 0, sizeof(EqFirStats));
+#endif
+}
+
+void eq_fir_reset_stats() {
+#if ENABLE_RUNTIME_EQ_FIR
+    firStatBlocks = 0;
+    firStatAvgUs  = 0;
+    firStatMaxUs  = 0;
+#endif
 }
 
 void eq_get_all_gains(float out[RUNTIME_EQ_BANDS]) {
@@ -612,6 +1541,7 @@ void eq_set_analyzer_sensitivity(float sensitivity) {
     if (sensitivity > 2.0f) sensitivity = 2.0f;
     analyzerCurrentSensitivity = sensitivity;
     eqAnalyzerSensitivity = sensitivity;
+    eq_params_publish();
 }
 
 float eq_get_analyzer_sensitivity() {
@@ -628,6 +1558,7 @@ bool eq_get_analyzer_pre_gain() {
 
 void eq_set_analyzer_normalize(bool normalize) {
     eqAnalyzerNormalize = normalize;
+    eq_params_publish();
 }
 
 bool eq_get_analyzer_normalize() {
@@ -639,6 +1570,7 @@ void eq_set_analyzer_agc(bool enableAgc) {
     if (!enableAgc) {
         analyzerAGCGain = 1.0f;
     }
+    eq_params_publish();
 }
 
 bool eq_get_analyzer_agc() {
@@ -670,18 +1602,21 @@ void audio_process_i2s(int16_t* outBuff, int32_t validSamples, bool *continueI2S
         return;
     }
 
-    // Korektor działa zawsze, jeśli eqEnabled == true
-    bool doEQ = eqEnabled;
-
     // inicjalizacja przy pierwszym wywołaniu
     if (!eq_inited) {
         fs_rate = (float)audio.getSampleRate();
         if (fs_rate <= 0.0f) fs_rate = 48000.0f;
-
-        compute_center_freqs();
+        eqCoeffFs.store((uint32_t)fs_rate, std::memory_order_release);
+
+        // Współczynniki liczy eq_runtime_init() / strona UI / eqWorker, nigdy callback.
+        // Bez opublikowanego bloku zostaje blok domyślny (EQ wyłączone, sama głośność);
+        // blok liczony dla innego fs przeliczy eqWorker.
+        eq_params_fetch();
+        if (eqParamAudio.coeffFs != fs_rate) {
+            eq_worker_request(EQ_WORK_REPUBLISH);
+        }
 
         for (int i = 0; i < EQ_BANDS; ++i) {
-            last_gains[i] = (i < RUNTIME_EQ_BANDS) ? eqBandGains[i] : 0.0f;
             state[i][0]   = {0,0,0,0};
             state[i][1]   = {0,0,0,0};
         }
@@ -689,9 +1624,6 @@ void audio_process_i2s(int16_t* outBuff, int32_t validSamples, bool *continueI2S
         int codec = audio.getCodec();
         last_codec = codec;
         eq_is_flac = (codec == CODEC_FLAC);
-
-        recompute_coeffs(last_gains);
-
         // analizator
         fftWriteIndex    = 0;
         fftSamplesFilled = 0;
@@ -710,34 +1642,94 @@ void audio_process_i2s(int16_t* outBuff, int32_t validSamples, bool *continueI2S
                 state[i][0] = {0,0,0,0};
                 state[i][1] = {0,0,0,0};
             }
+
+            // nowa stacja może mieć inne fs – filtry liczone dla starego są nieaktualne
+            float fs = (float)audio.getSampleRate();
+            if (fs > 0.0f && fs != fs_rate) {
+                fs_rate = fs;
+                eqCoeffFs.store((uint32_t)fs_rate, std::memory_order_release);
+                // współczynniki EQ (i FIR) przeliczy eqWorker po ponownej publikacji
+                eq_worker_request(EQ_WORK_REPUBLISH);
+            }
+#if ENABLE_RUNTIME_EQ_FIR
+            if (firFdl) fir_reset_state();
+#endif
         }
+
+        // nowe parametry z UI – jedno porównanie sekwencji zamiast skanu gainów
+        // (współczynniki przychodzą gotowe w bloku)
+        eq_params_fetch();
     }
 
-    // aktualne gainy
-    float gains[EQ_BANDS];
-    for (int i = 0; i < EQ_BANDS; ++i) {
-        gains[i] = (i < RUNTIME_EQ_BANDS) ? eqBandGains[i] : 0.0f;
+    dspStatCallbacks++;
+    dspStatFrames    += (uint32_t)validSamples;
+    dspStatLastFrames = (uint32_t)validSamples;
+
+    // Korektor działa zawsze, jeśli eqEnabled == true (wg ostatniego bloku)
+    bool doEQ = eqParamAudio.eqEnabled;
+    bool doAnalyzer = eqParamAudio.analyzerEnabled;
+
+    // FIR dopiero gdy pierwszy projekt jest gotowy – do tego czasu zostają biquady
+    bool doFIR = false;
+#if ENABLE_RUNTIME_EQ_FIR
+    doFIR = doEQ && !eqParamAudio.parametric && eqParamAudio.linearPhase && firReady.load(std::memory_order_acquire);
+    // Przełączenie toru: FIR wraca z pustą linią opóźniającą (inaczej odegrałby
+    // stary blok przez nowy filtr), a biquady startują od zera po FIR.
+    if (doFIR && !eq_fir_was_on) {
+        fir_reset_state();
+    } else if (!doFIR && eq_fir_was_on) {
+        memset(state, 0, sizeof(state));
     }
+    eq_fir_was_on = doFIR;
+#endif
 
-    // czy trzeba przeliczyć współczynniki
-    bool need_recompute = false;
-    for (int i = 0; i < EQ_BANDS; ++i) {
-        if (fabsf(gains[i] - last_gains[i]) > 0.2f) {
-            need_recompute = true;
-            break;
-        }
+    // volumeValue w main.cpp jest w krokach 0..maxVolume (np. 21 lub 42)
+    // skalujemy do 0..1 używając aktualnego maxVolume, żeby nie było ciszej niż w oryginale
+    uint8_t volStep = volumeValue;
+    float volNorm = 1.0f;
+    if (maxVolume > 0)
+    {
+        if (volStep > maxVolume) volStep = maxVolume;
+        volNorm = (float)volStep / (float)maxVolume;
     }
-    if (need_recompute) {
-        recompute_coeffs(gains);
-        for (int i = 0; i < EQ_BANDS; ++i) {
-            last_gains[i] = gains[i];
-        }
+
+    // loudness: krok głośności → gotowe współczynniki półek
+    bool doLoud = false;
+#if ENABLE_RUNTIME_LOUDNESS
+    static const BiquadCoeffs kLoudFlat = {1.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+    const LoudBank* lb = eqParamAudio.loud;
+    // tablica dla innego fs / maxVolume – nową zbuduje eqWorker (prośba raz na blok parametrów)
+    if (eqParamAudio.loudness && !loudRequested && (!lb || lb->fs != fs_rate || lb->steps != loud_steps(maxVolume))) {
+        eq_worker_request(EQ_WORK_LOUD_TABLE);
+        loudRequested = true;
     }
+    uint8_t loudStep = (lb && volStep > lb->steps) ? lb->steps : volStep;
+    doLoud = eqParamAudio.loudness && lb && lb->active[loudStep];
+    // półki wracają od zera – stan sprzed wyłączenia dałby trzask
+    if (doLoud && !loudWasOn) memset(loudState, 0, sizeof(loudState));
+    loudWasOn = doLoud;
+    const BiquadCoeffs& loudL = lb ? lb->low[loudStep]  : kLoudFlat;
+    const BiquadCoeffs& loudH = lb ? lb->high[loudStep] : kLoudFlat;
+#endif
 
-    int bands_to_process = EQ_BANDS;
-    if (!doEQ) bands_to_process = 0;
+    // tylko aktywne pasma – wyłączone i 0 dB nie wchodzą do pętli
+    int bands_to_process = doEQ ? eqParamAudio.activeCount : 0;
+    const uint8_t*      activeBand = eqParamAudio.activeBand;
+    const BiquadCoeffs* coeffs     = eqParamAudio.coeffs;
+
+    // mid/side przed korektorem – decyzja raz na callback, stan w zmiennych lokalnych
+    bool doMS = false;
+#if ENABLE_RUNTIME_STEREO_WIDTH
+    doMS = stereo_is_active();
+    if (doMS && !msWasOn) msState = {0, 0, 0, 0};
+    msWasOn = doMS;
+    const BiquadCoeffs ms = eqParamAudio.msHpf;
+    const float msWidth = eqParamAudio.stereoWidth;
+    float msX1 = msState.x1, msX2 = msState.x2, msY1 = msState.y1, msY2 = msState.y2;
+#endif
 
     const int channels = 2;
+    int64_t tEq = esp_timer_get_time();
 
     for (int frame = 0; frame < validSamples; ++frame) {
         int idxL = frame * channels;
@@ -750,21 +1742,35 @@ void audio_process_i2s(int16_t* outBuff, int32_t validSamples, bool *continueI2S
         float yL = inL;
         float yR = inR;
 
-        if (doEQ) {
-            // Korekcja – filtrujemy L i R przez biquady
-            for (int b = 0; b < EQ_BANDS; ++b) {
-                // bypass?
-                if (b0_c[b] == 1.0f && b1_c[b] == 0.0f && b2_c[b] == 0.0f &&
-                    a1_c[b] == 0.0f && a2_c[b] == 0.0f) {
-                    continue;
-                }
+#if ENABLE_RUNTIME_STEREO_WIDTH
+        if (doMS) {
+            float m  = 0.5f * (yL + yR);
+            float sd = 0.5f * (yL - yR);
+            float sh = ms.b0 * sd + ms.b1 * msX1 + ms.b2 * msX2 - ms.a1 * msY1 - ms.a2 * msY2;
+            msX2 = msX1; msX1 = sd;
+            msY2 = msY1; msY1 = sh;
+            float sw = sh * msWidth;
+            yL = m + sw;
+            yR = m - sw;
+        }
+#endif
+
+        if (doFIR) {
+#if ENABLE_RUNTIME_EQ_FIR
+            fir_push_pop(yL, yR);
+#endif
+        } else {
+            // Korekcja – filtrujemy L i R przez biquady aktywnych pasm
+            for (int k = 0; k < bands_to_process; ++k) {
+                const int b = activeBand[k];
+                const BiquadCoeffs& c = coeffs[b];
                 // L
                 {
-                    float outv = b0_c[b] * yL
-                               + b1_c[b] * state[b][0].x1
-                               + b2_c[b] * state[b][0].x2
-                               - a1_c[b] * state[b][0].y1
-                               - a2_c[b] * state[b][0].y2;
+                    float outv = c.b0 * yL
+                               + c.b1 * state[b][0].x1
+                               + c.b2 * state[b][0].x2
+                               - c.a1 * state[b][0].y1
+                               - c.a2 * state[b][0].y2;
                     state[b][0].x2 = state[b][0].x1;
                     state[b][0].x1 = yL;
                     state[b][0].y2 = state[b][0].y1;
@@ -773,11 +1779,11 @@ void audio_process_i2s(int16_t* outBuff, int32_t validSamples, bool *continueI2S
                 }
                 // R
                 {
-                    float outv = b0_c[b] * yR
-                               + b1_c[b] * state[b][1].x1
-                               + b2_c[b] * state[b][1].x2
-                               - a1_c[b] * state[b][1].y1
-                               - a2_c[b] * state[b][1].y2;
+                    float outv = c.b0 * yR
+                               + c.b1 * state[b][1].x1
+                               + c.b2 * state[b][1].x2
+                               - c.a1 * state[b][1].y1
+                               - c.a2 * state[b][1].y2;
                     state[b][1].x2 = state[b][1].x1;
                     state[b][1].x1 = yR;
                     state[b][1].y2 = state[b][1].y1;
@@ -799,7 +1805,7 @@ void audio_process_i2s(int16_t* outBuff, int32_t validSamples, bool *continueI2S
 
         // --- Sygnał do analizatora: po EQ, PRZED volume ---
 #if ENABLE_RUNTIME_ANALYZER
-        if (eqAnalyzerEnabled) {
+        if (doAnalyzer) {
             float analyzerSignal = sqrtf(0.5f * (yL*yL + yR*yR));
             analyzerTotalSamples++;
             if (analyzerSignal >= 0.99f) {
@@ -813,21 +1819,31 @@ void audio_process_i2s(int16_t* outBuff, int32_t validSamples, bool *continueI2S
 #endif
 
         // --- TYLKO TUTAJ STOSUJEMY VOLUME ---
-// volumeValue w main.cpp jest w krokach 0..maxVolume (np. 21 lub 42)
-// skalujemy do 0..1 używając aktualnego maxVolume, żeby nie było ciszej niż w oryginale
-float volNorm = 1.0f;
-if (maxVolume > 0)
-{
-    volNorm = (float)volumeValue / (float)maxVolume;
-}
-if (volNorm < 0.0f) volNorm = 0.0f;
-if (volNorm > 1.0f) volNorm = 1.0f;
+        yL *= volNorm;
+        yR *= volNorm;
+
+        // --- Loudness: po volume, więc podbicie mieści się w zapasie po ściszeniu ---
+#if ENABLE_RUNTIME_LOUDNESS
+        if (doLoud) {
+            yL = loud_biquad(loudH, loudState[1][0], loud_biquad(loudL, loudState[0][0], yL));
+            yR = loud_biquad(loudH, loudState[1][1], loud_biquad(loudL, loudState[0][1], yR));
+            if (yL >  1.0f) yL =  1.0f;
+            if (yL < -1.0f) yL = -1.0f;
+            if (yR >  1.0f) yR =  1.0f;
+            if (yR < -1.0f) yR = -1.0f;
+        }
+#endif
+
+        outBuff[idxL] = (int16_t)lroundf(yL * 32767.0f);
+        outBuff[idxR] = (int16_t)lroundf(yR * 32767.0f);
+    }
 
-yL *= volNorm;
-yR *= volNorm;
-outBuff[idxL] = (int16_t)lroundf(yL * 32768.0f);
-        outBuff[idxR] = (int16_t)lroundf(yR * 32768.0f);
+#if ENABLE_RUNTIME_STEREO_WIDTH
+    if (doMS) {
+        msState.x1 = msX1; msState.x2 = msX2; msState.y1 = msY1; msState.y2 = msY2;
     }
+#endif
+    dsp_stat_update(dspStatEqAvgUs, dspStatEqMaxUs, (uint32_t)(esp_timer_get_time() - tEq));
 
     if (continueI2S) *continueI2S = true;
 #else
@@ -1,6 +1,7 @@
 #pragma once
 #include <stdint.h>
 #include <stdbool.h>
+#include "AudioRuntimeEQ_PEQ.h"
 
 // Liczba pasm korektora / analizatora
 static const int RUNTIME_EQ_BANDS = 16;
@@ -35,6 +36,68 @@ void eq_set_all_gains(const float in[RUNTIME_EQ_BANDS]);
 // Odczytaj aktualne wzmocnienia pasm (dB)
 void eq_get_all_gains(float out[RUNTIME_EQ_BANDS]);
 
+// Włącz/wyłącz korektor DSP (publikuje nowy blok parametrów)
+void eq_set_enabled(bool enabled);
+bool eq_get_enabled();
+
+// Włącz/wyłącz zbieranie próbek analizatora w callbacku audio
+void eq_set_analyzer_enabled(bool enabled);
+
+// Tryb liniowo-fazowy (FIR + splot partycjonowany FFT) zamiast biquadów.
+// Pierwsze włączenie alokuje bufory (~50 kB) i uruchamia zadanie projektujące filtr.
+void eq_set_linear_phase(bool enabled);
+bool eq_get_linear_phase();
+
+// Kompensacja głośności (loudness): półki 100 Hz / 8 kHz rosnące przy ściszaniu.
+// Współczynniki są liczone z góry dla każdego kroku 0..maxVolume.
+void eq_set_loudness(bool enabled);
+bool eq_get_loudness();
+
+// Szerokość stereo (mid/side): 0 = mono, 1 = bez zmian, 2 = maksymalne poszerzenie
+void  eq_set_stereo_width(float width);
+float eq_get_stereo_width();
+
+// Mono basu: kanał S filtrowany HPF od podanej częstotliwości (40-300 Hz, 0 = wyłączone)
+void  eq_set_bass_mono(float crossoverHz);
+float eq_get_bass_mono();
+
+// Koszt etapów DSP w callbacku (pomiar esp_timer na urządzeniu)
+struct EqDspStats {
+    uint32_t callbacks;
+    uint32_t frames;
+    uint32_t eqAvgUs;       // pętla mid/side + EQ + loudness + volume
+    uint32_t eqMaxUs;
+    float    loadPct;       // średnia względem czasu trwania ostatniego bloku
+};
+void eq_get_dsp_stats(EqDspStats* out);
+void eq_reset_dsp_stats();
+
+// Pomiar obciążenia trybu FIR na urządzeniu (czas przetwarzania jednego bloku)
+struct EqFirStats {
+    uint32_t blocks;          // liczba przetworzonych bloków
+    uint32_t avgUs;           // średni czas bloku [us]
+    uint32_t maxUs;           // najdłuższy blok [us]
+    float    loadPct;         // avgUs względem czasu trwania bloku przy bieżącym fs [%]
+    uint16_t blockSamples;    // rozmiar bloku (opóźnienie przetwarzania)
+    uint16_t taps;            // długość filtra
+    uint16_t latencySamples;  // opóźnienie całkowite: blok + TAPS/2
+    bool     active;          // FIR faktycznie w torze audio
+};
+void eq_fir_get_stats(EqFirStats* out);
+void eq_fir_reset_stats();
+
+// Publikuje do wątku audio bieżące eqBandGains/eqEnabled/ustawienia analizatora.
+// Wołać po bezpośredniej zmianie zmiennych globalnych (np. po wczytaniu konfiguracji).
+void eq_params_publish();
+
+// Start z setup(): zadanie eqWorker i pierwszy blok parametrów. Callback audio
+// nie liczy współczynników ani nie tworzy zadań – do pierwszej publikacji
+// przepuszcza dźwięk bez korekcji (z samą głośnością).
+void eq_runtime_init();
+
+// Numer sekwencji ostatnio opublikowanego bloku (parzysty, 0 = brak publikacji)
+uint32_t eq_params_get_seq();
+
 // Odczytaj poziomy analizatora (0..1 dla 16 pasm)
 void eq_get_analyzer_levels(float out[RUNTIME_EQ_BANDS]);
 
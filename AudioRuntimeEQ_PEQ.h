@@ -0,0 +1,47 @@
+#pragma once
+#include <Arduino.h>
+
+// Tryb parametryczny korektora runtime (AudioRuntimeEQ_Evo.cpp).
+// Osobny nagłówek, żeby main.cpp mógł wystawić API /peq bez wciągania
+// AudioRuntimeEQ_Evo.h (tam jest drugi audio_process_i2s i analizator).
+
+// Liczba pasm parametrycznych (tyle samo co pasm grafika)
+static const int EQ_PEQ_BANDS = 16;
+
+// Typ filtra pasma
+enum EqPeqType : uint8_t {
+  PEQ_OFF       = 0,   // pasmo wyłączone (zero kosztu w torze audio)
+  PEQ_PEAK      = 1,   // dzwon (freq, Q, gain)
+  PEQ_LOWSHELF  = 2,   // półka niska (freq, Q, gain)
+  PEQ_HIGHSHELF = 3,   // półka wysoka (freq, Q, gain)
+  PEQ_HIGHPASS  = 4,   // górnoprzepustowy 12 dB/okt (freq, Q)
+  PEQ_LOWPASS   = 5,   // dolnoprzepustowy 12 dB/okt (freq, Q)
+  PEQ_NOTCH     = 6,   // wycięcie (freq, Q)
+  PEQ_TYPE_COUNT
+};
+
+struct EqPeqBand {
+  uint8_t type;     // EqPeqType
+  float   freq;     // 20 .. 20000 Hz
+  float   q;        // 0.1 .. 18
+  float   gainDb;   // -18 .. +18 dB (tylko peak/półki)
+};
+
+// Przełącz grafik (16 × peak Q=1) ↔ tryb parametryczny
+void eq_peq_set_mode(bool parametric);
+bool eq_peq_get_mode();
+
+// Ustaw/odczytaj pasmo 0..15 (wartości są przycinane do zakresów).
+// Współczynniki liczy publikujący, nie wątek audio.
+bool eq_peq_set_band(int band, const EqPeqBand& b);
+bool eq_peq_get_band(int band, EqPeqBand* out);
+
+// /peq.cfg (key=value jak /analyzer.cfg)
+void eq_peq_load();
+void eq_peq_save();
+
+// Start korektora z setup() (po eq_peq_load()) – eqWorker i pierwszy blok parametrów
+void eq_runtime_init();
+
+// {"mode":1,"bands":[{"t":1,"f":1000.0,"q":1.00,"g":3.0},...]}
+String eq_peq_to_json();
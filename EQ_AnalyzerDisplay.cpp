@@ -1,10 +1,19 @@
 #include "EQ_AnalyzerDisplay.h"
 #include "EQ_FFTAnalyzer.h"
+#include "OLED_Display.h"
+#include "OLED_Trig.h"
+#include "OLED_BgCache.h"
+#include "OLED_Columns.h"
+#include "OLED_Glyphs.h"
+#include "OLED_Gray.h"
+#include "OLED_Particles.h"
 
 #include <FS.h>
 #include <U8g2lib.h>
 #include <time.h>
 #include <math.h>
+#include <string.h>
+#include "esp_heap_caps.h"
 
 #ifndef PI
 #define PI 3.14159265358979323846
@@ -12,11 +21,6 @@
 
 // Function to get storage from main.cpp
 extern fs::FS& getStorage();
-extern String stationName;
-extern String stationNameStream;
-extern String stationStringWeb;
-extern uint8_t volumeValue;
-extern bool volumeMute;
 extern U8G2_SSD1322_NHD_256X64_F_4W_HW_SPI u8g2;
 
 // EQ variables - defined locally since they are simple arrays
@@ -58,6 +62,10 @@ uint32_t eq_analyzer_get_sample_count() {
 static const char* kCfgPath = "/analyzer.cfg";
 static AnalyzerStyleCfg g_cfg;
 
+static const uint8_t  ANALYZER_FPS_MIN       = 5;
+static const uint8_t  ANALYZER_FPS_MAX       = 60;
+static const uint32_t ANALYZER_KEEPALIVE_MS  = 250;   // zegar/animacje rysuj choćby tak często
+
 static uint8_t clampU8(int v, int lo, int hi) {
   if (v < lo) v = lo;
   if (v > hi) v = hi;
@@ -71,14 +79,216 @@ static float clampF(float v, float lo, float hi) {
 
 AnalyzerStyleCfg analyzerGetStyle() { return g_cfg; }
 
+// ─────────────────────────────────────
+// Płótno stylów 5-9
+// ─────────────────────────────────────
+// Domyślnie globalne u8g2 (style rysuje loop()). Z zadaniem renderującym
+// OLED_Display podaje tu własne płótno i style rysuje zadanie na Core1.
+// Stacja/głośność/mute idą przez oledGetState(), nie z Stringów loop().
+static U8G2* s_gfx = &u8g2;
+
+void analyzerSetRenderTarget(U8G2* gfx)
+{
+  s_gfx = gfx ? gfx : &u8g2;
+}
+
+// Skala szarości: styl rysuje płótno 1bpp, analyzerGrayBase() przepisuje je
+// do ramki 4bpp, a dopiero potem idą elementy szare. Style bez elementów
+// szarych (komunikaty "NO AUDIO" itd.) przepisuje analyzerRenderStyle().
+static bool s_gray     = false;   // klatka idzie w 4bpp (ustawia zadanie)
+static bool s_grayBase = false;   // płótno już przepisane w tej klatce
+static bool s_preview  = false;   // klatka podglądu – bez zmiany stanu stylów
+
+// Konfiguracja, z której rysują style: g_cfg, a w klatce podglądu kopia
+// niezapisanych pól formularza /analyzer (g_cfg zostaje bez zmian).
+static AnalyzerStyleCfg        s_previewCfg;
+static const AnalyzerStyleCfg* s_drawCfg = &g_cfg;
+static void analyzerClampStyle(AnalyzerStyleCfg& c);
+
+bool analyzerGrayWanted(uint8_t mode)
+{
+  if (!g_cfg.grayscale) return false;
+  return mode == 5 || mode == 6 || (mode == 8 && g_cfg.s8_gradient);
+}
+
+void analyzerSetGray(bool on)
+{
+  s_gray = on;
+}
+
+static void analyzerGrayBase(U8G2& u8g2)
+{
+  if (!s_gray || s_grayBase) return;
+  oledGrayFrom1bpp(u8g2.getBufferPtr(), OLED_GRAY_MAX, u8g2.getU8g2()->cb == U8G2_R2);
+  s_grayBase = true;
+}
+
+bool analyzerRenderStyle(uint8_t mode)
+{
+  s_grayBase = false;
+  switch (mode)
+  {
+    case 5: vuMeterMode5(); break;
+    case 6: vuMeterMode6(); break;
+    case 7: vuMeterMode7(); break;
+    case 8: vuMeterMode8(); break;
+    case 9: vuMeterMode9(); break;
+    case 10: vuMeterMode10(); break;
+    case 11: vuMeterMode11(); break;
+    case 12: vuMeterMode12(); break;
+    default: return false;
+  }
+  analyzerGrayBase(*s_gfx);
+  return true;
+}
+
+// Podgląd dla edytora WWW: ten sam kod stylu, ale klatka tylko czyta stan –
+// obwiednie, waterfall, gwiazdki, statystyki i flagi analizatora zostają
+// takie, jakie ma ekran. Zawsze 1bpp. cfg != nullptr – rysuj z tej
+// konfiguracji (po przycięciu jak w analyzerSetStyle()) zamiast z g_cfg.
+bool analyzerRenderPreview(uint8_t mode, const AnalyzerStyleCfg* cfg)
+{
+  if (cfg)
+  {
+    s_previewCfg = *cfg;
+    analyzerClampStyle(s_previewCfg);
+    s_drawCfg = &s_previewCfg;
+  }
+  const bool gray = s_gray;
+  s_gray    = false;
+  s_preview = true;
+  const bool ok = analyzerRenderStyle(mode);
+  s_preview = false;
+  s_gray    = gray;
+  s_drawCfg = &g_cfg;
+  return ok;
+}
+
+// ─────────────────────────────────────
+// Governor klatek stylów 5-9
+// ─────────────────────────────────────
+struct AnalyzerFpsStats {
+  uint32_t rendered;        // narysowane klatki
+  uint32_t skippedSame;     // pominięte: brak nowych danych analizatora
+  uint32_t skippedRate;     // pominięte: limit FPS
+  uint16_t fpsX10;          // osiągnięte FPS z ostatniej sekundy ×10
+  uint8_t  targetFps;       // bieżący limit (po adaptacji)
+  uint8_t  audioFill;       // ostatni odczyt bufora audio [%]
+};
+
+static AnalyzerFpsStats s_fps = {};
+static OledFrameState   s_fpsLastSt = {};
+static uint32_t s_fpsLastSeq   = 0;
+static uint32_t s_fpsLastMs    = 0;
+static uint32_t s_fpsWinStart  = 0;
+static uint16_t s_fpsWinFrames = 0;
+static bool     s_fpsFirst     = true;
+
+static uint8_t analyzerStyleMaxFps(uint8_t mode)
+{
+  switch (mode)
+  {
+    case 5:  return g_cfg.s5_maxFps;
+    case 6:  return g_cfg.s6_maxFps;
+    case 7:  return g_cfg.s7_maxFps;
+    case 8:  return g_cfg.s8_maxFps;
+    case 9:  return g_cfg.s9_maxFps;
+    case 10: return g_cfg.s10_maxFps;
+    case 11: return g_cfg.s11_maxFps;
+    case 12: return g_cfg.s12_maxFps;
+    default: return ANALYZER_FPS_MAX;
+  }
+}
+
+bool analyzerFrameDue(const OledFrameState& st)
+{
+  uint32_t now = millis();
+
+  // osiągnięte FPS liczone w oknach 1 s
+  if (now - s_fpsWinStart >= 1000)
+  {
+    uint32_t span = now - s_fpsWinStart;
+    s_fps.fpsX10 = (s_fpsWinStart == 0) ? 0 : (uint16_t)((uint32_t)s_fpsWinFrames * 10000UL / span);
+    s_fpsWinStart  = now;
+    s_fpsWinFrames = 0;
+  }
+
+  // limit FPS; przy pustoszejącym buforze audio oddajemy CPU dekoderowi
+  uint8_t fps = analyzerStyleMaxFps(st.displayMode);
+  if (g_cfg.fpsAdaptive)
+  {
+    if (st.audioFill < 20)      fps /= 4;
+    else if (st.audioFill < 40) fps /= 2;
+    if (fps < ANALYZER_FPS_MIN) fps = ANALYZER_FPS_MIN;
+  }
+  s_fps.targetFps = fps;
+  s_fps.audioFill = st.audioFill;
+
+  uint32_t since = now - s_fpsLastMs;
+  if (!s_fpsFirst && since < 1000UL / fps)
+  {
+    s_fps.skippedRate++;
+    return false;
+  }
+
+  // nowe dane analizatora (pasma albo migawka przebiegu stylu 11/12)
+  // albo zmiana tego, co widać na pasku u góry
+  uint32_t seq = eq_analyzer_get_publish_seq() + eq_scope_get_seq();
+  bool stateChanged = (st.displayMode != s_fpsLastSt.displayMode) ||
+                      (st.mute != s_fpsLastSt.mute) ||
+                      (st.volume != s_fpsLastSt.volume) ||
+                      (strcmp(st.station, s_fpsLastSt.station) != 0);
+  if (!s_fpsFirst && !stateChanged && seq == s_fpsLastSeq && since < ANALYZER_KEEPALIVE_MS)
+  {
+    s_fps.skippedSame++;
+    return false;
+  }
+
+  s_fpsFirst   = false;
+  s_fpsLastSeq = seq;
+  s_fpsLastSt  = st;
+  s_fpsLastMs  = now;
+  s_fpsWinFrames++;
+  s_fps.rendered++;
+  return true;
+}
+
+void analyzerFpsResetStats()
+{
+  memset(&s_fps, 0, sizeof(s_fps));
+  s_fpsWinStart  = 0;
+  s_fpsWinFrames = 0;
+}
+
+String analyzerFpsToJson()
+{
+  AnalyzerFpsStats s = s_fps;
+  String json;
+  json.reserve(260);
+  json += "{";
+  json += "\"mode\":"        + String(s_fpsLastSt.displayMode) + ",";
+  json += "\"fps\":"         + String(s.fpsX10 / 10.0f, 1) + ",";
+  json += "\"targetFps\":"   + String(s.targetFps) + ",";
+  json += "\"adaptive\":"    + String(g_cfg.fpsAdaptive ? 1 : 0) + ",";
+  json += "\"audioFill\":"   + String(s.audioFill) + ",";
+  json += "\"rendered\":"    + String(s.rendered) + ",";
+  json += "\"skippedSame\":" + String(s.skippedSame) + ",";
+  json += "\"skippedRate\":" + String(s.skippedRate) + ",";
+  json += "\"maxFps\":["     + String(g_cfg.s5_maxFps) + "," + String(g_cfg.s6_maxFps) + "," +
+                                String(g_cfg.s7_maxFps) + "," + String(g_cfg.s8_maxFps) + "," +
+                                String(g_cfg.s9_maxFps) + "," + String(g_cfg.s10_maxFps) + "," +
+                                String(g_cfg.s11_maxFps) + "," + String(g_cfg.s12_maxFps) + "]";
+  json += "}";
+  return json;
+}
+
 uint32_t analyzerGetPeakHoldTime() {
   return g_cfg.peakHoldTimeMs;
 }
 
-void analyzerSetStyle(const AnalyzerStyleCfg& in)
+// Przytnij pola do zakresów obsługiwanych przez style
+static void analyzerClampStyle(AnalyzerStyleCfg& c)
 {
-  AnalyzerStyleCfg c = in;
-
   // Globalne ustawienia
   c.peakHoldTimeMs = (c.peakHoldTimeMs < 50) ? 50 : (c.peakHoldTimeMs > 2000) ? 2000 : c.peakHoldTimeMs;
 
@@ -115,6 +325,24 @@ void analyzerSetStyle(const AnalyzerStyleCfg& in)
   c.s9_centerSize = clampU8(c.s9_centerSize, 2, 8);
   c.s9_smoothness = clampU8(c.s9_smoothness, 10, 90);
 
+  // Styl 11/12
+  c.s11_timebase = clampU8(c.s11_timebase, 1, 32);
+
+  // Odświeżanie
+  c.s5_maxFps = clampU8(c.s5_maxFps, ANALYZER_FPS_MIN, ANALYZER_FPS_MAX);
+  c.s6_maxFps = clampU8(c.s6_maxFps, ANALYZER_FPS_MIN, ANALYZER_FPS_MAX);
+  c.s7_maxFps = clampU8(c.s7_maxFps, ANALYZER_FPS_MIN, ANALYZER_FPS_MAX);
+  c.s8_maxFps = clampU8(c.s8_maxFps, ANALYZER_FPS_MIN, ANALYZER_FPS_MAX);
+  c.s9_maxFps = clampU8(c.s9_maxFps, ANALYZER_FPS_MIN, ANALYZER_FPS_MAX);
+  c.s10_maxFps = clampU8(c.s10_maxFps, ANALYZER_FPS_MIN, ANALYZER_FPS_MAX);
+  c.s11_maxFps = clampU8(c.s11_maxFps, ANALYZER_FPS_MIN, ANALYZER_FPS_MAX);
+  c.s12_maxFps = clampU8(c.s12_maxFps, ANALYZER_FPS_MIN, ANALYZER_FPS_MAX);
+}
+
+void analyzerSetStyle(const AnalyzerStyleCfg& in)
+{
+  AnalyzerStyleCfg c = in;
+  analyzerClampStyle(c);
   g_cfg = c;
 
   // Mapuj konfigurację na nasze zmienne globalne
@@ -156,6 +384,7 @@ void analyzerStyleLoad()
 
     // Globalne ustawienia
     if (k == "peakHoldMs")  c.peakHoldTimeMs = (uint16_t)v.toInt();
+    if (k == "gray")        c.grayscale = v.toInt() != 0;
     
     // Styl 5
     if (k == "s5w")         c.s5_barWidth = (uint8_t)v.toInt();
@@ -194,6 +423,20 @@ void analyzerStyleLoad()
     else if (k == "s9filled") c.s9_filled = v.toInt() != 0;
     else if (k == "s9center") c.s9_centerSize = (uint8_t)v.toInt();
     else if (k == "s9smooth") c.s9_smoothness = (uint8_t)v.toInt();
+
+    // Styl 11/12
+    else if (k == "s11tb")    c.s11_timebase = (uint8_t)v.toInt();
+
+    // Odświeżanie
+    else if (k == "s5fps")    c.s5_maxFps = (uint8_t)v.toInt();
+    else if (k == "s6fps")    c.s6_maxFps = (uint8_t)v.toInt();
+    else if (k == "s7fps")    c.s7_maxFps = (uint8_t)v.toInt();
+    else if (k == "s8fps")    c.s8_maxFps = (uint8_t)v.toInt();
+    else if (k == "s9fps")    c.s9_maxFps = (uint8_t)v.toInt();
+    else if (k == "s10fps")   c.s10_maxFps = (uint8_t)v.toInt();
+    else if (k == "s11fps")   c.s11_maxFps = (uint8_t)v.toInt();
+    else if (k == "s12fps")   c.s12_maxFps = (uint8_t)v.toInt();
+    else if (k == "fpsAdapt") c.fpsAdaptive = v.toInt() != 0;
   }
   f.close();
 
@@ -208,6 +451,7 @@ void analyzerStyleSave()
   f.println("# Analyzer style cfg");
   f.println("# Global settings");
   f.printf("peakHoldMs=%u\n", g_cfg.peakHoldTimeMs);
+  f.printf("gray=%u\n", g_cfg.grayscale ? 1 : 0);
   f.println("# Style5");
   f.printf("s5w=%u\n", g_cfg.s5_barWidth);
   f.printf("s5g=%u\n", g_cfg.s5_barGap);
@@ -245,6 +489,19 @@ void analyzerStyleSave()
   f.printf("s9filled=%u\n", g_cfg.s9_filled ? 1 : 0);
   f.printf("s9center=%u\n", g_cfg.s9_centerSize);
   f.printf("s9smooth=%u\n", g_cfg.s9_smoothness);
+
+  f.println("# Style11/12");
+  f.printf("s11tb=%u\n", g_cfg.s11_timebase);
+  f.println("# Refresh");
+  f.printf("s5fps=%u\n", g_cfg.s5_maxFps);
+  f.printf("s6fps=%u\n", g_cfg.s6_maxFps);
+  f.printf("s7fps=%u\n", g_cfg.s7_maxFps);
+  f.printf("s8fps=%u\n", g_cfg.s8_maxFps);
+  f.printf("s9fps=%u\n", g_cfg.s9_maxFps);
+  f.printf("s10fps=%u\n", g_cfg.s10_maxFps);
+  f.printf("s11fps=%u\n", g_cfg.s11_maxFps);
+  f.printf("s12fps=%u\n", g_cfg.s12_maxFps);
+  f.printf("fpsAdapt=%u\n", g_cfg.fpsAdaptive ? 1 : 0);
   
   f.close();
 }
@@ -256,6 +513,7 @@ String analyzerStyleToJson()
   s += "{";
   // Globalne ustawienia
   s += "\"peakHoldTimeMs\":" + String(g_cfg.peakHoldTimeMs) + ",";
+  s += "\"grayscale\":" + String(g_cfg.grayscale ? "true" : "false") + ",";
   // Styl 5
   s += "\"s5_barWidth\":" + String(g_cfg.s5_barWidth) + ",";
   s += "\"s5_barGap\":"   + String(g_cfg.s5_barGap) + ",";
@@ -291,7 +549,19 @@ String analyzerStyleToJson()
   s += "\"s9_showSpikes\":" + String(g_cfg.s9_showSpikes ? "true" : "false") + ",";
   s += "\"s9_filled\":" + String(g_cfg.s9_filled ? "true" : "false") + ",";
   s += "\"s9_centerSize\":" + String(g_cfg.s9_centerSize) + ",";
-  s += "\"s9_smoothness\":" + String(g_cfg.s9_smoothness);
+  s += "\"s9_smoothness\":" + String(g_cfg.s9_smoothness) + ",";
+  // Styl 11/12
+  s += "\"s11_timebase\":" + String(g_cfg.s11_timebase) + ",";
+  // Odświeżanie
+  s += "\"s5_maxFps\":" + String(g_cfg.s5_maxFps) + ",";
+  s += "\"s6_maxFps\":" + String(g_cfg.s6_maxFps) + ",";
+  s += "\"s7_maxFps\":" + String(g_cfg.s7_maxFps) + ",";
+  s += "\"s8_maxFps\":" + String(g_cfg.s8_maxFps) + ",";
+  s += "\"s9_maxFps\":" + String(g_cfg.s9_maxFps) + ",";
+  s += "\"s10_maxFps\":" + String(g_cfg.s10_maxFps) + ",";
+  s += "\"s11_maxFps\":" + String(g_cfg.s11_maxFps) + ",";
+  s += "\"s12_maxFps\":" + String(g_cfg.s12_maxFps) + ",";
+  s += "\"fpsAdaptive\":" + String(g_cfg.fpsAdaptive ? "true" : "false");
   s += "}";
   return s;
 }
@@ -380,14 +650,56 @@ String analyzerBuildHtmlPage()
   s += "<div class='row'><label>smoothness</label><input name='s9smooth' type='number' min='10' max='90' value='" + String(g_cfg.s9_smoothness) + "'></div>";
   s += "</div>";
 
+  s += "<div class='box'><h3>Styl 11/12 (Oscyloskop, Lissajous X/Y)</h3>";
+  s += "<div class='row'><label>frames per column</label><input name='s11tb' type='number' min='1' max='32' value='" + String(g_cfg.s11_timebase) + "'></div>";
+  s += "</div>";
+
+  s += "<div class='box'><h3>Odświeżanie (max FPS)</h3>";
+  s += "<div class='row'><label>styl 5</label><input name='s5fps' type='number' min='5' max='60' value='" + String(g_cfg.s5_maxFps) + "'></div>";
+  s += "<div class='row'><label>styl 6</label><input name='s6fps' type='number' min='5' max='60' value='" + String(g_cfg.s6_maxFps) + "'></div>";
+  s += "<div class='row'><label>styl 7</label><input name='s7fps' type='number' min='5' max='60' value='" + String(g_cfg.s7_maxFps) + "'></div>";
+  s += "<div class='row'><label>styl 8</label><input name='s8fps' type='number' min='5' max='60' value='" + String(g_cfg.s8_maxFps) + "'></div>";
+  s += "<div class='row'><label>styl 9</label><input name='s9fps' type='number' min='5' max='60' value='" + String(g_cfg.s9_maxFps) + "'></div>";
+  s += "<div class='row'><label>styl 10 (waterfall)</label><input name='s10fps' type='number' min='5' max='60' value='" + String(g_cfg.s10_maxFps) + "'></div>";
+  s += "<div class='row'><label>styl 11 (oscyloskop)</label><input name='s11fps' type='number' min='5' max='60' value='" + String(g_cfg.s11_maxFps) + "'></div>";
+  s += "<div class='row'><label>styl 12 (Lissajous)</label><input name='s12fps' type='number' min='5' max='60' value='" + String(g_cfg.s12_maxFps) + "'></div>";
+  s += "<div class='row'><label>adaptive (bufor audio)</label><input name='fpsAdapt' type='checkbox' value='1' " + String(g_cfg.fpsAdaptive ? "checked" : "") + "></div>";
+  // ukryte gray=0 po checkboxie: odznaczony wysyła 0, zaznaczony najpierw 1 (handler bierze pierwszy)
+  s += "<div class='row'><label>16 odcieni (style 5, 6, 8)</label><input name='gray' type='checkbox' value='1' " + String(g_cfg.grayscale ? "checked" : "") + "><input name='gray' type='hidden' value='0'></div>";
+  s += "</div>";
+
   s += "<div class='row'>";
   s += "<button formaction='/analyzerApply' type='submit'>Podgląd LIVE</button>";
   s += "<button class='secondary' formaction='/analyzerSave' type='submit'>Zapisz</button>";
   s += "<a href='/analyzerCfg' style='margin-left:12px'>JSON</a>";
   s += "<a href='/analyzerDiag' style='margin-left:12px'>Diagnostyka</a>";
+  s += "<a href='/analyzerFps' style='margin-left:12px'>FPS</a>";
   s += "<a href='/analyzerTest' style='margin-left:12px'>Test Generator</a>";
   s += "</div>";
 
+  // Podgląd stylu bez zmiany ekranu: JS wysyła POST z polami formularza (niezapisane
+  // ustawienia), /analyzerPreview oddaje ostatni PBM (X-Preview-Seq) albo 202 –
+  // JS ponawia co 150 ms, aż dostanie nowy numer podglądu
+  s += "<div class='box'><h3>Podgląd stylu (bez zmiany ekranu)</h3>";
+  s += "<div class='row'><label>styl</label><select id='pvMode'>";
+  for (uint8_t m = 5; m <= 12; m++) s += "<option>" + String(m) + "</option>";
+  s += "</select><label style='margin-left:12px'><input id='pvAuto' type='checkbox'> auto</label>";
+  s += "<button type='button' onclick='pv()'>Odśwież</button></div>";
+  s += "<canvas id='pv' width='256' height='64' style='width:512px;height:128px;background:#000;image-rendering:pixelated'></canvas>";
+  s += "<script>let pvSeq=null,pvBusy=false;"
+       "function pvDraw(b){const d=new Uint8Array(b,10),c=document.getElementById('pv').getContext('2d'),im=c.createImageData(256,64);"
+       "for(let i=0;i<256*64;i++){const on=d[i>>3]&(0x80>>(i&7));im.data[i*4]=on?255:0;im.data[i*4+1]=on?200:0;im.data[i*4+2]=0;im.data[i*4+3]=255;}"
+       "c.putImageData(im,0,0);}"
+       "function pv(n){n=n||0;if(!n){if(pvBusy)return;pvBusy=true;}"
+       "const again=()=>{if(n<6)setTimeout(()=>pv(n+1),150);else pvBusy=false;};"
+       "fetch('/analyzerPreview?mode='+pvMode.value,{method:'POST',body:new URLSearchParams(new FormData(pvMode.form))}).then(r=>{"
+       "if(r.status!=200){if(r.status==202)again();else pvBusy=false;return;}"
+       "const s=r.headers.get('X-Preview-Seq'),fresh=s!==pvSeq;pvSeq=s;"
+       "return r.arrayBuffer().then(b=>{pvDraw(b);if(fresh)pvBusy=false;else again();});"
+       "}).catch(()=>{pvBusy=false;});}"
+       "setInterval(()=>{if(pvAuto.checked)pv();},500);</script>";
+  s += "</div>";
+
   s += "<div class='box'><h3>Diagnostyka Audio</h3>";
   s += "<p><strong>Problemy z formatami FLAC/AAC?</strong></p>";
   s += "<ul>";
@@ -420,160 +732,102 @@ void eqAnalyzerSetFromWeb(bool enabled)
 }
 
 // ─────────────────────────────────────
-// STYL 5 – 16 słupków, zegar + ikonka głośnika
+// Pasek górny stylów 5 i 6 – widżety tła
 // ─────────────────────────────────────
-
-void vuMeterMode5() // Tryb 5: 16 słupków – dynamiczny analizator z zegarem i ikonką głośnika
+// Zegar, stacja, głośnik i linia to widżety warstwy tła (patrz układ
+// stylów niżej). Pasek zmienia się najwyżej raz na sekundę (mrugający
+// dwukropek), więc rysujemy go tylko przy zmianie kluczy widżetów, a w
+// pozostałych klatkach kopiujemy gotowy bufor (OLED_BgCache).
+
+static const uint8_t ANALYZER_ICON_X = 256 - 40;   // ikonka głośnika; SCREEN_WIDTH = 256
+
+// Wejścia klatki wspólne dla widżetów
+struct AnalyzerFrameCtx {
+  uint8_t        mode;
+  OledFrameState st;
+  char           timeString[9];
+  float          raw[EQ_BANDS];   // poziomy z FFT przycięte do 0..1 (przed animacją mute)
+  uint8_t        stationX;        // ustawia zegar: początek nazwy stacji
+  uint16_t       dtMs;            // czas od poprzedniej klatki (obwiednie, krok animacji)
+  bool           preview;         // klatka podglądu WWW – widżet nie zmienia swojego stanu
+};
+
+// "12:34" / "12 34" (mrugający dwukropek); pusty gdy czas nieznany
+static void analyzerClockString(char* out, size_t len)
 {
-  // Powiedz analizatorowi, że jest aktywny
-  eq_analyzer_set_runtime_active(true);
-  
-  // Jeśli analizator jest wyłączony – pokaż prosty komunikat
-  if (!eqAnalyzerEnabled)
-  {
-    u8g2.clearBuffer();
-    u8g2.setFont(u8g2_font_6x12_tf);
-    u8g2.setCursor(10, 24);
-    u8g2.print("ANALYZER OFF");
-    u8g2.setCursor(10, 40);
-    u8g2.print("Enable in Web UI");
-    u8g2.sendBuffer();
-    return;
-  }
+  struct tm timeinfo;
+  out[0] = '\0';
+  if (!getLocalTime(&timeinfo, 5)) return;
+  if (timeinfo.tm_sec % 2 == 0)
+    snprintf(out, len, "%2d:%02d", timeinfo.tm_hour, timeinfo.tm_min);
+  else
+    snprintf(out, len, "%2d %02d", timeinfo.tm_hour, timeinfo.tm_min);
+}
 
-  // Sprawdź czy próbki napływają
-  static uint32_t noSamplesTime5 = 0;
-  if (!eq_analyzer_is_receiving_samples())
-  {
-    if (noSamplesTime5 == 0) noSamplesTime5 = millis();
-    
-    u8g2.clearBuffer();
-    u8g2.setFont(u8g2_font_6x12_tf);
-    u8g2.setCursor(10, 16);
-    u8g2.print("NO AUDIO SAMPLES");
-    u8g2.setCursor(10, 32);
-    u8g2.print("Count: ");
-    u8g2.print(eq_analyzer_get_sample_count());
-    
-    // Po 3 sekundach włącz generator testowy
-    if (millis() - noSamplesTime5 > 3000) {
-      u8g2.setCursor(10, 48);
-      u8g2.print("Enabling test mode...");
-      eq_analyzer_enable_test_generator(true);
-      noSamplesTime5 = millis(); // Reset timer
-    } else {
-      u8g2.setCursor(10, 48);
-      u8g2.print("Check audio source");
-    }
-    u8g2.sendBuffer();
-    return;
-  } else {
-    noSamplesTime5 = 0; // Reset when receiving samples
-    eq_analyzer_enable_test_generator(false); // Wyłącz generator gdy mamy audio
-  }
+static uint32_t analyzerKeyClock(uint32_t h, const AnalyzerFrameCtx& c)
+{
+  return oledBgHash(h, c.timeString, strlen(c.timeString) + 1);
+}
 
-  // 1. Pobranie poziomów z analizatora FFT (0..1)
-  float levels[EQ_BANDS];
-  float peaks[EQ_BANDS];
-  eq_get_analyzer_levels(levels);
-  eq_get_analyzer_peaks(peaks);
+static void analyzerWidgetClock(U8G2& u8g2, AnalyzerFrameCtx& c)
+{
+  c.stationX = 0;
+  if (!c.timeString[0]) return;
+  u8g2.setFont(u8g2_font_6x12_tf);
+  u8g2.setCursor(4, 11);
+  u8g2.print(c.timeString);
+  c.stationX = 4 + u8g2.getStrWidth(c.timeString) + 6;   // nazwa stacji obok zegara
+}
 
-  // Debug co 2 sekundy - sprawdź wartości poziomów
-  static uint32_t lastDebugDisplay = 0;
-  uint32_t now = millis();
-  if (now - lastDebugDisplay > 2000) {
-    Serial.print("Display levels: ");
-    for (int i = 0; i < EQ_BANDS; i++) {
-      Serial.print(levels[i], 2);
-      if (i < EQ_BANDS - 1) Serial.print(" ");
-    }
-    Serial.println();
-    lastDebugDisplay = now;
-  }
+static uint32_t analyzerKeyStation(uint32_t h, const AnalyzerFrameCtx& c)
+{
+  return oledBgHash(h, c.st.station, strlen(c.st.station) + 1);
+}
 
-  // Przepisujemy do eqLevel/eqPeak w skali 0..100 dla rysowania słupków
-  // Jeśli mute - animacja opadania słupków
-  static uint8_t muteLevel[EQ_BANDS] = {0}; // Zapamietane poziomy dla animacji mute
-  
-  for (uint8_t i = 0; i < EQ_BANDS; i++)
+// Stacja tylko obok zegara, przycięta do miejsca przed ikonką głośnika.
+// Przycięty tekst zostaje do zmiany nazwy albo pozycji.
+static void analyzerWidgetStation(U8G2& u8g2, AnalyzerFrameCtx& c)
+{
+  static char     nameToShow[sizeof(c.st.station)];
+  static uint32_t fitKey   = 0;
+  static bool     fitValid = false;
+
+  if (c.stationX == 0) return;
+  const uint8_t xStation = c.stationX;
+  if (ANALYZER_ICON_X <= xStation + 4) return;
+  const uint8_t maxStationWidth = ANALYZER_ICON_X - xStation - 4;
+  const char* name = c.st.station[0] ? c.st.station : "Radio";
+
+  u8g2.setFont(u8g2_font_6x12_tf);
+  uint32_t key = oledBgHash(OLED_BG_HASH_INIT, name, strlen(name) + 1);
+  key = oledBgHash(key, &maxStationWidth, sizeof(maxStationWidth));
+  if (!fitValid || key != fitKey)
   {
-    if (volumeMute) {
-      // Podczas mute - stopniowo opuszczaj słupki (animacja)
-      if (muteLevel[i] > 2) {
-        muteLevel[i] -= 2; // Opadanie o 2% na klatkę
-      } else {
-        muteLevel[i] = 0;
-      }
-      eqLevel[i] = muteLevel[i];
-      eqPeak[i] = 0; // Peak natychmiast znika
-    } else {
-      float lv = levels[i];
-      float pk = peaks[i];
-      if (lv < 0.0f) lv = 0.0f;
-      if (lv > 1.0f) lv = 1.0f;
-      if (pk < 0.0f) pk = 0.0f;
-      if (pk > 1.0f) pk = 1.0f;
-
-      uint8_t newLevel = (uint8_t)(lv * 100.0f + 0.5f);
-      eqLevel[i] = newLevel;
-      eqPeak[i] = (uint8_t)(pk * 100.0f + 0.5f);
-      muteLevel[i] = newLevel; // Zapamietaj poziom dla animacji mute
-    }
+    // Przycinanie tekstu do wolnej szerokości – jeden przebieg po tablicy glifów
+    OledTextMetrics m;
+    oledTextMeasure(u8g2, nullptr, name, maxStationWidth, m);
+    size_t len = (m.fitLen < sizeof(nameToShow)) ? m.fitLen : sizeof(nameToShow) - 1;
+    memcpy(nameToShow, name, len);
+    nameToShow[len] = '\0';
+    fitKey   = key;
+    fitValid = true;
   }
 
-  // 2. Rysowanie – zegar + ikonka głośnika u góry, słupki pod spodem
-  u8g2.setDrawColor(1);
-  u8g2.clearBuffer();
-
-  // Pasek górny: zegar po lewej, stacja obok, ikonka głośnika po prawej
-  struct tm timeinfo;
-  if (getLocalTime(&timeinfo, 5))
-  {
-    char timeString[9];
-    if (timeinfo.tm_sec % 2 == 0)
-      snprintf(timeString, sizeof(timeString), "%2d:%02d", timeinfo.tm_hour, timeinfo.tm_min);
-    else
-      snprintf(timeString, sizeof(timeString), "%2d %02d", timeinfo.tm_hour, timeinfo.tm_min);
-
-    u8g2.setFont(u8g2_font_6x12_tf);
-    u8g2.setCursor(4, 11);
-    u8g2.print(timeString);
-
-    // Nazwa stacji obok zegara
-    uint8_t timeWidth = u8g2.getStrWidth(timeString);
-    uint8_t xStation  = 4 + timeWidth + 6;
-
-    // Zarezerwuj miejsce do ikony głośnika po prawej
-    uint8_t iconX = 256 - 40;  // SCREEN_WIDTH = 256
-    uint8_t maxStationWidth = 0;
-    if (iconX > xStation + 4)
-      maxStationWidth = iconX - xStation - 4;
-
-    if (maxStationWidth > 0)
-    {
-      String nameToShow = stationName;
-      if (nameToShow.length() == 0)
-      {
-        if (stationNameStream.length() > 0)      nameToShow = stationNameStream;
-        else if (stationStringWeb.length() > 0)  nameToShow = stationStringWeb;
-        else                                     nameToShow = "Radio";
-      }
-
-      // Przycinanie tekstu do wolnej szerokości
-      while (nameToShow.length() > 0 &&
-             u8g2.getStrWidth(nameToShow.c_str()) > maxStationWidth)
-      {
-        nameToShow.remove(nameToShow.length() - 1);
-      }
+  u8g2.setCursor(xStation, 11);
+  u8g2.print(nameToShow);
+}
 
-      u8g2.setCursor(xStation, 11);
-      u8g2.print(nameToShow);
-    }
-  }
+static uint32_t analyzerKeyVolume(uint32_t h, const AnalyzerFrameCtx& c)
+{
+  h = oledBgHash(h, &c.st.volume, sizeof(c.st.volume));
+  return oledBgHash(h, &c.st.mute, sizeof(c.st.mute));
+}
 
-  // Ikonka głośnika + wartość głośności po prawej
+// Ikonka głośnika + wartość głośności po prawej
+static void analyzerWidgetVolume(U8G2& u8g2, AnalyzerFrameCtx& c)
+{
   uint8_t iconY = 2;
-  uint8_t iconX = 256 - 40;  // SCREEN_WIDTH = 256
+  uint8_t iconX = ANALYZER_ICON_X;
 
   // „kolumna" głośnika
   u8g2.drawBox(iconX, iconY + 2, 4, 7);
@@ -582,7 +836,7 @@ void vuMeterMode5() // Tryb 5: 16 słupków – dynamiczny analizator z zegarem
   u8g2.drawLine(iconX + 4, iconY + 8, iconX + 7, iconY + 10); // skośny dół
   u8g2.drawLine(iconX + 7, iconY,     iconX + 7, iconY + 10); // pion
 
-  if (volumeMute) {
+  if (c.st.mute) {
     // Przekreślenie dla mute - X nad ikonką
     u8g2.drawLine(iconX - 1, iconY, iconX + 11, iconY + 12);     // skos \
     u8g2.drawLine(iconX - 1, iconY + 12, iconX + 11, iconY);     // skos /
@@ -596,55 +850,172 @@ void vuMeterMode5() // Tryb 5: 16 słupków – dynamiczny analizator z zegarem
   // Wartość głośności lub napis MUTED
   u8g2.setFont(u8g2_font_5x8_mr);
   u8g2.setCursor(iconX + 14, 10);
-  if (volumeMute) {
+  if (c.st.mute) {
     u8g2.print("MUTED");
   } else {
-    u8g2.print(volumeValue);
+    u8g2.print(c.st.volume);
   }
+}
 
-  // Linia oddzielająca pasek od słupków
+static uint32_t analyzerKeyRule(uint32_t h, const AnalyzerFrameCtx&)
+{
+  return h;   // stała
+}
+
+// Linia oddzielająca pasek od słupków
+static void analyzerWidgetRule(U8G2& u8g2, AnalyzerFrameCtx&)
+{
   u8g2.drawHLine(0, 13, 256);  // SCREEN_WIDTH = 256
+}
+
+// ─────────────────────────────────────
+// Słupki segmentowe stylów 5 i 6
+// ─────────────────────────────────────
+// Słupek to do 48 segmentów + kreska peaku, czyli do kilkuset drawBox()
+// na klatkę. Zamiast tego maska wierszy całego słupka bierze się z tablicy
+// (level[segmenty] | peak[segment peaku]) i idzie wprost do bufora
+// (OLED_Columns). Tablice liczone są tą samą geometrią co dawne drawBox(),
+// tylko przy zmianie układu, więc obraz jest identyczny co do piksela.
+
+static const uint8_t ANALYZER_BAR_TOP_Y   = 14;        // pod paskiem górnym
+static const uint8_t ANALYZER_BAR_BOTTOM_Y = 64 - 1;   // SCREEN_HEIGHT = 64
+static const uint8_t ANALYZER_BAR_MAX_SEG = 48;
+static const uint8_t ANALYZER_BAR_SEG_GAP = 1;         // 1 piksel przerwy między segmentami
+
+struct AnalyzerSegBars {
+  int16_t startX;
+  uint8_t barWidth;
+  uint8_t barGap;
+  uint8_t maxSegments;
+  uint8_t segHeight;
+  bool    keepClipped;   // styl 6: segment ucięty u góry i tak rysowany od eqTopY
+};
+
+struct AnalyzerBarMasks {
+  uint64_t level[ANALYZER_BAR_MAX_SEG + 1];   // n segmentów od dołu
+  uint64_t peak[ANALYZER_BAR_MAX_SEG + 1];    // kreska peaku nad segmentem n
+  uint8_t  maxSegments;
+  uint8_t  segHeight;
+  bool     keepClipped;
+  bool     flip;
+  bool     valid;
+};
+
+static AnalyzerSegBars analyzerSegBarsLayout(uint8_t style)
+{
+  AnalyzerSegBars b;
 
-  // Obszar słupków – od linii w dół do końca ekranu
-  const uint8_t eqTopY      = 14;                    // pod paskiem
-  const uint8_t eqBottomY   = 64 - 1;               // SCREEN_HEIGHT = 64, do dołu
-  const uint8_t eqMaxHeight = eqBottomY - eqTopY + 1;
+  if (s_preview)
+  {
+    // Podgląd: ta sama geometria co w analyzerSetStyle() + eq_auto_fit_width(),
+    // ale z konfiguracji podglądu – eq5_/eq6_ ekranu zostają bez zmian
+    const AnalyzerStyleCfg& cfg = *s_drawCfg;
+    b.maxSegments = (style == 5) ? cfg.s5_segments : cfg.s6_segMax;
+    b.barWidth    = (style == 5) ? cfg.s5_barWidth : 10;
+    b.barGap      = (style == 5) ? cfg.s5_barGap : cfg.s6_gap;
+    if (EQ_BANDS * b.barWidth + (EQ_BANDS - 1) * b.barGap > 256)
+    {
+      b.barWidth = (256 - (EQ_BANDS - 1) * b.barGap) / EQ_BANDS;
+      if (b.barWidth < 2) b.barWidth = 2;
+    }
+  }
+  else
+  {
+    // Auto-dopasowanie do pełnej szerokości ekranu
+    eq_auto_fit_width(style, 256);
+    b.maxSegments = (style == 5) ? eq5_maxSegments : eq6_maxSegments;
+    b.barWidth    = (style == 5) ? eq_barWidth5 : eq_barWidth6;
+    b.barGap      = (style == 5) ? eq_barGap5 : eq_barGap6;
+  }
 
-  // Konfigurowalna liczba segmentów
-  const uint8_t maxSegments = eq5_maxSegments;
+  if (style == 5)
+  {
+    b.segHeight   = s_drawCfg->s5_segHeight;   // Konfigurowalna wysokość segmentu
+    b.keepClipped = false;
+  }
+  else
+  {
+    // Wszystkie segmenty identyczne – tyle, ile zmieści się w wysokości
+    const int16_t eqMaxHeight = ANALYZER_BAR_BOTTOM_Y - ANALYZER_BAR_TOP_Y + 1;
+    int16_t availableHeight = eqMaxHeight - (b.maxSegments - 1) * ANALYZER_BAR_SEG_GAP;
+    b.segHeight = (availableHeight > 0) ? (availableHeight / b.maxSegments) : 1;
+    if (b.segHeight < 1) b.segHeight = 1;  // Minimum 1 piksel wysokości
+    b.keepClipped = true;
+  }
 
-  // Auto-dopasowanie do pełnej szerokości ekranu
-  eq_auto_fit_width(5, 256);
-  
-  // Parametry słupków – 16 sztuk (konfigurowalne)
-  const uint8_t barWidth = eq_barWidth5;
-  const uint8_t barGap   = eq_barGap5;
+  const uint16_t totalBarsWidth = EQ_BANDS * b.barWidth + (EQ_BANDS - 1) * b.barGap;
+  b.startX = (256 - totalBarsWidth) / 2;  // SCREEN_WIDTH = 256
+  if (b.startX < 2) b.startX = 2;  // Minimalny margines
+  return b;
+}
 
-  const uint16_t totalBarsWidth = EQ_BANDS * barWidth + (EQ_BANDS - 1) * barGap;
-  int16_t startX = (256 - totalBarsWidth) / 2;  // SCREEN_WIDTH = 256
-  if (startX < 2) startX = 2;  // Minimalny margines
+static void analyzerBuildBarMasks(AnalyzerBarMasks& m, const OledColumns& c, const AnalyzerSegBars& b)
+{
+  if (m.valid && m.maxSegments == b.maxSegments && m.segHeight == b.segHeight &&
+      m.keepClipped == b.keepClipped && m.flip == c.flip) return;
 
-  // Rysowanie słupków z peakami
-  for (uint8_t i = 0; i < EQ_BANDS; i++)
+  const int16_t eqTopY    = ANALYZER_BAR_TOP_Y;
+  const int16_t eqBottomY = ANALYZER_BAR_BOTTOM_Y;
+  const uint8_t h = b.segHeight;
+
+  m.level[0] = 0;
+  m.peak[0]  = 0;
+  for (uint8_t s = 0; s < b.maxSegments; s++)
   {
-    uint8_t levelPercent = eqLevel[i];  // 0-100
-    uint8_t peakPercent  = eqPeak[i];   // 0-100
+    int16_t segBottom = eqBottomY - (s * (h + ANALYZER_BAR_SEG_GAP));
+    int16_t segTop    = segBottom - h + 1;
+    int16_t peakY     = segTop - 2;   // 2 piksele nad segmentem
+
+    int16_t clipBottom = segBottom;
+    if (segTop < eqTopY) segTop = eqTopY;
+    if (clipBottom > eqBottomY) clipBottom = eqBottomY;
+    if (b.keepClipped && clipBottom < segTop) clipBottom = segTop;
+
+    // jak drawBox(x, segTop, barWidth, segHeight)
+    uint64_t seg = (segTop <= clipBottom) ? oledColumnsSpan(c, segTop, segTop + h - 1) : 0;
+    m.level[s + 1] = m.level[s] | seg;
+    m.peak[s + 1]  = (peakY >= eqTopY && peakY <= eqBottomY) ? oledColumnsSpan(c, peakY, peakY) : 0;
+  }
 
-    // Liczba segmentów w słupku
-    uint8_t segments = (levelPercent * maxSegments) / 100;
-    if (segments > maxSegments) segments = maxSegments;
+  m.maxSegments = b.maxSegments;
+  m.segHeight   = b.segHeight;
+  m.keepClipped = b.keepClipped;
+  m.flip        = c.flip;
+  m.valid       = true;
+}
+
+// masks == nullptr (albo nieobsługiwany bufor) – drawBox() po staremu
+static void analyzerDrawSegBars(U8G2& u8g2, const AnalyzerSegBars& b,
+                                const uint8_t* level, const uint8_t* peak,
+                                AnalyzerBarMasks* masks)
+{
+  OledColumns cols;
+  if (masks && (b.maxSegments > ANALYZER_BAR_MAX_SEG || !oledColumnsBegin(u8g2, cols))) masks = nullptr;
+  if (masks) analyzerBuildBarMasks(*masks, cols, b);
 
-    // Pozycja „peak" w segmentach
-    uint8_t peakSeg = (peakPercent * maxSegments) / 100;
+  const int16_t eqTopY    = ANALYZER_BAR_TOP_Y;
+  const int16_t eqBottomY = ANALYZER_BAR_BOTTOM_Y;
+  const uint8_t maxSegments   = b.maxSegments;
+  const uint8_t segmentHeight = b.segHeight;
+  const uint8_t segmentGap    = ANALYZER_BAR_SEG_GAP;
+
+  for (uint8_t i = 0; i < EQ_BANDS; i++)
+  {
+    // Liczba segmentów w słupku i pozycja „peak" w segmentach (0-100 → 0..max)
+    uint8_t segments = (level[i] * maxSegments) / 100;
+    if (segments > maxSegments) segments = maxSegments;
+    uint8_t peakSeg = (peak[i] * maxSegments) / 100;
     if (peakSeg > maxSegments) peakSeg = maxSegments;
 
-    // x słupka
-    int16_t x = startX + i * (barWidth + barGap);
+    int16_t x = b.startX + i * (b.barWidth + b.barGap);
 
-    // Rysujemy segmenty od dołu - używamy konfigurowalnej wysokości segmentu
-    uint8_t segmentGap = 1;  // 1 piksel przerwy między segmentami
-    uint8_t segmentHeight = g_cfg.s5_segHeight;  // Konfigurowalna wysokość segmentu
-    
+    if (masks)
+    {
+      oledColumnsDraw(cols, x, b.barWidth, masks->level[segments] | masks->peak[peakSeg]);
+      continue;
+    }
+
+    // Rysujemy segmenty od dołu – wszystkie segmenty mają identyczną wysokość
     for (uint8_t s = 0; s < segments; s++)
     {
       int16_t segBottom = eqBottomY - (s * (segmentHeight + segmentGap));
@@ -652,9 +1023,10 @@ void vuMeterMode5() // Tryb 5: 16 słupków – dynamiczny analizator z zegarem
 
       if (segTop < eqTopY) segTop = eqTopY;
       if (segBottom > eqBottomY) segBottom = eqBottomY;
-      
+      if (b.keepClipped && segBottom < segTop) segBottom = segTop;
+
       if (segTop <= segBottom) {
-        u8g2.drawBox(x, segTop, barWidth, segmentHeight);  // Wszystkie segmenty mają identyczną wysokość
+        u8g2.drawBox(x, segTop, b.barWidth, segmentHeight);
       }
     }
 
@@ -666,440 +1038,814 @@ void vuMeterMode5() // Tryb 5: 16 słupków – dynamiczny analizator z zegarem
       int16_t peakY = peakSegBottom - segmentHeight + 1 - 2; // 2 piksele nad segmentem
       if (peakY >= eqTopY && peakY <= eqBottomY)
       {
-        u8g2.drawBox(x, peakY, barWidth, 1);
+        u8g2.drawBox(x, peakY, b.barWidth, 1);
       }
     }
   }
-
-  u8g2.sendBuffer();
 }
 
 // ─────────────────────────────────────
-// STYL 6 – cienkie kreski + peak + zegar
+// Skala szarości – gasnący peak stylów 5/6
 // ─────────────────────────────────────
+// Kreska peaku zapala się na pełnej jasności i przez peakHoldTimeMs gaśnie
+// do ANALYZER_PEAK_GRAY_MIN; wiek liczony od chwili, gdy peak ostatnio wzrósł.
+static const uint8_t ANALYZER_PEAK_GRAY_MIN = 4;
 
-void vuMeterMode6() // Tryb 6: 16 słupków z cienkich „kreseczek" + peak, pełny analizator segmentowy
+struct AnalyzerPeakFade {
+  uint8_t  seg[EQ_BANDS];       // segment peaku z poprzedniej klatki
+  uint32_t sinceMs[EQ_BANDS];   // ostatni wzrost peaku
+};
+
+static void analyzerGrayPeaks(const AnalyzerSegBars& b, const uint8_t* peak, AnalyzerPeakFade& fade)
 {
-  // Powiedz analizatorowi, że jest aktywny
-  eq_analyzer_set_runtime_active(true);
-  
-  if (!eqAnalyzerEnabled)
+  const uint32_t now  = millis();
+  const uint32_t hold = s_drawCfg->peakHoldTimeMs ? s_drawCfg->peakHoldTimeMs : 1;
+
+  for (uint8_t i = 0; i < EQ_BANDS; i++)
   {
-    u8g2.clearBuffer();
-    u8g2.setFont(u8g2_font_6x12_tf);
-    u8g2.setCursor(10, 24);
-    u8g2.print("ANALYZER OFF");
-    u8g2.setCursor(10, 40);
-    u8g2.print("Enable in Web UI");
-    u8g2.sendBuffer();
-    return;
+    uint8_t peakSeg = (peak[i] * b.maxSegments) / 100;
+    if (peakSeg > b.maxSegments) peakSeg = b.maxSegments;
+    if (peakSeg > fade.seg[i]) fade.sinceMs[i] = now;
+    fade.seg[i] = peakSeg;
+    if (peakSeg == 0) continue;
+
+    uint32_t age = now - fade.sinceMs[i];
+    if (age > hold) age = hold;
+    const uint8_t lv = OLED_GRAY_MAX - (uint8_t)((OLED_GRAY_MAX - ANALYZER_PEAK_GRAY_MIN) * age / hold);
+
+    // ta sama pozycja co kreska 1bpp w analyzerDrawSegBars()
+    int16_t peakSegBottom = ANALYZER_BAR_BOTTOM_Y - ((peakSeg - 1) * (b.segHeight + ANALYZER_BAR_SEG_GAP));
+    int16_t peakY = peakSegBottom - b.segHeight + 1 - 2;
+    if (peakY >= ANALYZER_BAR_TOP_Y && peakY <= ANALYZER_BAR_BOTTOM_Y)
+      oledGrayFillRect(b.startX + i * (b.barWidth + b.barGap), peakY, b.barWidth, 1, lv);
   }
+}
 
-  // Sprawdź czy próbki napływają
-  static uint32_t noSamplesTime6 = 0;
-  if (!eq_analyzer_is_receiving_samples())
+// Słupki stylu 5/6 na płótnie; w skali szarości peak osobno, w ramce 4bpp
+static void analyzerDrawBarsFrame(U8G2& u8g2, const AnalyzerSegBars& b,
+                                  AnalyzerBarMasks& masks, AnalyzerPeakFade& fade)
+{
+  if (!s_gray)
   {
-    if (noSamplesTime6 == 0) noSamplesTime6 = millis();
-    
-    u8g2.clearBuffer();
-    u8g2.setFont(u8g2_font_6x12_tf);
-    u8g2.setCursor(10, 16);
-    u8g2.print("NO AUDIO SAMPLES");
-    u8g2.setCursor(10, 32);
-    u8g2.print("Count: ");
-    u8g2.print(eq_analyzer_get_sample_count());
-    
-    // Po 3 sekundach włącz generator testowy
-    if (millis() - noSamplesTime6 > 3000) {
-      u8g2.setCursor(10, 48);
-      u8g2.print("Enabling test mode...");
-      eq_analyzer_enable_test_generator(true);
-      noSamplesTime6 = millis(); // Reset timer
-    } else {
-      u8g2.setCursor(10, 48);
-      u8g2.print("Check audio source");
-    }
-    u8g2.sendBuffer();
+    analyzerDrawSegBars(u8g2, b, eqLevel, eqPeak, &masks);
     return;
-  } else {
-    noSamplesTime6 = 0; // Reset when receiving samples
-    eq_analyzer_enable_test_generator(false); // Wyłącz generator gdy mamy audio
   }
+  static const uint8_t noPeak[EQ_BANDS] = {};
+  analyzerDrawSegBars(u8g2, b, eqLevel, noPeak, &masks);
+  analyzerGrayBase(u8g2);
+  analyzerGrayPeaks(b, eqPeak, fade);
+}
 
-  // 1. Pobranie poziomów z analizatora FFT (0..1)
-  float levels[EQ_BANDS];
-  float peaks[EQ_BANDS];
-  eq_get_analyzer_levels(levels);
-  eq_get_analyzer_peaks(peaks);
-
-  // Konwersja poziomów - jeśli mute to animacja opadania słupków
-  static uint8_t muteLevel6[EQ_BANDS] = {0}; // Zapamietane poziomy dla animacji mute
-  
-  for (uint8_t i = 0; i < EQ_BANDS && i < EQ_BANDS; i++)
+// Porównanie obu ścieżek na prywatnym płótnie: te same losowe poziomy
+// rysowane przez drawBox() i przez maski, czas każdej i zgodność bufora.
+String analyzerBarsBenchToJson(uint8_t style, uint16_t frames)
+{
+  if (style != 6) style = 5;
+  if (frames < 1) frames = 1;
+  if (frames > 2000) frames = 2000;   // handler async_tcp – bez długiego blokowania
+
+  static U8G2_SSD1322_NHD_256X64_F_4W_HW_SPI bench(U8G2_R2, U8X8_PIN_NONE, U8X8_PIN_NONE, U8X8_PIN_NONE);
+  static uint8_t* benchBuf = nullptr;
+  static uint8_t* refBuf   = nullptr;
+  const size_t bufBytes = 256 * 64 / 8;
+  if (!benchBuf) benchBuf = (uint8_t*)malloc(bufBytes);
+  if (!refBuf)   refBuf   = (uint8_t*)malloc(bufBytes);
+  if (!benchBuf || !refBuf) return "{\"error\":\"no memory\"}";
+  bench.getU8g2()->tile_buf_ptr = benchBuf;   // nie ruszamy wspólnego bufora u8g2
+
+  AnalyzerSegBars  bars = analyzerSegBarsLayout(style);
+  AnalyzerBarMasks masks = {};
+  uint8_t lv[EQ_BANDS], pk[EQ_BANDS];
+  uint32_t boxUs = 0, directUs = 0, mismatch = 0;
+
+  for (uint16_t f = 0; f < frames; f++)
   {
-    if (volumeMute) {
-      // Podczas mute - stopniowo opuszczaj słupki (animacja)
-      if (muteLevel6[i] > 2) {
-        muteLevel6[i] -= 2; // Opadanie o 2% na klatkę
-      } else {
-        muteLevel6[i] = 0;
-      }
-      eqLevel[i] = muteLevel6[i];
-      eqPeak[i] = 0; // Peak natychmiast znika
-    } else {
-      float lv = levels[i];
-      float pk = peaks[i];
-      if (lv < 0.0f) lv = 0.0f;
-      if (lv > 1.0f) lv = 1.0f;
-      if (pk < 0.0f) pk = 0.0f;
-      if (pk > 1.0f) pk = 1.0f;
-
-      uint8_t newLevel = (uint8_t)(lv * 100.0f + 0.5f);
-      eqLevel[i] = newLevel;
-      eqPeak[i] = (uint8_t)(pk * 100.0f + 0.5f);
-      muteLevel6[i] = newLevel; // Zapamietaj poziom dla animacji mute
+    for (uint8_t i = 0; i < EQ_BANDS; i++)
+    {
+      lv[i] = random(101);
+      pk[i] = lv[i] + random(101 - lv[i]);
     }
-  }
 
-  // 2. Rysowanie – pasek z zegarem + stacja + głośnik u góry, cienkie słupki pod spodem
-  u8g2.setDrawColor(1);
-  u8g2.clearBuffer();
+    bench.clearBuffer();
+    uint32_t t0 = micros();
+    analyzerDrawSegBars(bench, bars, lv, pk, nullptr);
+    boxUs += micros() - t0;
+    memcpy(refBuf, benchBuf, bufBytes);
+
+    bench.clearBuffer();
+    t0 = micros();
+    analyzerDrawSegBars(bench, bars, lv, pk, &masks);
+    directUs += micros() - t0;
+    if (memcmp(refBuf, benchBuf, bufBytes) != 0) mismatch++;
+  }
 
-  struct tm timeinfo;
-  if (getLocalTime(&timeinfo, 5))
-  {
-    char timeString[9];
-    if (timeinfo.tm_sec % 2 == 0)
-      snprintf(timeString, sizeof(timeString), "%2d:%02d", timeinfo.tm_hour, timeinfo.tm_min);
-    else
-      snprintf(timeString, sizeof(timeString), "%2d %02d", timeinfo.tm_hour, timeinfo.tm_min);
+  String json = "{";
+  json += "\"style\":"       + String(style) + ",";
+  json += "\"frames\":"      + String(frames) + ",";
+  json += "\"drawBoxUs\":"   + String((float)boxUs / frames, 1) + ",";
+  json += "\"directUs\":"    + String((float)directUs / frames, 1) + ",";
+  json += "\"speedup\":"     + String(directUs ? (float)boxUs / (float)directUs : 0.0f, 1) + ",";
+  json += "\"mismatch\":"    + String(mismatch);
+  json += "}";
+  return json;
+}
 
-    u8g2.setFont(u8g2_font_6x12_tf);
-    u8g2.setCursor(4, 11);
-    u8g2.print(timeString);
+// ─────────────────────────────────────
+// Widżety ruchome stylów 5-12
+// ─────────────────────────────────────
 
-    uint8_t timeWidth = u8g2.getStrWidth(timeString);
-    uint8_t xStation  = 4 + timeWidth + 6;
+// Słupki segmentowe stylu 5/6 – kolumny wprost w bufor (drawBox() tylko awaryjnie)
+static void analyzerWidgetBars(U8G2& u8g2, AnalyzerFrameCtx& c)
+{
+  static AnalyzerBarMasks masks[2];
+  static AnalyzerPeakFade fade[2];
+  const uint8_t style = (c.mode == 6) ? 6 : 5;
+  AnalyzerSegBars bars = analyzerSegBarsLayout(style);
+  analyzerDrawBarsFrame(u8g2, bars, masks[style - 5], fade[style - 5]);
+}
 
-    uint8_t iconX = 256 - 40;  // SCREEN_WIDTH = 256
-    uint8_t maxStationWidth = 0;
-    if (iconX > xStation + 4)
-      maxStationWidth = iconX - xStation - 4;
+// Styl 7: kółka po okręgu, promień wg poziomu
+static void analyzerWidgetRadial(U8G2& u8g2, AnalyzerFrameCtx&)
+{
+  int centerX = 128;
+  int centerY = 32;
+  
+  for (uint8_t i = 0; i < EQ_BANDS; i++) {
+    int32_t angle = (int32_t)i * TRIG_STEPS / EQ_BANDS;   // kroki tablicy trig
+    int radius = 10 + (eqLevel[i] * 20) / 100;
+    
+    int x = centerX + trigMulCos(radius, angle);
+    int y = centerY + trigMulSin(radius, angle);
+    
+    u8g2.drawCircle(x, y, 2);
+  }
+}
 
-    if (maxStationWidth > 0)
-    {
-      String nameToShow = stationName;
-      if (nameToShow.length() == 0)
-      {
-        if (stationNameStream.length() > 0)      nameToShow = stationNameStream;
-        else if (stationStringWeb.length() > 0)  nameToShow = stationStringWeb;
-        else                                     nameToShow = "Radio";
-      }
+// Styl 8: poziome linie; w skali szarości gradientem (s8_gradient)
+static void analyzerWidgetLines(U8G2& u8g2, AnalyzerFrameCtx&)
+{
+  analyzerGrayBase(u8g2);   // skala szarości: pusty podkład, linie gradientem
+  
+  for (uint8_t i = 0; i < EQ_BANDS; i++) {
+    int y = 10 + i * 3;
+    int lineWidth = (eqLevel[i] * 240) / 100;
+    
+    if (lineWidth > 0) {
+      if (s_gray) oledGrayHGradient(8, y, lineWidth, 2, 240, 3, OLED_GRAY_MAX);
+      else        u8g2.drawBox(8, y, lineWidth, 2);
+    }
+  }
+}
 
-      while (nameToShow.length() > 0 &&
-             u8g2.getStrWidth(nameToShow.c_str()) > maxStationWidth)
-      {
-        nameToShow.remove(nameToShow.length() - 1);
-      }
+// Styl 9: spadające gwiazdki – cząstki z puli OLED_Particles. Gwiazdka
+// rodzi się, gdy pasmo wyraźnie wyskoczy ponad swoją średnią, na wysokości
+// zależnej od poziomu (głośniej = wyżej), potem opada i pod koniec topnieje.
+// Przy mute nowe się nie rodzą, a istniejące spadają z ekranu.
+// Fizyka idzie stałym krokiem ANALYZER_PARTICLE_STEP_MS (z czasu klatki,
+// nie z jej numeru), więc tempo spadania nie zależy od FPS stylu.
+static const uint8_t ANALYZER_PARTICLE_STEP_MS = 33;   // krok fizyki jak przy 30 FPS
+static const uint8_t ANALYZER_ONSET_RISE = 12;   // wzrost ponad średnią pasma [%]
+static const uint8_t ANALYZER_ONSET_MIN  = 10;   // poniżej – cisza, bez gwiazdek
+static const uint8_t ANALYZER_ONSET_HOLD = 3;    // klatki przerwy między gwiazdkami pasma
+
+static void analyzerWidgetParticles(U8G2& u8g2, AnalyzerFrameCtx& c)
+{
+  static uint8_t avg[EQ_BANDS];    // wolna średnia pasma (1/8 na klatkę)
+  static uint8_t hold[EQ_BANDS];
+
+  // sprite'y liczone tylko po zmianie parametrów stylu
+  const AnalyzerStyleCfg& cfg = *s_drawCfg;
+  particlesSprites(cfg.s9_centerSize, cfg.s9_centerSize + cfg.s9_armLength / 2,
+                   cfg.s9_filled, cfg.s9_showSpikes);
+  if (c.preview)   // podgląd: tylko bieżące gwiazdki, bez narodzin i kroku fizyki
+  {
+    particlesDraw(u8g2);
+    return;
+  }
 
-      u8g2.setCursor(xStation, 11);
-      u8g2.print(nameToShow);
-    }
+  for (uint8_t i = 0; i < EQ_BANDS; i++)
+  {
+    const uint8_t lv = (uint8_t)(c.raw[i] * 100.0f + 0.5f);
+    const bool onset = !c.st.mute && hold[i] == 0 &&
+                       lv >= ANALYZER_ONSET_MIN && lv > avg[i] + ANALYZER_ONSET_RISE;
+    avg[i] = (uint8_t)(((uint16_t)avg[i] * 7 + lv) / 8);
+    if (hold[i]) hold[i]--;
+    if (!onset) continue;
+
+    const int16_t x = (i * 256) / EQ_BANDS + (256 / EQ_BANDS) / 2;   // SCREEN_WIDTH = 256
+    const int16_t y = 64 - (lv * 64 * 9) / 1000 - 5;                 // jak dawniej: 0.9 wysokości, 5 px od góry
+    const uint8_t size = (uint8_t)((lv * (OLED_PARTICLE_SIZES - 1) + 50) / 100);
+    particlesSpawn(x, y, (int8_t)(random(9) - 4), 0, size, 60 + random(40));
+    hold[i] = ANALYZER_ONSET_HOLD;
   }
 
-  // Ikonka głośnika po prawej
-  uint8_t iconY = 2;
-  uint8_t iconX = 256 - 40;  // SCREEN_WIDTH = 256
+  // s9_smoothness 10..90: większe = wolniejsze opadanie (prędkość graniczna w Q4)
+  const int8_t maxVy = 8 + (100 - cfg.s9_smoothness) / 4;
+  static uint16_t stepAcc = 0;
+  stepAcc += c.dtMs;
+  while (stepAcc >= ANALYZER_PARTICLE_STEP_MS)
+  {
+    particlesStep(1, maxVy, 2);
+    stepAcc -= ANALYZER_PARTICLE_STEP_MS;
+  }
+  particlesDraw(u8g2);
+}
 
-  u8g2.drawBox(iconX, iconY + 2, 4, 7);
-  u8g2.drawLine(iconX + 4, iconY + 2, iconX + 7, iconY);
-  u8g2.drawLine(iconX + 4, iconY + 8, iconX + 7, iconY + 10);
-  u8g2.drawLine(iconX + 7, iconY,     iconX + 7, iconY + 10);
+// ─────────────────────────────────────
+// Waterfall (styl 10) – pierścień klatek pasm
+// ─────────────────────────────────────
+// Każda nowa klatka analizatora (publish seq) trafia do pierścienia jako
+// EQ_BANDS bajtów. Obraz waterfalla (kolumna = klatka, najnowsza z prawej,
+// niskie pasma na dole, 4 wiersze na pasmo) trzymany jest w osobnym
+// buforze: nowa klatka to przesunięcie obrazu o kolumnę i zapis jednej
+// kolumny, a nie rysowanie całej historii. Płótno dostaje kopię (2 KB).
+// Poziom 0..100 → 17 gęstości ditheringu Bayera 4x4; faza wzoru idzie za
+// numerem klatki, więc wzór przesuwa się razem z obrazem.
+
+static uint8_t  s_wfRing[ANALYZER_WF_FRAMES][EQ_BANDS];
+static uint32_t s_wfCount   = 0;    // klatki dopisane od startu
+static uint32_t s_wfLastSeq = 0;
+
+static uint8_t* s_wfImage      = nullptr;   // obraz 256x64 w układzie bufora u8g2
+static uint32_t s_wfImageCount = 0;         // s_wfCount w chwili ostatniej aktualizacji
+static bool     s_wfImageValid = false;
+static bool     s_wfImageFlip  = false;
+
+static const uint8_t ANALYZER_WF_ROWS = 64 / EQ_BANDS;   // wiersze na pasmo
+
+static void analyzerWaterfallPush(const uint8_t* level)
+{
+  const uint32_t seq = eq_analyzer_get_publish_seq();
+  if (seq == s_wfLastSeq) return;
+  s_wfLastSeq = seq;
+  __atomic_thread_fence(__ATOMIC_RELEASE);   // poprzedni licznik widoczny przed nadpisaniem slotu
+  memcpy(s_wfRing[s_wfCount % ANALYZER_WF_FRAMES], level, EQ_BANDS);
+  __atomic_store_n(&s_wfCount, s_wfCount + 1, __ATOMIC_RELEASE);   // klatka gotowa, potem licznik
+}
 
-  if (volumeMute) {
-    // Przekreślenie dla mute - X nad ikonką
-    u8g2.drawLine(iconX - 1, iconY, iconX + 11, iconY + 12);     // skos \
-    u8g2.drawLine(iconX - 1, iconY + 12, iconX + 11, iconY);     // skos /
-  } else {
-    // Fale dźwięku tylko gdy nie ma mute
-    u8g2.drawPixel(iconX + 9,  iconY + 3);
-    u8g2.drawPixel(iconX + 10, iconY + 5);
-    u8g2.drawPixel(iconX + 9,  iconY + 7);
+// Kopia bez blokady (jeden zapisujący – zadanie renderujące). Zapis klatki
+// n nadpisuje klatkę n - ANALYZER_WF_FRAMES, więc po kopii odrzucamy z
+// początku te, które zadanie mogło nadpisać w jej trakcie (licznik po kopii).
+uint16_t analyzerWaterfallSnapshot(uint8_t* out, size_t cap, uint32_t* seq)
+{
+  const uint32_t count = __atomic_load_n(&s_wfCount, __ATOMIC_ACQUIRE);
+  uint16_t frames = (count < ANALYZER_WF_FRAMES) ? count : ANALYZER_WF_FRAMES;
+  if ((size_t)frames * EQ_BANDS > cap) frames = cap / EQ_BANDS;
+  const uint32_t first = count - frames;
+  for (uint16_t k = 0; k < frames; k++)
+    memcpy(out + k * EQ_BANDS, s_wfRing[(first + k) % ANALYZER_WF_FRAMES], EQ_BANDS);
+
+  __atomic_thread_fence(__ATOMIC_ACQUIRE);
+  const uint32_t after = __atomic_load_n(&s_wfCount, __ATOMIC_RELAXED);
+  // klatka 'after' może być właśnie w zapisie – bezpieczne są n > after - FRAMES
+  const uint32_t safe = (after + 1 > ANALYZER_WF_FRAMES) ? after + 1 - ANALYZER_WF_FRAMES : 0;
+  if (safe > first)
+  {
+    const uint32_t drop = (safe - first < frames) ? safe - first : frames;
+    memmove(out, out + drop * EQ_BANDS, (frames - drop) * EQ_BANDS);
+    frames -= drop;
   }
+  if (seq) *seq = count;
+  return frames;
+}
 
-  // Wartość głośności lub napis MUTED
-  u8g2.setFont(u8g2_font_5x8_mr);
-  u8g2.setCursor(iconX + 14, 10);
-  if (volumeMute) {
-    u8g2.print("MUTED");
-  } else {
-    u8g2.print(volumeValue);
+// Maska kolumny (bit y = wiersz ekranu y) dla klatki n pierścienia
+static uint64_t analyzerWaterfallColumn(uint32_t n)
+{
+  static const uint8_t bayer[4][4] = { { 0, 8, 2, 10 }, { 12, 4, 14, 6 }, { 3, 11, 1, 9 }, { 15, 7, 13, 5 } };
+  const uint8_t* f = s_wfRing[n % ANALYZER_WF_FRAMES];
+  const uint8_t phase = n & 3;
+  uint64_t m = 0;
+  for (uint8_t b = 0; b < EQ_BANDS; b++)
+  {
+    const uint8_t q = (uint8_t)((f[b] * 17) / 101);   // 0..16
+    const uint8_t y0 = 64 - (b + 1) * ANALYZER_WF_ROWS;
+    for (uint8_t r = 0; r < ANALYZER_WF_ROWS; r++)
+      if (q > bayer[r & 3][phase]) m |= 1ULL << (y0 + r);
   }
+  return m;
+}
 
-  u8g2.drawHLine(0, 13, 256);  // SCREEN_WIDTH = 256
+static void analyzerWidgetWaterfall(U8G2& u8g2, AnalyzerFrameCtx&)
+{
+  OledColumns canvas;
+  if (!oledColumnsBegin(u8g2, canvas)) return;   // tylko pełny bufor R0/R2
 
-  const uint8_t eqTopY      = 14;
-  const uint8_t eqBottomY   = 64 - 1;  // SCREEN_HEIGHT = 64
-  const uint8_t eqMaxHeight = eqBottomY - eqTopY + 1;
+  const size_t bytes = 256 * 64 / 8;
+  if (!s_wfImage)
+  {
+    s_wfImage = (uint8_t*)heap_caps_malloc(bytes, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if (!s_wfImage) return;
+  }
+  OledColumns img = { s_wfImage, canvas.flip };
 
-  const uint8_t maxSegments = eq6_maxSegments;
+  // pierścień pisze tylko to zadanie – odczyt bez blokady
+  const uint32_t count = s_wfCount;
+  uint32_t fresh = count - s_wfImageCount;
+  if (!s_wfImageValid || s_wfImageFlip != canvas.flip || fresh >= 256)
+  {
+    memset(s_wfImage, 0, bytes);
+    fresh = (count < 256) ? count : 256;
+  }
+  else if (fresh > 0)
+  {
+    oledColumnsShift(img, (uint8_t)fresh);
+  }
 
-  // Auto-dopasowanie do pełnej szerokości ekranu
-  eq_auto_fit_width(6, 256);
-  
-  const uint8_t barWidth = eq_barWidth6;
-  const uint8_t barGap   = eq_barGap6;
+  // najnowsze klatki w prawych kolumnach
+  for (uint32_t k = 0; k < fresh; k++)
+  {
+    const uint32_t n = count - fresh + k;
+    uint64_t m = analyzerWaterfallColumn(n);
+    oledColumnsPut(img, 256 - fresh + k, img.flip ? oledColumnsRev64(m) : m);
+  }
+  s_wfImageCount = count;
+  s_wfImageValid = true;
+  s_wfImageFlip  = canvas.flip;
 
-  const uint16_t totalBarsWidth = EQ_BANDS * barWidth + (EQ_BANDS - 1) * barGap;
-  int16_t startX = (256 - totalBarsWidth) / 2;  // SCREEN_WIDTH = 256
-  if (startX < 2) startX = 2;  // Minimalny margines
+  memcpy(canvas.buf, s_wfImage, bytes);
+}
 
-  for (uint8_t i = 0; i < EQ_BANDS; i++)
-  {
-    uint8_t levelPercent = eqLevel[i];
-    uint8_t peakPercent  = eqPeak[i];
+// ─────────────────────────────────────
+// Oscyloskop (styl 11) i Lissajous X/Y (styl 12)
+// ─────────────────────────────────────
+// Dane to migawka tapu z hooka audio (eq_scope_snapshot): na kolumnę
+// min/max mono i jedna para L/R. Nowa migawka jest kopiowana raz, widżet
+// rysuje z kopii – PCM nie opuszcza hooka. Wzmocnienie dobiera się samo:
+// szczyt migawki (szybko w górę, wolno w dół) wypełnia prawie pół ekranu.
 
-    uint8_t segments = (levelPercent * maxSegments) / 100;
-    if (segments > maxSegments) segments = maxSegments;
+static eq_scope_frame_t s_scope;
+static uint32_t s_scopeSeq   = 0;
+static bool     s_scopeValid = false;
+static int16_t  s_scopePeak  = 16;   // obwiednia szczytu (próbka >> 8)
 
-    uint8_t peakSeg = (peakPercent * maxSegments) / 100;
-    if (peakSeg > maxSegments) peakSeg = maxSegments;
+static const int16_t ANALYZER_SCOPE_MIN_PEAK = 8;   // cisza nie rozdmuchuje szumu
+static const int16_t ANALYZER_SCOPE_HALF     = 29;  // px od osi do szczytu
 
-    int16_t x = startX + i * (barWidth + barGap);
+static void analyzerScopeFetch()
+{
+  if (!s_preview) eq_scope_set_decimation(g_cfg.s11_timebase);   // podgląd nie przestawia próbkowania
+  if (s_scopeValid && eq_scope_get_seq() == s_scopeSeq) return;
+  uint32_t seq;
+  if (!eq_scope_snapshot(&s_scope, &seq)) return;
+  s_scopeSeq   = seq;
+  s_scopeValid = true;
+
+  int16_t peak = 0;
+  for (uint16_t i = 0; i < EQ_SCOPE_COLS; i++)
+  {
+    peak = max(peak, (int16_t)abs(s_scope.mn[i]));
+    peak = max(peak, (int16_t)abs(s_scope.mx[i]));
+    peak = max(peak, (int16_t)abs(s_scope.l[i]));
+    peak = max(peak, (int16_t)abs(s_scope.r[i]));
+  }
+  s_scopePeak = (peak > s_scopePeak) ? peak : (int16_t)((s_scopePeak * 7 + peak) / 8);
+  if (s_scopePeak < ANALYZER_SCOPE_MIN_PEAK) s_scopePeak = ANALYZER_SCOPE_MIN_PEAK;
+}
 
-    // Rysujemy segmenty od dołu - wszystkie segmenty identyczne
-    uint8_t segmentGap = 1;  // 1 piksel przerwy między segmentami
-    int16_t availableHeight = eqMaxHeight - (maxSegments - 1) * segmentGap;
-    uint8_t segmentHeight = (availableHeight > 0) ? (availableHeight / maxSegments) : 1;
-    if (segmentHeight < 1) segmentHeight = 1;  // Minimum 1 piksel wysokości
-    
-    for (uint8_t s = 0; s < segments; s++)
-    {
-      int16_t segBottom = eqBottomY - (s * (segmentHeight + segmentGap));
-      int16_t segTop = segBottom - segmentHeight + 1;
-      
-      if (segTop < eqTopY) segTop = eqTopY;
-      if (segBottom > eqBottomY) segBottom = eqBottomY;
-      if (segBottom < segTop) segBottom = segTop;
-      
-      if (segTop <= segBottom) {
-        u8g2.drawBox(x, segTop, barWidth, segmentHeight);  // Wszystkie segmenty mają identyczną wysokość
-      }
-    }
+static inline int16_t analyzerScopeY(int16_t v, int16_t scale)
+{
+  int16_t y = 32 - v * ANALYZER_SCOPE_HALF / scale;
+  return (y < 0) ? 0 : (y > 63 ? 63 : y);
+}
 
-    if (peakSeg > 0)
+static void analyzerWidgetScope(U8G2& u8g2, AnalyzerFrameCtx&)
+{
+  analyzerScopeFetch();
+  for (int16_t x = 0; x < 256; x += 4) u8g2.drawPixel(x, 32);   // oś zera
+  if (!s_scopeValid) return;
+
+  // wyzwalanie: pierwsze przejście przez zero w górę w zapasie migawki
+  const uint16_t spare = EQ_SCOPE_COLS - 256;
+  uint16_t start = spare / 2;
+  for (uint16_t i = 1; i <= spare; i++)
+  {
+    if (s_scope.mn[i - 1] + s_scope.mx[i - 1] < 0 && s_scope.mn[i] + s_scope.mx[i] >= 0)
     {
-      uint8_t ps = peakSeg - 1;
-      int16_t peakSegBottom = eqBottomY - (ps * (segmentHeight + segmentGap));
-      int16_t peakY = peakSegBottom - segmentHeight + 1 - 2; // 2 piksele nad segmentem
-      
-      if (peakY >= eqTopY && peakY <= eqBottomY) {
-        u8g2.drawBox(x, peakY, barWidth, 1);  // 1 piksel wysokości peak - cienka kreska
-      }
+      start = i;
+      break;
     }
   }
 
-  u8g2.sendBuffer();
+  OledColumns cols;
+  const bool direct = oledColumnsBegin(u8g2, cols);
+  int16_t prevTop = 32, prevBot = 32;
+  for (int16_t x = 0; x < 256; x++)
+  {
+    const uint16_t i = start + x;
+    const int16_t colTop = analyzerScopeY(s_scope.mx[i], s_scopePeak);
+    const int16_t colBot = analyzerScopeY(s_scope.mn[i], s_scopePeak);
+    // kolumna sięga do poprzedniej – strome zbocze bez przerw
+    const int16_t top = (x > 0 && colTop > prevBot) ? prevBot : colTop;
+    const int16_t bot = (x > 0 && colBot < prevTop) ? prevTop : colBot;
+    prevTop = colTop;
+    prevBot = colBot;
+
+    if (direct) oledColumnsDraw(cols, x, 1, oledColumnsSpan(cols, top, bot));
+    else        u8g2.drawVLine(x, top, bot - top + 1);
+  }
 }
-// 
-// NOWE STYLE ANALIZATORA 7 i 8  
-// 
 
-void vuMeterMode7() // Styl 7: Okr�g�y analizator
+// Goniometr: X/Y obrócone o 45° – mono to pion, różnica kanałów to poziom
+// (rozciągnięty 2×, bo ekran jest szeroki); punkt na kolumnę migawki.
+static void analyzerWidgetXY(U8G2& u8g2, AnalyzerFrameCtx&)
 {
-  if (!eqAnalyzerEnabled) {
-    u8g2.clearBuffer();
-    u8g2.setFont(u8g2_font_6x12_tf);
-    u8g2.setCursor(10, 24);
-    u8g2.print("ANALYZER OFF");
-    u8g2.sendBuffer();
-    return;
+  analyzerScopeFetch();
+  for (int16_t y = 0; y < 64; y += 4) u8g2.drawPixel(128, y);
+  for (int16_t x = 128 - 2 * ANALYZER_SCOPE_HALF; x <= 128 + 2 * ANALYZER_SCOPE_HALF; x += 4) u8g2.drawPixel(x, 32);
+  if (!s_scopeValid) return;
+
+  OledColumns cols;
+  const bool direct = oledColumnsBegin(u8g2, cols);
+  const int16_t scale = 2 * s_scopePeak;   // L+R i L-R mają zakres ±2 szczyty
+  for (uint16_t i = 0; i < EQ_SCOPE_COLS; i++)
+  {
+    const int16_t mid  = s_scope.l[i] + s_scope.r[i];
+    const int16_t side = s_scope.l[i] - s_scope.r[i];
+    const int16_t x = 128 + side * 2 * ANALYZER_SCOPE_HALF / scale;
+    const int16_t y = analyzerScopeY(mid, scale);
+
+    if (direct) oledColumnsDraw(cols, x, 1, oledColumnsSpan(cols, y, y));
+    else        u8g2.drawPixel(x, y);
   }
+}
 
-  // Pobierz poziomy
-  float levels[EQ_BANDS];
-  eq_get_analyzer_levels(levels);
+// ─────────────────────────────────────
+// Układ stylów 5-12
+// ─────────────────────────────────────
+// Styl to wiersz tabeli kAnalyzerLayouts: widżety rysowane po kolei.
+// Widżety z kluczem (pasek górny) tworzą warstwę tła w OLED_BgCache –
+// rysowaną od nowa tylko, gdy zmieni się klucz któregoś z nich. Pozostałe
+// rysują się co klatkę. Parametry widżety biorą z AnalyzerStyleCfg, więc
+// nowy styl to nowy wiersz tabeli i tryb w analyzerRenderStyle().
+// Czas rysowania każdego widżetu w każdym układzie: /analyzerProfile.
+
+enum AnalyzerWidgetKind : uint8_t {
+  AW_CLOCK = 0,     // zegar w pasku górnym
+  AW_STATION,       // nazwa stacji między zegarem a głośnikiem
+  AW_VOLUME,        // ikonka głośnika + głośność / MUTED
+  AW_RULE,          // linia pod paskiem
+  AW_BARS,          // słupki segmentowe (styl 5/6)
+  AW_RADIAL,        // kółka po okręgu (styl 7)
+  AW_LINES,         // poziome linie (styl 8)
+  AW_PARTICLES,     // gwiazdki z puli cząstek (styl 9)
+  AW_WATERFALL,     // historia pasm (styl 10)
+  AW_SCOPE,         // przebieg min/max z tapu (styl 11)
+  AW_XY,            // Lissajous L/R z tapu (styl 12)
+  AW_KINDS
+};
+
+typedef uint32_t (*AnalyzerWidgetKeyFn)(uint32_t h, const AnalyzerFrameCtx& c);
+typedef void     (*AnalyzerWidgetDrawFn)(U8G2& u8g2, AnalyzerFrameCtx& c);
+
+struct AnalyzerWidgetDef {
+  const char*          name;
+  AnalyzerWidgetKeyFn  key;    // nullptr = widżet ruchomy (co klatkę)
+  AnalyzerWidgetDrawFn draw;
+};
+
+static const AnalyzerWidgetDef kAnalyzerWidgets[AW_KINDS] = {
+  { "clock",     analyzerKeyClock,   analyzerWidgetClock },
+  { "station",   analyzerKeyStation, analyzerWidgetStation },
+  { "volume",    analyzerKeyVolume,  analyzerWidgetVolume },
+  { "rule",      analyzerKeyRule,    analyzerWidgetRule },
+  { "bars",      nullptr,            analyzerWidgetBars },
+  { "radial",    nullptr,            analyzerWidgetRadial },
+  { "lines",     nullptr,            analyzerWidgetLines },
+  { "particles", nullptr,            analyzerWidgetParticles },
+  { "waterfall", nullptr,            analyzerWidgetWaterfall },
+  { "scope",     nullptr,            analyzerWidgetScope },
+  { "xy",        nullptr,            analyzerWidgetXY },
+};
+
+static const uint8_t ANALYZER_LAYOUT_WIDGETS = 6;
+static const uint8_t ANALYZER_NO_BG = 0xFF;
+
+struct AnalyzerLayout {
+  uint8_t mode;
+  uint8_t bgSlot;          // OLED_BG_* albo ANALYZER_NO_BG
+  bool    muteFall;        // mute: poziomy opadają (obwiednia czasowa), peak znika
+  bool    samplesCheck;    // ekran "NO AUDIO SAMPLES" i generator testowy
+  uint8_t count;
+  uint8_t widgets[ANALYZER_LAYOUT_WIDGETS];
+};
+
+static const AnalyzerLayout kAnalyzerLayouts[] = {
+  { 5, OLED_BG_MODE5,  true,  true,  5, { AW_CLOCK, AW_STATION, AW_VOLUME, AW_RULE, AW_BARS } },
+  { 6, OLED_BG_MODE6,  true,  true,  5, { AW_CLOCK, AW_STATION, AW_VOLUME, AW_RULE, AW_BARS } },
+  { 7, ANALYZER_NO_BG, false, false, 1, { AW_RADIAL } },
+  { 8, ANALYZER_NO_BG, true,  false, 1, { AW_LINES } },
+  { 9, ANALYZER_NO_BG, false, false, 1, { AW_PARTICLES } },   // mute: gwiazdki przestają się rodzić
+  { 10, ANALYZER_NO_BG, true,  false, 1, { AW_WATERFALL } },   // bez tła: obraz kopiowany w całości
+  { 11, ANALYZER_NO_BG, false, true,  1, { AW_SCOPE } },       // mute: przebieg sam gaśnie
+  { 12, ANALYZER_NO_BG, false, true,  1, { AW_XY } },
+};
+static const uint8_t ANALYZER_LAYOUTS = sizeof(kAnalyzerLayouts) / sizeof(kAnalyzerLayouts[0]);
+
+struct AnalyzerWidgetStats {
+  uint32_t draws;
+  uint32_t avgUs;          // średnia krocząca [us]
+  uint32_t maxUs;
+};
+
+struct AnalyzerLayoutRt {
+  AnalyzerWidgetStats w[ANALYZER_LAYOUT_WIDGETS];
+  uint32_t bgBlits;        // klatki z tłem skopiowanym z cache
+  uint32_t bgDraws;        // klatki z tłem rysowanym od nowa
+  uint32_t noSamplesMs;    // od kiedy brak próbek (0 = są)
+};
+
+static AnalyzerLayoutRt s_layoutRt[ANALYZER_LAYOUTS];
+
+static void analyzerWidgetRun(U8G2& u8g2, AnalyzerFrameCtx& c, AnalyzerWidgetStats& s, uint8_t kind)
+{
+  if (c.preview)   // podgląd nie wchodzi do profilu ekranu
+  {
+    kAnalyzerWidgets[kind].draw(u8g2, c);
+    return;
+  }
+  uint32_t t0 = micros();
+  kAnalyzerWidgets[kind].draw(u8g2, c);
+  uint32_t us = micros() - t0;
+  s.draws++;
+  s.avgUs = (s.draws == 1) ? us : (s.avgUs * 15 + us) / 16;
+  if (us > s.maxUs) s.maxUs = us;
+}
 
-  for (uint8_t i = 0; i < EQ_BANDS && i < EQ_BANDS; i++) {
-    float lv = (levels[i] < 0.0f) ? 0.0f : ((levels[i] > 1.0f) ? 1.0f : levels[i]);
-    eqLevel[i] = (uint8_t)(lv * 100.0f + 0.5f);
+// false = zamiast stylu ekran "NO AUDIO SAMPLES" (po 3 s generator testowy)
+static bool analyzerSamplesReady(U8G2& u8g2, AnalyzerLayoutRt& rt)
+{
+  if (eq_analyzer_is_receiving_samples())
+  {
+    rt.noSamplesMs = 0;
+    eq_analyzer_enable_test_generator(false); // Wyłącz generator gdy mamy audio
+    return true;
   }
 
-  u8g2.clearBuffer();
+  if (rt.noSamplesMs == 0) rt.noSamplesMs = millis();
   
-  // Okr�g�y analizator
-  int centerX = 128;
-  int centerY = 32;
+  u8g2.clearBuffer();
+  u8g2.setFont(u8g2_font_6x12_tf);
+  u8g2.setCursor(10, 16);
+  u8g2.print("NO AUDIO SAMPLES");
+  u8g2.setCursor(10, 32);
+  u8g2.print("Count: ");
+  u8g2.print(eq_analyzer_get_sample_count());
   
-  for (uint8_t i = 0; i < EQ_BANDS; i++) {
-    float angle = (i * 2.0 * PI) / EQ_BANDS;
-    int radius = 10 + (eqLevel[i] * 20) / 100;
-    
-    int x = centerX + cos(angle) * radius;
-    int y = centerY + sin(angle) * radius;
-    
-    u8g2.drawCircle(x, y, 2);
+  // Po 3 sekundach włącz generator testowy
+  if (millis() - rt.noSamplesMs > 3000) {
+    u8g2.setCursor(10, 48);
+    u8g2.print("Enabling test mode...");
+    eq_analyzer_enable_test_generator(true);
+    rt.noSamplesMs = millis(); // Reset timer
+  } else {
+    u8g2.setCursor(10, 48);
+    u8g2.print("Check audio source");
   }
-  
-  u8g2.sendBuffer();
+  return false;
 }
 
-void vuMeterMode8() // Styl 8: Liniowy analizator
+// ─────────────────────────────────────
+// Obwiednie pasm – animacja mute liczona z czasu, nie z klatek
+// ─────────────────────────────────────
+// Jedna obwiednia na pasmo, wspólna dla wszystkich stylów: bez mute idzie
+// za poziomem z FFT, przy mute opada o ANALYZER_MUTE_FALL_PER_S punktów
+// procentowych na sekundę – krok liczony z czasu od poprzedniej klatki.
+// Pominięte klatki (governor FPS, zadanie renderujące) nie zmieniają tempa,
+// a zmiana stylu w trakcie mute kontynuuje opadanie z tego samego miejsca.
+
+static const float    ANALYZER_MUTE_FALL_PER_S = 60.0f;  // dawne 2%/klatkę przy 30 FPS
+static const uint32_t ANALYZER_ENV_MAX_DT_MS   = 250;    // po dłuższej przerwie jeden krok 250 ms
+
+struct AnalyzerEnvelope {
+  float    level[EQ_BANDS];   // 0..100
+  uint32_t lastMs;            // 0 = jeszcze bez kroku
+};
+
+static AnalyzerEnvelope s_env = {};
+
+// target 0..1; mute = opadanie zamiast podążania; wynik 0..100 w out.
+// Zwraca krok czasu [ms] – ten sam dostają animacje widżetów (AnalyzerFrameCtx::dtMs).
+static uint16_t analyzerEnvelopeStep(const float* target, bool mute, uint8_t* out)
 {
-  // Powiedz analizatorowi, że jest aktywny
-  eq_analyzer_set_runtime_active(true);
-  
-  if (!eqAnalyzerEnabled) {
-    u8g2.clearBuffer();
-    u8g2.setFont(u8g2_font_6x12_tf);
-    u8g2.setCursor(10, 24);
-    u8g2.print("ANALYZER OFF");
-    u8g2.sendBuffer();
-    return;
+  if (s_preview)   // podgląd: obwiednie takie, jak na ekranie, bez kroku
+  {
+    for (uint8_t i = 0; i < EQ_BANDS; i++) out[i] = (uint8_t)(s_env.level[i] + 0.5f);
+    return 0;
   }
+  const uint32_t now = millis();
+  uint32_t dtMs = s_env.lastMs ? now - s_env.lastMs : 0;
+  if (dtMs > ANALYZER_ENV_MAX_DT_MS) dtMs = ANALYZER_ENV_MAX_DT_MS;
+  s_env.lastMs = now ? now : 1;
 
-  // Pobierz poziomy z animacją mute
-  float levels[EQ_BANDS];
-  eq_get_analyzer_levels(levels);
-  
-  static uint8_t muteLevel8[EQ_BANDS] = {0};
-
-  for (uint8_t i = 0; i < EQ_BANDS && i < EQ_BANDS; i++) {
-    if (volumeMute) {
-      if (muteLevel8[i] > 2) {
-        muteLevel8[i] -= 2;
-      } else {
-        muteLevel8[i] = 0;
-      }
-      eqLevel[i] = muteLevel8[i];
-    } else {
-      float lv = (levels[i] < 0.0f) ? 0.0f : ((levels[i] > 1.0f) ? 1.0f : levels[i]);
-      uint8_t newLevel = (uint8_t)(lv * 100.0f + 0.5f);
-      eqLevel[i] = newLevel;
-      muteLevel8[i] = newLevel;
-    }
+  const float fall = ANALYZER_MUTE_FALL_PER_S * (float)dtMs / 1000.0f;
+  for (uint8_t i = 0; i < EQ_BANDS; i++)
+  {
+    float& lv = s_env.level[i];
+    if (mute) lv = (lv > fall) ? lv - fall : 0.0f;
+    else      lv = target[i] * 100.0f;
+    out[i] = (uint8_t)(lv + 0.5f);
   }
+  return (uint16_t)dtMs;
+}
 
-  u8g2.clearBuffer();
-  
-  // Liniowy analizator
-  for (uint8_t i = 0; i < EQ_BANDS; i++) {
-    int y = 10 + i * 3;
-    int lineWidth = (eqLevel[i] * 240) / 100;
-    
-    if (lineWidth > 0) {
-      u8g2.drawBox(8, y, lineWidth, 2);
-    }
+// Poziomy z FFT → eqLevel/eqPeak (0..100); z muteFall przy mute słupki opadają
+static void analyzerFrameLevels(const AnalyzerLayout& L, AnalyzerFrameCtx& c)
+{
+  const bool mute = L.muteFall && c.st.mute;
+  float peaks[EQ_BANDS];
+  eq_get_analyzer_levels(c.raw);
+  eq_get_analyzer_peaks(peaks);
+
+  for (uint8_t i = 0; i < EQ_BANDS; i++)
+  {
+    float lv = c.raw[i];
+    float pk = peaks[i];
+    if (lv < 0.0f) lv = 0.0f;
+    if (lv > 1.0f) lv = 1.0f;
+    if (pk < 0.0f) pk = 0.0f;
+    if (pk > 1.0f) pk = 1.0f;
+    c.raw[i] = lv;
+    eqPeak[i] = mute ? 0 : (uint8_t)(pk * 100.0f + 0.5f);   // przy mute peak znika od razu
   }
-  
-  u8g2.sendBuffer();
+  c.dtMs = analyzerEnvelopeStep(c.raw, mute, eqLevel);
+  if (!c.preview) analyzerWaterfallPush(eqLevel);
 }
-void vuMeterMode9() // Styl 9: Spadające gwiazdki jak śnieg
+
+static void analyzerDrawLayout(uint8_t mode)
 {
-  // Powiedz analizatorowi, że jest aktywny
-  eq_analyzer_set_runtime_active(true);
-  
-  if (!eqAnalyzerEnabled) {
+  uint8_t li = 0;
+  while (li < ANALYZER_LAYOUTS && kAnalyzerLayouts[li].mode != mode) li++;
+  if (li == ANALYZER_LAYOUTS) return;
+  const AnalyzerLayout& L = kAnalyzerLayouts[li];
+  AnalyzerLayoutRt& rt = s_layoutRt[li];
+
+  U8G2& u8g2 = *s_gfx;   // płótno stylu (przesłania globalne u8g2)
+  AnalyzerFrameCtx c;
+  c.mode = mode;
+  c.stationX = 0;
+  c.dtMs = 0;
+  c.preview = s_preview;
+  c.timeString[0] = '\0';
+  oledGetState(&c.st);
+  // Powiedz analizatorowi, że jest aktywny; tap przebiegu tylko dla stylów 11/12.
+  // Podgląd rysuje z tego, co analizator już ma – flagi należą do ekranu.
+  if (!c.preview)
+  {
+    eq_analyzer_set_runtime_active(true);
+    bool scope = false;
+    for (uint8_t w = 0; w < L.count; w++) scope |= (L.widgets[w] == AW_SCOPE || L.widgets[w] == AW_XY);
+    eq_scope_set_active(scope);
+  }
+
+  // Jeśli analizator jest wyłączony – pokaż prosty komunikat
+  if (!eqAnalyzerEnabled)
+  {
     u8g2.clearBuffer();
     u8g2.setFont(u8g2_font_6x12_tf);
     u8g2.setCursor(10, 24);
     u8g2.print("ANALYZER OFF");
-    u8g2.sendBuffer();
+    u8g2.setCursor(10, 40);
+    u8g2.print("Enable in Web UI");
     return;
   }
 
-  // Pobierz poziomy
-  float levels[EQ_BANDS];
-  eq_get_analyzer_levels(levels);
+  if (L.samplesCheck && !c.preview && !analyzerSamplesReady(u8g2, rt)) return;
+  analyzerFrameLevels(L, c);
 
-  u8g2.clearBuffer();
-  
-  // Parametry ekranu
-  const int screenWidth = 256;
-  const int screenHeight = 64;
-  
-  // Animacja mute dla gwiazdek
-  static float muteLevel9[EQ_BANDS] = {0.0f};
-  
-  // Każdy band FFT reprezentuje jedną gwiazdkę
-  for (uint8_t i = 0; i < EQ_BANDS && i < EQ_BANDS; i++) {
-    float lv;
-    if (volumeMute) {
-      if (muteLevel9[i] > 0.02f) {
-        muteLevel9[i] -= 0.02f; // Opadanie o 2% na klatkę
-      } else {
-        muteLevel9[i] = 0.0f;
-      }
-      lv = muteLevel9[i];
-    } else {
-      lv = (levels[i] < 0.0f) ? 0.0f : ((levels[i] > 1.0f) ? 1.0f : levels[i]);
-      muteLevel9[i] = lv;
+  // 1. Warstwa tła – klucz ze wszystkich widżetów tła, z cache albo od nowa
+  bool hasBg = false;
+  uint32_t key = OLED_BG_HASH_INIT;
+  for (uint8_t w = 0; w < L.count; w++)
+  {
+    const AnalyzerWidgetDef& d = kAnalyzerWidgets[L.widgets[w]];
+    if (!d.key) continue;
+    if (!hasBg) analyzerClockString(c.timeString, sizeof(c.timeString));
+    hasBg = true;
+    key = d.key(key, c);
+  }
+
+  if (hasBg && L.bgSlot != ANALYZER_NO_BG && oledBgBlit(u8g2, L.bgSlot, key))
+  {
+    if (!c.preview) rt.bgBlits++;
+  }
+  else
+  {
+    u8g2.setDrawColor(1);
+    u8g2.clearBuffer();
+    for (uint8_t w = 0; w < L.count; w++)
+      if (kAnalyzerWidgets[L.widgets[w]].key) analyzerWidgetRun(u8g2, c, rt.w[w], L.widgets[w]);
+    if (hasBg)
+    {
+      if (L.bgSlot != ANALYZER_NO_BG) oledBgStore(u8g2, L.bgSlot, key);
+      if (!c.preview) rt.bgDraws++;
     }
-    
-    // Pozycja X gwiazdki (rozmieszczone równomiernie na szerokości)
-    int starX = (i * screenWidth) / EQ_BANDS + (screenWidth / EQ_BANDS) / 2;
-    
-    // Pozycja Y gwiazdki (im wyższy poziom audio, tym wyżej gwiazdka - efekt spadania)
-    // Odwracamy logikę: wysokie poziomy = góra ekranu (niższe Y)
-    int starY = screenHeight - (int)(lv * screenHeight * 0.9f) - 5; // -5 żeby nie dotykać góry
-    
-    // Rozmiar gwiazdki na podstawie poziomu audio
-    float starSize = g_cfg.s9_centerSize + (lv * g_cfg.s9_armLength * 0.5f);
-    
-    // Rysowanie małej 6-ramiennej gwiazdki tylko jeśli poziom > 0.05
-    if (lv > 0.05f) {
-      // Środek gwiazdki
-      if (g_cfg.s9_filled) {
-        u8g2.drawDisc(starX, starY, max(1, (int)(starSize * 0.2f)));
-      } else {
-        u8g2.drawPixel(starX, starY);
-      }
-      
-      // 6 ramion gwiazdki
-      for (uint8_t arm = 0; arm < 6; arm++) {
-        float angle = arm * PI / 3.0f; // 60 stopni między ramionami
-        
-        // Długość ramienia proporcjonalna do rozmiaru gwiazdki
-        int armLength = (int)(starSize * 0.8f);
-        if (armLength < 2) armLength = 2; // Minimalna długość
-        
-        // Koniec ramienia
-        int armEndX = starX + cos(angle) * armLength;
-        int armEndY = starY + sin(angle) * armLength;
-        
-        // Sprawdź czy ramię mieści się na ekranie
-        if (armEndX >= 0 && armEndX < screenWidth && armEndY >= 0 && armEndY < screenHeight) {
-          u8g2.drawLine(starX, starY, armEndX, armEndY);
-          
-          // Dyszki na końcach (jeśli włączone i gwiazdka wystarczająco duża)
-          if (g_cfg.s9_showSpikes && starSize > 3.0f) {
-            float spikeLength = starSize * 0.3f;
-            if (spikeLength < 2) spikeLength = 2;
-            
-            // Dwie dyszki pod kątem ±45 stopni
-            float spikeAngle1 = angle - PI/4.0f; // -45 stopni
-            float spikeAngle2 = angle + PI/4.0f; // +45 stopni
-            
-            int spike1X = armEndX + cos(spikeAngle1) * spikeLength;
-            int spike1Y = armEndY + sin(spikeAngle1) * spikeLength;
-            int spike2X = armEndX + cos(spikeAngle2) * spikeLength;
-            int spike2Y = armEndY + sin(spikeAngle2) * spikeLength;
-            
-            // Rysuj dyszki jeśli mieszczą się na ekranie
-            if (spike1X >= 0 && spike1X < screenWidth && spike1Y >= 0 && spike1Y < screenHeight) {
-              u8g2.drawLine(armEndX, armEndY, spike1X, spike1Y);
-            }
-            if (spike2X >= 0 && spike2X < screenWidth && spike2Y >= 0 && spike2Y < screenHeight) {
-              u8g2.drawLine(armEndX, armEndY, spike2X, spike2Y);
-            }
-          }
-        }
-      }
+  }
+  u8g2.setDrawColor(1);
+
+  // 2. Widżety ruchome
+  for (uint8_t w = 0; w < L.count; w++)
+    if (!kAnalyzerWidgets[L.widgets[w]].key) analyzerWidgetRun(u8g2, c, rt.w[w], L.widgets[w]);
+}
+
+String analyzerProfileToJson()
+{
+  String json;
+  json.reserve(1800);
+  json += "{\"layouts\":[";
+  for (uint8_t li = 0; li < ANALYZER_LAYOUTS; li++)
+  {
+    const AnalyzerLayout& L = kAnalyzerLayouts[li];
+    const AnalyzerLayoutRt& rt = s_layoutRt[li];
+    if (li) json += ",";
+    json += "{\"mode\":"    + String(L.mode) + ",";
+    json += "\"bgBlits\":"  + String(rt.bgBlits) + ",";
+    json += "\"bgDraws\":"  + String(rt.bgDraws) + ",";
+    json += "\"widgets\":[";
+    for (uint8_t w = 0; w < L.count; w++)
+    {
+      if (w) json += ",";
+      json += "{\"name\":\"" + String(kAnalyzerWidgets[L.widgets[w]].name) + "\",";
+      json += "\"draws\":"   + String(rt.w[w].draws) + ",";
+      json += "\"avgUs\":"   + String(rt.w[w].avgUs) + ",";
+      json += "\"maxUs\":"   + String(rt.w[w].maxUs) + "}";
     }
+    json += "]}";
   }
-  
-  u8g2.sendBuffer();
+  OledParticleStats p;
+  particlesGetStats(&p);
+  json += "],\"particles\":{";
+  json += "\"alive\":"    + String(p.alive) + ",";
+  json += "\"maxAlive\":" + String(p.maxAlive) + ",";
+  json += "\"capacity\":" + String(OLED_PARTICLES_MAX) + ",";
+  json += "\"spawned\":"  + String(p.spawned) + ",";
+  json += "\"dropped\":"  + String(p.dropped);
+  eq_scope_stats_t sc;
+  eq_scope_get_stats(&sc);
+  json += "},\"scope\":{";
+  json += "\"published\":"     + String(sc.published) + ",";
+  json += "\"torn\":"          + String(sc.torn) + ",";
+  json += "\"frames\":"        + String(sc.frames) + ",";
+  json += "\"cyclesPerFrame\":" + String(sc.frames ? (float)sc.cycles / (float)sc.frames : 0.0f, 2);
+  json += "}}";
+  return json;
+}
+
+void analyzerProfileReset()
+{
+  for (uint8_t li = 0; li < ANALYZER_LAYOUTS; li++)
+  {
+    memset(s_layoutRt[li].w, 0, sizeof(s_layoutRt[li].w));
+    s_layoutRt[li].bgBlits = 0;
+    s_layoutRt[li].bgDraws = 0;
+  }
+  particlesResetStats();
+}
+
+// ─────────────────────────────────────
+// Style 5-12
+// ─────────────────────────────────────
+
+void vuMeterMode5() // Tryb 5: 16 słupków – dynamiczny analizator z zegarem i ikonką głośnika
+{
+  analyzerDrawLayout(5);
+}
+
+void vuMeterMode6() // Tryb 6: 16 słupków z cienkich „kreseczek" + peak, pełny analizator segmentowy
+{
+  analyzerDrawLayout(6);
+}
+
+void vuMeterMode7() // Styl 7: Okrągły analizator
+{
+  analyzerDrawLayout(7);
+}
+
+void vuMeterMode8() // Styl 8: Liniowy analizator
+{
+  analyzerDrawLayout(8);
 }
+
+void vuMeterMode9() // Styl 9: Spadające gwiazdki jak śnieg
+{
+  analyzerDrawLayout(9);
+}
+
+void vuMeterMode10() // Styl 10: Waterfall – historia pasm
+{
+  analyzerDrawLayout(10);
+}
+
+void vuMeterMode11() // Styl 11: Oscyloskop – min/max przebiegu na kolumnę
+{
+  analyzerDrawLayout(11);
+}
+
+void vuMeterMode12() // Styl 12: Lissajous X/Y (goniometr L/R)
+{
+  analyzerDrawLayout(12);
+}
+
 // 
 // FUNKCJE ZARZ�DZANIA PRESETAMI
 // 
@@ -1123,11 +1869,11 @@ void analyzerSetStyleMode(uint8_t styleMode) {
 }
 
 uint8_t analyzerGetMaxDisplayMode() {
-  return 9;
+  return 12;
 }
 
 bool analyzerIsStyleAvailable(uint8_t style) {
-  return (style >= 0 && style <= 9);
+  return (style >= 0 && style <= 12);
 }
 
 uint8_t analyzerGetAvailableStylesMode() {
@@ -28,6 +28,7 @@ struct AnalyzerStyleCfg {
   uint8_t availableStylesMode = ANALYZER_STYLES_0_4_5_6; // Które style są dostępne
   uint8_t currentPreset = PRESET_CLASSIC;                // Aktualny preset
   uint16_t peakHoldTimeMs = 200;                         // Czas zatrzymania peak na szczycie (ms) 50-2000
+  bool    grayscale = false;                             // style 5, 6, 8 w 16 odcieniach (wymaga SPI DMA)
   
   // ---- Styl 5 - Słupkowy ----
   uint8_t s5_barWidth = 10;     // szerokość słupka (px) 4-16
@@ -72,6 +73,20 @@ struct AnalyzerStyleCfg {
   bool    s9_filled = true;     // wypełnione środki gwiazdek czy tylko kontury
   uint8_t s9_centerSize = 4;    // minimalny rozmiar gwiazdek (px) 2-8
   uint8_t s9_smoothness = 30;   // wygładzanie ruchu (10-90)
+
+  // ---- Styl 11/12 - Oscyloskop i Lissajous X/Y (tap przebiegu) ----
+  uint8_t s11_timebase = 4;     // ramek audio na kolumnę (1-32); 4 ≈ 29 ms na ekran przy 44.1 kHz
+
+  // ---- Odświeżanie stylów 5-12 (governor klatek) ----
+  uint8_t s5_maxFps = 30;       // maksymalne FPS stylu 5..60
+  uint8_t s6_maxFps = 30;
+  uint8_t s7_maxFps = 25;
+  uint8_t s8_maxFps = 30;
+  uint8_t s9_maxFps = 30;
+  uint8_t s10_maxFps = 30;      // styl 10 (waterfall) – jedna kolumna historii na klatkę analizatora
+  uint8_t s11_maxFps = 30;      // styl 11 (oscyloskop)
+  uint8_t s12_maxFps = 30;      // styl 12 (Lissajous X/Y)
+  bool    fpsAdaptive = true;   // obniżaj FPS gdy bufor audio się opróżnia
 };
 
 AnalyzerStyleCfg analyzerGetStyle();
@@ -87,11 +102,52 @@ String analyzerStyleToJson();
 
 // Funkcje analizatora - style główne
 void eqAnalyzerSetFromWeb(bool enabled);
+// Style 5-12 rysują tylko do płótna (u8g2 albo płótno zadania OLED_Display)
+// – ramkę wysyła oledFlush() / zadanie renderujące
+class U8G2;
+void analyzerSetRenderTarget(U8G2* gfx);   // nullptr = globalne u8g2
+bool analyzerRenderStyle(uint8_t mode);    // narysuj styl 5-12; false dla innych trybów
+// to samo dla podglądu WWW: 1bpp, bez zmiany stanu stylów; cfg = niezapisane ustawienia (nullptr = bieżące)
+bool analyzerRenderPreview(uint8_t mode, const AnalyzerStyleCfg* cfg = nullptr);
+
+// Skala szarości (OLED_Gray): styl 5/6 – gasnący peak, styl 8 – gradient.
+// analyzerGrayWanted() mówi, czy tryb ją obsługuje i czy jest włączona;
+// analyzerSetGray() ustawia zadanie przed analyzerRenderStyle() – wtedy
+// styl składa klatkę w ramce 4bpp, a płótno 1bpp jest tylko jej podkładem.
+bool analyzerGrayWanted(uint8_t mode);
+void analyzerSetGray(bool on);
+
+// Governor klatek stylów 5-12: true = pora narysować klatkę. Pomija klatkę,
+// gdy minął za krótki czas (max FPS stylu, obniżane przy pustym buforze
+// audio) albo gdy analizator nic nie opublikował i stan się nie zmienił.
+struct OledFrameState;
+bool analyzerFrameDue(const OledFrameState& st);
+void analyzerFpsResetStats();
+String analyzerFpsToJson();                // dla /analyzerFps
+
+// Słupki stylu 5/6: drawBox() kontra zapis kolumn wprost w bufor (/analyzerBench)
+String analyzerBarsBenchToJson(uint8_t style, uint16_t frames);
+
+// Style 5-12 to układy widżetów (zegar, stacja, głośnik, słupki, ...);
+// czas rysowania każdego widżetu i trafienia cache tła – /analyzerProfile
+String analyzerProfileToJson();
+void analyzerProfileReset();
 void vuMeterMode5();
 void vuMeterMode6();
 void vuMeterMode7();  // Nowy styl: Okrągły
 void vuMeterMode8();  // Nowy styl: Liniowy
 void vuMeterMode9();  // Nowy styl: Spadające gwiazdki jak śnieg
+void vuMeterMode10(); // Waterfall: historia pasm przesuwana w lewo
+void vuMeterMode11(); // Oscyloskop: min/max przebiegu na kolumnę
+void vuMeterMode12(); // Lissajous X/Y (L/R)
+
+// Historia pasm (styl 10): ostatnie ANALYZER_WF_FRAMES klatek analizatora,
+// po jednym bajcie 0..100 na pasmo. Pierścień zapisują wszystkie style 5-10.
+// Snapshot kopiuje ją od najstarszej klatki (frames × EQ_BANDS bajtów) –
+// do /analyzerWaterfall. Kopiuje bez blokady i pomija klatki nadpisane w
+// trakcie kopii. Zwraca liczbę klatek; seq = klatki od startu.
+#define ANALYZER_WF_FRAMES 256
+uint16_t analyzerWaterfallSnapshot(uint8_t* out, size_t cap, uint32_t* seq);
 
 // Funkcje presetów i konfiguracji
 void analyzerApplyPreset(uint8_t presetId);
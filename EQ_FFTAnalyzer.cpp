@@ -40,6 +40,7 @@ static float g_ref_max = 8000.0f; // maksymalna referencja - wyższa dla głośn
 // Wygładzanie słupków i peak-hold
 static float g_levels[EQ_BANDS] = {0};
 static float g_peaks [EQ_BANDS] = {0};
+static volatile uint32_t g_publishSeq = 0;       // ++ przy każdej publikacji poziomów
 static uint32_t g_peak_timers[EQ_BANDS] = {0}; // timery peak hold w ms
 
 // Statystyka: czy naprawdę dostajemy próbki
@@ -55,6 +56,19 @@ static int16_t g_acc[FRAME_N];
 static uint16_t g_acc_n = 0;
 static uint8_t  g_ds_phase = 0;
 
+// Tap przebiegu (styl 11/12) – dwa bufory: hook pisze do (seq+1)&1,
+// wyświetlacz czyta seq&1. Numer nieparzysty/parzysty wskazuje bufor,
+// a zmiana numeru w trakcie kopiowania = odczyt do powtórzenia.
+static volatile bool     g_scopeActive = false;
+static volatile uint16_t g_scopeDecim  = 4;
+static eq_scope_frame_t  g_scope[2];
+static uint32_t g_scopeSeq  = 0;
+static uint16_t g_scopeCol  = 0;
+static uint16_t g_scopeN    = 0;
+static int16_t  g_scopeMin  = INT16_MAX;
+static int16_t  g_scopeMax  = INT16_MIN;
+static eq_scope_stats_t g_scopeStats = {};
+
 // ======================= GOERTZEL (tanie "FFT-like" na pasma) =======================
 
 static inline float clamp01(float x){ return (x < 0.f) ? 0.f : (x > 1.f ? 1.f : x); }
@@ -93,6 +107,135 @@ static float goertzel_mag(const int16_t* x, uint16_t n, float freq, float sr_eff
   return p; // bez sqrt – szybciej
 }
 
+// ======================= PRODUKTY: FFT 256 i bufory z numerem =======================
+
+typedef struct {
+  uint32_t seq;                        // nieparzysty = zapis w toku
+  uint16_t len;
+  uint8_t  data[EQ_PRODUCT_MAX_LEN];
+} product_buf_t;
+
+static product_buf_t g_prod[EQ_PRODUCTS];
+static const uint16_t kProductLen[EQ_PRODUCTS]   = { EQ_BANDS, 32, 64, FRAME_N / 2 };
+static const char*    kProductName[EQ_PRODUCTS]  = { "bands16", "bands32", "bands64", "spectrum" };
+static volatile uint32_t g_prodWantMs = 0;     // ostatni odczyt produktu FFT
+static const uint32_t PRODUCT_IDLE_MS = 5000;
+
+static float   g_fftWin[FRAME_N];
+static float   g_fftCos[FRAME_N / 2];
+static float   g_fftSin[FRAME_N / 2];
+static uint8_t g_fftRev[FRAME_N];
+static float   g_fftRe[FRAME_N];
+static float   g_fftIm[FRAME_N];
+static float   g_fftPow[FRAME_N / 2];
+static bool    g_fftReady = false;
+
+// Zakresy prążków pasm 32/64 – przeliczane przy zmianie SR_eff
+static uint8_t  g_bandLo[2][64];
+static uint8_t  g_bandHi[2][64];
+static uint32_t g_bandSr = 0;
+
+static void product_begin(uint8_t id){
+  __atomic_store_n(&g_prod[id].seq, g_prod[id].seq + 1, __ATOMIC_RELAXED);
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+}
+
+static void product_end(uint8_t id){
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+  __atomic_store_n(&g_prod[id].seq, g_prod[id].seq + 1, __ATOMIC_RELAXED);
+}
+
+static void fft_init(void){
+  for(uint16_t i=0;i<FRAME_N;i++){
+    g_fftWin[i] = 0.5f - 0.5f * cosf(2.0f * (float)M_PI * i / (FRAME_N - 1));
+    uint8_t r = 0;
+    for(uint8_t b=0;b<8;b++) if(i & (1u << b)) r |= (uint8_t)(0x80u >> b);   // FRAME_N = 2^8
+    g_fftRev[i] = r;
+  }
+  for(uint16_t k=0;k<FRAME_N/2;k++){
+    g_fftCos[k] = cosf(2.0f * (float)M_PI * k / FRAME_N);
+    g_fftSin[k] = sinf(2.0f * (float)M_PI * k / FRAME_N);
+  }
+  g_fftReady = true;
+}
+
+static void band_edges(uint32_t sr_eff){
+  const float binHz = (float)sr_eff / FRAME_N;
+  const float f0 = 40.0f, f1 = (float)sr_eff * 0.5f;
+  for(uint8_t v=0; v<2; v++){
+    const uint8_t n = v ? 64 : 32;
+    for(uint8_t k=0;k<n;k++){
+      const float lo = f0 * powf(f1 / f0, (float)k / n);
+      const float hi = f0 * powf(f1 / f0, (float)(k + 1) / n);
+      int bl = (int)(lo / binHz + 0.5f);
+      int bh = (int)(hi / binHz + 0.5f) - 1;
+      if(bl < 1) bl = 1;
+      if(bl > FRAME_N/2 - 1) bl = FRAME_N/2 - 1;
+      if(bh < bl) bh = bl;                        // nisko: kilka pasm na jednym prążku
+      if(bh > FRAME_N/2 - 1) bh = FRAME_N/2 - 1;
+      g_bandLo[v][k] = (uint8_t)bl;
+      g_bandHi[v][k] = (uint8_t)bh;
+    }
+  }
+  g_bandSr = sr_eff;
+}
+
+// moc prążka → uint8 dB względem pełnej skali (sinus 32767 z oknem Hanna)
+static inline uint8_t pow_to_u8db(float p){
+  static const float ref = (32768.0f * FRAME_N / 4) * (32768.0f * FRAME_N / 4);
+  if(p <= 0.0f) return 0;
+  float v = (10.0f * log10f(p / ref) - EQ_PRODUCT_DB_FLOOR) * 2.0f;
+  if(v < 0.0f) return 0;
+  if(v > 255.0f) return 255;
+  return (uint8_t)(v + 0.5f);
+}
+
+// Jedno FFT na ramkę → widmo, 64 i 32 pasma (max mocy prążków pasma)
+static void publish_fft_products(const int16_t* x){
+  if(!g_fftReady) fft_init();
+  if(g_bandSr != g_sr_eff) band_edges(g_sr_eff);
+
+  for(uint16_t i=0;i<FRAME_N;i++){
+    const uint8_t j = g_fftRev[i];
+    g_fftRe[j] = (float)x[i] * g_fftWin[i];
+    g_fftIm[j] = 0.0f;
+  }
+  for(uint16_t len=2; len<=FRAME_N; len<<=1){
+    const uint16_t half = len >> 1;
+    const uint16_t step = FRAME_N / len;
+    for(uint16_t i=0;i<FRAME_N;i+=len){
+      for(uint16_t k=0;k<half;k++){
+        const float wr =  g_fftCos[k * step];
+        const float wi = -g_fftSin[k * step];
+        const uint16_t a = i + k, b = a + half;
+        const float tr = g_fftRe[b] * wr - g_fftIm[b] * wi;
+        const float ti = g_fftRe[b] * wi + g_fftIm[b] * wr;
+        g_fftRe[b] = g_fftRe[a] - tr;
+        g_fftIm[b] = g_fftIm[a] - ti;
+        g_fftRe[a] += tr;
+        g_fftIm[a] += ti;
+      }
+    }
+  }
+  for(uint16_t k=0;k<FRAME_N/2;k++) g_fftPow[k] = g_fftRe[k]*g_fftRe[k] + g_fftIm[k]*g_fftIm[k];
+
+  product_begin(EQ_PRODUCT_SPECTRUM);
+  for(uint16_t k=0;k<FRAME_N/2;k++) g_prod[EQ_PRODUCT_SPECTRUM].data[k] = pow_to_u8db(g_fftPow[k]);
+  product_end(EQ_PRODUCT_SPECTRUM);
+
+  for(uint8_t v=0; v<2; v++){
+    const uint8_t id = v ? EQ_PRODUCT_BANDS64 : EQ_PRODUCT_BANDS32;
+    const uint8_t n  = v ? 64 : 32;
+    product_begin(id);
+    for(uint8_t k=0;k<n;k++){
+      float p = 0.0f;
+      for(uint8_t b=g_bandLo[v][k]; b<=g_bandHi[v][k]; b++) if(g_fftPow[b] > p) p = g_fftPow[b];
+      g_prod[id].data[k] = pow_to_u8db(p);
+    }
+    product_end(id);
+  }
+}
+
 // ======================= Mapowanie energii -> poziom (dynamika) =======================
 
 static float compress_level(float v){
@@ -188,7 +331,18 @@ static void analyzer_task(void*){
       if(pk < 0) pk = 0;
       g_peaks[b] = pk;
     }
+    g_publishSeq++;
     portEXIT_CRITICAL(&g_mux);
+
+    // 4) produkty: 16 pasm zawsze, FFT tylko gdy ktoś je czyta
+    product_begin(EQ_PRODUCT_BANDS16);
+    for(uint8_t b=0;b<EQ_BANDS;b++) g_prod[EQ_PRODUCT_BANDS16].data[b] = (uint8_t)(g_levels[b] * 255.0f + 0.5f);
+    product_end(EQ_PRODUCT_BANDS16);
+
+    const uint32_t want = g_prodWantMs;
+    if(want && (uint32_t)(esp_timer_get_time() / 1000ULL) - want < PRODUCT_IDLE_MS){
+      publish_fft_products(fr.s);
+    }
   }
 }
 
@@ -236,6 +390,7 @@ void eq_analyzer_reset(void){
     g_levels[i]=0;
     g_peaks[i]=0;
   }
+  g_publishSeq++;
   portEXIT_CRITICAL(&g_mux);
   g_ref = 1200.0f;
   g_lastPushUs = 0;
@@ -264,6 +419,7 @@ void eq_analyzer_set_runtime_active(bool active){
       g_levels[i] *= 0.7f;
       g_peaks[i]  *= 0.7f;
     }
+    g_publishSeq++;
     portEXIT_CRITICAL(&g_mux);
   }
 }
@@ -280,6 +436,84 @@ void eq_analyzer_set_sample_rate(uint32_t sample_rate_hz){
   g_sr_eff = sample_rate_hz / g_downsample;
 }
 
+// ======================= TAP PRZEBIEGU (hook audio) =======================
+
+// Na ramkę: średnia L/R, dwa porównania, licznik; zapis 4 bajtów raz na
+// kolumnę, publikacja (bariera + numer) raz na EQ_SCOPE_COLS kolumn.
+static void scope_tap(const int16_t* lr, uint32_t frames){
+  const uint16_t decim = g_scopeDecim;
+  eq_scope_frame_t* f = &g_scope[(g_scopeSeq + 1) & 1];
+  int16_t  mn  = g_scopeMin;
+  int16_t  mx  = g_scopeMax;
+  uint16_t n   = g_scopeN;
+  uint16_t col = g_scopeCol;
+
+  for(uint32_t i=0;i<frames;i++){
+    const int16_t L = lr[i*2 + 0];
+    const int16_t R = lr[i*2 + 1];
+    const int16_t m = (int16_t)(((int32_t)L + R) >> 1);
+    if(m < mn) mn = m;
+    if(m > mx) mx = m;
+    if(++n < decim) continue;
+
+    f->mn[col] = (int8_t)(mn >> 8);
+    f->mx[col] = (int8_t)(mx >> 8);
+    f->l[col]  = (int8_t)(L >> 8);
+    f->r[col]  = (int8_t)(R >> 8);
+    n  = 0;
+    mn = INT16_MAX;
+    mx = INT16_MIN;
+
+    if(++col == EQ_SCOPE_COLS){
+      f->framesPerCol = decim;
+      __atomic_thread_fence(__ATOMIC_RELEASE);          // dane przed numerem
+      __atomic_store_n(&g_scopeSeq, g_scopeSeq + 1, __ATOMIC_RELAXED);
+      __atomic_thread_fence(__ATOMIC_RELEASE);          // numer przed zapisem do drugiego bufora
+      g_scopeStats.published++;
+      f = &g_scope[(g_scopeSeq + 1) & 1];
+      col = 0;
+    }
+  }
+
+  g_scopeMin = mn;
+  g_scopeMax = mx;
+  g_scopeN   = n;
+  g_scopeCol = col;
+}
+
+void eq_scope_set_active(bool active){
+  g_scopeActive = active;
+}
+
+void eq_scope_set_decimation(uint16_t framesPerCol){
+  if(framesPerCol < 1) framesPerCol = 1;
+  if(framesPerCol > 64) framesPerCol = 64;
+  g_scopeDecim = framesPerCol;
+}
+
+uint32_t eq_scope_get_seq(void){
+  return __atomic_load_n(&g_scopeSeq, __ATOMIC_ACQUIRE);
+}
+
+bool eq_scope_snapshot(eq_scope_frame_t* out, uint32_t* seq){
+  for(uint8_t tries=0; tries<3; tries++){
+    const uint32_t s1 = __atomic_load_n(&g_scopeSeq, __ATOMIC_ACQUIRE);
+    if(s1 == 0) return false;
+    memcpy(out, &g_scope[s1 & 1], sizeof(*out));
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);            // kopia przed ponownym odczytem numeru
+    if(__atomic_load_n(&g_scopeSeq, __ATOMIC_RELAXED) == s1){
+      if(seq) *seq = s1;
+      return true;
+    }
+    g_scopeStats.torn++;
+  }
+  return false;
+}
+
+void eq_scope_get_stats(eq_scope_stats_t* out){
+  if(out) *out = g_scopeStats;
+}
+
 void eq_analyzer_push_samples_i16(const int16_t* interleavedLR, uint32_t frames){
   // UWAGA: ta funkcja leci z audio path – zero printów, zero malloc, zero heavy math.
   if(!g_enabled) return;
@@ -288,6 +522,14 @@ void eq_analyzer_push_samples_i16(const int16_t* interleavedLR, uint32_t frames)
   // jeśli nieaktywny runtime – też nie zbieramy (oszczędzamy RAM/CPU)
   if(!g_runtimeActive && !g_testGen) return;
 
+  // styl 11/12: min/max kolumn po stronie hooka (pełny SR, bez downsample)
+  if(g_scopeActive){
+    const uint32_t c0 = ESP.getCycleCount();
+    scope_tap(interleavedLR, frames);
+    g_scopeStats.cycles += ESP.getCycleCount() - c0;
+    g_scopeStats.frames += frames;
+  }
+
   // mono = (L+R)/2, downsample
   for(uint32_t i=0;i<frames;i++){
     if(g_downsample > 1){
@@ -335,6 +577,43 @@ void eq_get_analyzer_peaks(float out_peaks[EQ_BANDS]){
   portEXIT_CRITICAL(&g_mux);
 }
 
+uint16_t eq_analyzer_product_len(uint8_t id){
+  return (id < EQ_PRODUCTS) ? kProductLen[id] : 0;
+}
+
+const char* eq_analyzer_product_name(uint8_t id){
+  return (id < EQ_PRODUCTS) ? kProductName[id] : "";
+}
+
+uint16_t eq_analyzer_get_product(uint8_t id, uint8_t* out, uint16_t cap, uint32_t* seq){
+  if(id >= EQ_PRODUCTS || !out) return 0;
+  if(id != EQ_PRODUCT_BANDS16){
+    g_prodWantMs = (uint32_t)(esp_timer_get_time() / 1000ULL) | 1;   // zamówienie FFT na 5 s
+  }
+  const uint16_t len = (kProductLen[id] < cap) ? kProductLen[id] : cap;
+  const product_buf_t& p = g_prod[id];
+  for(uint8_t tries=0; tries<3; tries++){
+    const uint32_t s1 = __atomic_load_n(&p.seq, __ATOMIC_ACQUIRE);
+    if(s1 == 0) return 0;                                   // jeszcze nic nie opublikowano
+    if(s1 & 1) continue;
+    memcpy(out, p.data, len);
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    if(__atomic_load_n(&p.seq, __ATOMIC_RELAXED) == s1){
+      if(seq) *seq = s1 >> 1;
+      return len;
+    }
+  }
+  return 0;
+}
+
+uint32_t eq_analyzer_get_effective_rate(void){
+  return g_sr_eff;
+}
+
+uint32_t eq_analyzer_get_publish_seq(void){
+  return g_publishSeq;
+}
+
 bool eq_analyzer_is_receiving_samples(void){
   // czy w ostatniej 1.2s były próbki
   uint64_t now = (uint64_t)esp_timer_get_time();
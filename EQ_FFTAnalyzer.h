@@ -30,6 +30,34 @@ void  eq_analyzer_push_samples_i16(const int16_t* interleavedLR, uint32_t frames
 void  eq_get_analyzer_levels(float out_levels[EQ_BANDS]);
 void  eq_get_analyzer_peaks (float out_peaks [EQ_BANDS]);
 
+// Licznik publikacji poziomów – zmienia się tylko, gdy są nowe dane
+// (wyświetlacz może pominąć klatkę, jeśli licznik stoi)
+uint32_t eq_analyzer_get_publish_seq(void);
+
+// Produkty analizatora – kilka rozdzielczości z tej samej ramki próbek.
+// Każdy ma własny bufor z numerem (seqlock, jeden zapisujący – zadanie
+// analizatora), więc OLED i klienci WWW czytają niezależnie i nic nie
+// liczą. BANDS16 to poziomy stylów 5-12 (Goertzel + AGC) jako 0..255;
+// pozostałe pochodzą z jednego FFT 256 na ramkę (okno Hanna) w uint8 dB:
+// 0 = EQ_PRODUCT_DB_FLOOR, krok 0.5 dB, 255 = 0 dBFS. FFT liczone jest
+// tylko, gdy ktoś czytał produkt FFT w ostatnich 5 s.
+typedef enum {
+  EQ_PRODUCT_BANDS16 = 0,
+  EQ_PRODUCT_BANDS32,       // pasma logarytmiczne 40 Hz .. SR_eff/2
+  EQ_PRODUCT_BANDS64,
+  EQ_PRODUCT_SPECTRUM,      // 128 prążków po SR_eff/256 Hz
+  EQ_PRODUCTS
+} eq_product_id_t;
+
+#define EQ_PRODUCT_MAX_LEN  128
+#define EQ_PRODUCT_DB_FLOOR (-127.5f)
+
+uint16_t    eq_analyzer_product_len(uint8_t id);
+const char* eq_analyzer_product_name(uint8_t id);
+// Kopia produktu; zwraca liczbę bajtów (0 = brak danych / zły id), seq = numer klatki
+uint16_t    eq_analyzer_get_product(uint8_t id, uint8_t* out, uint16_t cap, uint32_t* seq);
+uint32_t    eq_analyzer_get_effective_rate(void);   // SR po downsample [Hz]
+
 // Diagnostyka (opcjonalnie – NIE włączać stale przy streamie FLAC/AAC)
 bool  eq_analyzer_is_receiving_samples(void);
 void  eq_analyzer_print_diagnostics(void);
@@ -37,6 +65,35 @@ void  eq_analyzer_print_diagnostics(void);
 // Generator testowy (opcjonalnie)
 void  eq_analyzer_enable_test_generator(bool en);
 
+// Podgląd przebiegu dla stylu 11 (oscyloskop) i 12 (Lissajous X/Y).
+// Hook audio składa migawkę sam: na kolumnę min/max mono z framesPerCol
+// ramek i jedną parę L/R (ostatnia ramka kolumny), wartości >> 8.
+// Gotowa migawka jest publikowana zmianą numeru (dwa bufory + seqlock),
+// więc wyświetlacz kopiuje ~1.3 KB bez blokad i bez dotykania PCM.
+#define EQ_SCOPE_COLS 320   // 256 kolumn ekranu + zapas na wyzwalanie
+
+typedef struct {
+  int8_t   mn[EQ_SCOPE_COLS];
+  int8_t   mx[EQ_SCOPE_COLS];
+  int8_t   l [EQ_SCOPE_COLS];
+  int8_t   r [EQ_SCOPE_COLS];
+  uint16_t framesPerCol;
+} eq_scope_frame_t;
+
+typedef struct {
+  uint32_t published;    // opublikowane migawki
+  uint32_t torn;         // odczyty powtórzone (hook publikował w trakcie kopiowania)
+  uint32_t frames;       // ramki stereo przepuszczone przez tap
+  uint64_t cycles;       // cykle CPU tapu w hooku audio (łącznie)
+} eq_scope_stats_t;
+
+void  eq_scope_set_active(bool active);            // tap działa tylko dla stylów 11/12
+void  eq_scope_set_decimation(uint16_t framesPerCol);
+uint32_t eq_scope_get_seq(void);                   // rośnie z każdą migawką
+// false = brak migawki albo hook publikował przy każdej z prób
+bool  eq_scope_snapshot(eq_scope_frame_t* out, uint32_t* seq);
+void  eq_scope_get_stats(eq_scope_stats_t* out);
+
 #ifdef __cplusplus
 } // extern "C"
 #endif
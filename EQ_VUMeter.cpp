@@ -0,0 +1,256 @@
+#include "EQ_VUMeter.h"
+#include <math.h>
+#include <string.h>
+
+// ======================= USTAWIENIA =======================
+
+static const float VU_TAU_S        = 0.300f / 4.605f;   // 99% po 300 ms: tau = 300 ms / ln(100)
+static const float PPM_FALL_DB_S   = 20.0f / 1.7f;      // IEC 60268-10 typ I
+static const uint32_t VU_STALE_MS  = 500;
+
+// True-peak: 4 fazy po 12 tapów (okno Blackmana na sinc, cięcie na fs/2)
+#define TP_PHASES 4
+#define TP_TAPS   12
+
+static float g_tpCoef[TP_PHASES][TP_TAPS];
+static bool  g_tpCoefReady = false;
+static float g_tpHist[2][2 * TP_TAPS];   // historia podwójna – okno zawsze ciągłe
+static uint8_t g_tpPos = 0;
+
+static volatile bool     g_truePeak = false;
+static volatile bool     g_resetReq = false;
+static volatile uint32_t g_sr_hz    = 44100;
+
+// Stan balistyki (tylko hook audio)
+static float    g_vuLin[2]  = {0, 0};
+static float    g_ppmDb[2]  = {EQ_VU_FLOOR_DB, EQ_VU_FLOOR_DB};
+static uint32_t g_clips[2]  = {0, 0};
+static uint32_t g_blocks    = 0;
+
+// Publikacja: numer nieparzysty = zapis w toku
+static eq_vu_snapshot_t g_pub = {};
+static uint32_t g_seq = 0;
+
+// Stan zadany z /displayScript – ten sam seqlock, jedyny zapisujący to handler WWW
+static eq_vu_snapshot_t g_script = {};
+static uint32_t g_scriptSeq = 0;
+static volatile bool g_scriptOn = false;
+
+// ======================= POMOCNICZE =======================
+
+static inline float lin_to_db(float v){
+  if(v <= 0.0f) return EQ_VU_FLOOR_DB;
+  float db = 20.0f * log10f(v);
+  return (db < EQ_VU_FLOOR_DB) ? EQ_VU_FLOOR_DB : db;
+}
+
+static inline uint8_t db_to_bar(float db){
+  if(db <= EQ_VU_BAR_DB) return 0;
+  if(db >= 0.0f) return 255;
+  return (uint8_t)((db - EQ_VU_BAR_DB) * 255.0f / -EQ_VU_BAR_DB + 0.5f);
+}
+
+// Skala wskazówki trybu 4: -20, -10, -5, 0, +3, +6, +9 VU co 1/6 łuku
+static uint8_t db_to_needle(float db){
+  static const float kVu[7] = { -20.0f, -10.0f, -5.0f, 0.0f, 3.0f, 6.0f, 9.0f };
+  const float vu = db - EQ_VU_REF_DBFS;
+  if(vu <= kVu[0]) return 0;
+  if(vu >= kVu[6]) return 100;
+  uint8_t i = 0;
+  while(vu > kVu[i + 1]) i++;
+  const float pos = (float)i + (vu - kVu[i]) / (kVu[i + 1] - kVu[i]);
+  return (uint8_t)(pos * 100.0f / 6.0f + 0.5f);
+}
+
+static void tp_init_coefs(void){
+  const int N = TP_PHASES * TP_TAPS;
+  const float c = 0.5f * (float)(N - 1);
+  for(int p=0;p<TP_PHASES;p++){
+    float sum = 0.0f;
+    for(int k=0;k<TP_TAPS;k++){
+      const int n = k * TP_PHASES + p;
+      const float t = ((float)n - c) / (float)TP_PHASES;
+      const float sinc = (fabsf(t) < 1e-6f) ? 1.0f : sinf((float)M_PI * t) / ((float)M_PI * t);
+      const float w = 0.42f - 0.5f * cosf(2.0f * (float)M_PI * n / (N - 1)) + 0.08f * cosf(4.0f * (float)M_PI * n / (N - 1));
+      g_tpCoef[p][k] = sinc * w;
+      sum += g_tpCoef[p][k];
+    }
+    for(int k=0;k<TP_TAPS;k++) g_tpCoef[p][k] /= sum;   // każda faza z zyskiem 1 dla DC
+  }
+  g_tpCoefReady = true;
+}
+
+static void publish(const float rms[2], const float peak[2], const float tp[2]){
+  const uint32_t s = g_seq;
+  __atomic_store_n(&g_seq, s + 1, __ATOMIC_RELAXED);
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+
+  for(uint8_t ch=0; ch<2; ch++){
+    const float vuDb = lin_to_db(g_vuLin[ch]);
+    g_pub.rmsDb[ch]      = lin_to_db(rms[ch]);
+    g_pub.vuDb[ch]       = vuDb;
+    g_pub.peakDb[ch]     = lin_to_db(peak[ch]);
+    g_pub.truePeakDb[ch] = lin_to_db(tp[ch]);
+    g_pub.ppmDb[ch]      = g_ppmDb[ch];
+    g_pub.bar[ch]        = db_to_bar(vuDb);
+    g_pub.barPeak[ch]    = db_to_bar(g_ppmDb[ch]);
+    g_pub.needle[ch]     = db_to_needle(vuDb);
+    g_pub.clips[ch]      = g_clips[ch];
+  }
+  g_pub.blocks    = g_blocks;
+  g_pub.updatedMs = millis();
+  g_pub.truePeak  = g_truePeak;
+
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+  __atomic_store_n(&g_seq, s + 2, __ATOMIC_RELAXED);
+}
+
+// ======================= HOOK AUDIO =======================
+
+void eq_vu_push_samples_i16(const int16_t* interleavedLR, uint32_t frames){
+  // UWAGA: ścieżka audio – zero printów, zero malloc
+  if(!interleavedLR || frames == 0) return;
+
+  if(g_resetReq){
+    g_resetReq = false;
+    g_vuLin[0] = g_vuLin[1] = 0.0f;
+    g_ppmDb[0] = g_ppmDb[1] = EQ_VU_FLOOR_DB;
+    g_clips[0] = g_clips[1] = 0;
+    memset(g_tpHist, 0, sizeof(g_tpHist));
+  }
+
+  // 1) suma kwadratów i sample-peak – na int32/int64, bez float w pętli
+  uint64_t sq[2]  = {0, 0};
+  int32_t  pk[2]  = {0, 0};
+  for(uint32_t i=0;i<frames;i++){
+    const int32_t L = interleavedLR[i*2 + 0];
+    const int32_t R = interleavedLR[i*2 + 1];
+    sq[0] += (uint64_t)(L * L);
+    sq[1] += (uint64_t)(R * R);
+    const int32_t aL = (L < 0) ? -L : L;
+    const int32_t aR = (R < 0) ? -R : R;
+    if(aL > pk[0]) pk[0] = aL;
+    if(aR > pk[1]) pk[1] = aR;
+  }
+
+  const float fs = 1.0f / 32768.0f;
+  float rms[2], peak[2], tp[2];
+  for(uint8_t ch=0; ch<2; ch++){
+    rms[ch]  = sqrtf((float)sq[ch] / (float)frames) * fs;
+    peak[ch] = (float)pk[ch] * fs;
+    tp[ch]   = peak[ch];
+    if(pk[ch] >= 32767) g_clips[ch]++;
+  }
+
+  // 2) true-peak – filtr polifazowy na historii 12 próbek
+  if(g_truePeak){
+    if(!g_tpCoefReady) tp_init_coefs();
+    for(uint32_t i=0;i<frames;i++){
+      const float L = (float)interleavedLR[i*2 + 0] * fs;
+      const float R = (float)interleavedLR[i*2 + 1] * fs;
+      g_tpHist[0][g_tpPos] = g_tpHist[0][g_tpPos + TP_TAPS] = L;
+      g_tpHist[1][g_tpPos] = g_tpHist[1][g_tpPos + TP_TAPS] = R;
+      if(++g_tpPos == TP_TAPS) g_tpPos = 0;
+
+      // okno [pos, pos+TAPS): najstarsza → najnowsza
+      const float* hL = &g_tpHist[0][g_tpPos];
+      const float* hR = &g_tpHist[1][g_tpPos];
+      for(uint8_t p=0; p<TP_PHASES; p++){
+        const float* c = g_tpCoef[p];
+        float yL = 0.0f, yR = 0.0f;
+        for(uint8_t k=0; k<TP_TAPS; k++){
+          yL += c[k] * hL[TP_TAPS - 1 - k];
+          yR += c[k] * hR[TP_TAPS - 1 - k];
+        }
+        yL = fabsf(yL);
+        yR = fabsf(yR);
+        if(yL > tp[0]) tp[0] = yL;
+        if(yR > tp[1]) tp[1] = yR;
+      }
+    }
+  }
+
+  // 3) balistyka – raz na blok, krok = czas trwania bloku
+  const uint32_t sr = g_sr_hz;
+  const float dt = (float)frames / (float)(sr ? sr : 44100);
+  const float a = 1.0f - expf(-dt / VU_TAU_S);
+  for(uint8_t ch=0; ch<2; ch++){
+    g_vuLin[ch] += a * (rms[ch] - g_vuLin[ch]);
+
+    const float nowDb = lin_to_db(tp[ch]);
+    const float fall  = g_ppmDb[ch] - PPM_FALL_DB_S * dt;
+    g_ppmDb[ch] = (nowDb > fall) ? nowDb : (fall < EQ_VU_FLOOR_DB ? EQ_VU_FLOOR_DB : fall);
+  }
+  g_blocks++;
+
+  publish(rms, peak, tp);
+}
+
+// ======================= API =======================
+
+void eq_vu_set_sample_rate(uint32_t sample_rate_hz){
+  if(sample_rate_hz < 8000) sample_rate_hz = 8000;
+  g_sr_hz = sample_rate_hz;
+}
+
+void eq_vu_set_true_peak(bool en){
+  g_truePeak = en;
+}
+
+bool eq_vu_get_true_peak(void){
+  return g_truePeak;
+}
+
+bool eq_vu_get(eq_vu_snapshot_t* out){
+  if(!out) return false;
+  if(g_scriptOn){
+    for(uint8_t tries=0; tries<4; tries++){
+      const uint32_t s1 = __atomic_load_n(&g_scriptSeq, __ATOMIC_ACQUIRE);
+      if(s1 & 1) continue;
+      memcpy(out, &g_script, sizeof(*out));
+      __atomic_thread_fence(__ATOMIC_ACQUIRE);
+      if(__atomic_load_n(&g_scriptSeq, __ATOMIC_RELAXED) == s1){
+        out->updatedMs = millis();
+        return true;
+      }
+    }
+    return false;
+  }
+  for(uint8_t tries=0; tries<4; tries++){
+    const uint32_t s1 = __atomic_load_n(&g_seq, __ATOMIC_ACQUIRE);
+    if(s1 & 1) continue;                                 // hook właśnie publikuje
+    memcpy(out, &g_pub, sizeof(*out));
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    if(__atomic_load_n(&g_seq, __ATOMIC_RELAXED) == s1){
+      return (s1 != 0) && (millis() - out->updatedMs < VU_STALE_MS);
+    }
+  }
+  return false;
+}
+
+void eq_vu_set_script(bool on, float vuDbL, float vuDbR, float ppmDbL, float ppmDbR){
+  if(!on){ g_scriptOn = false; return; }
+  const float vu[2]  = { vuDbL, vuDbR };
+  const float ppm[2] = { ppmDbL, ppmDbR };
+  __atomic_store_n(&g_scriptSeq, g_scriptSeq + 1, __ATOMIC_RELAXED);
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+  memset(&g_script, 0, sizeof(g_script));
+  for(uint8_t ch=0; ch<2; ch++){
+    g_script.rmsDb[ch]      = vu[ch];
+    g_script.vuDb[ch]       = vu[ch];
+    g_script.peakDb[ch]     = ppm[ch];
+    g_script.truePeakDb[ch] = ppm[ch];
+    g_script.ppmDb[ch]      = ppm[ch];
+    g_script.bar[ch]        = db_to_bar(vu[ch]);
+    g_script.barPeak[ch]    = db_to_bar(ppm[ch]);
+    g_script.needle[ch]     = db_to_needle(vu[ch]);
+  }
+  g_script.blocks = 1;
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+  __atomic_store_n(&g_scriptSeq, g_scriptSeq + 1, __ATOMIC_RELAXED);
+  g_scriptOn = true;
+}
+
+void eq_vu_reset(void){
+  g_resetReq = true;   // wykona hook – stan balistyki należy do niego
+}
@@ -0,0 +1,56 @@
+#pragma once
+#include <Arduino.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Mierniki VU/PPM liczone w hooku audio (audio_process_i2s), nie w UI.
+// Na każdy blok PCM: RMS i sample-peak na kanał, opcjonalnie true-peak
+// (nadpróbkowanie 4×, FIR polifazowy 4 × 12 tapów – układ z BS.1770), a na nich
+// balistyka: VU – całkowanie 300 ms (99% wartości po 300 ms), PPM –
+// natychmiastowy wzrost, opadanie 20 dB / 1.7 s (IEC 60268-10 typ I).
+// Wynik razem z gotowymi pozycjami wskaźników publikowany jest przez
+// seqlock – tryby 0/3/4 tylko go czytają, bez liczenia co klatkę.
+
+#ifndef EQ_VU_FLOOR_DB
+#define EQ_VU_FLOOR_DB   (-90.0f)   // cisza
+#endif
+#define EQ_VU_BAR_DB     (-48.0f)   // dolny koniec słupka (bar = 0)
+#define EQ_VU_REF_DBFS   (-18.0f)   // 0 VU = -18 dBFS (EBU R68)
+
+typedef struct {
+  float    rmsDb[2];        // RMS ostatniego bloku [dBFS]
+  float    vuDb[2];         // RMS z balistyką VU [dBFS]
+  float    peakDb[2];       // sample-peak ostatniego bloku [dBFS]
+  float    truePeakDb[2];   // true-peak ostatniego bloku [dBTP] (= peakDb gdy wyłączony)
+  float    ppmDb[2];        // max(peak, true-peak) z balistyką PPM [dBFS]
+  uint8_t  bar[2];          // vuDb  → 0..255 (EQ_VU_BAR_DB..0 dBFS) – słupki trybu 0/3
+  uint8_t  barPeak[2];      // ppmDb → 0..255 w tej samej skali
+  uint8_t  needle[2];       // vuDb  → 0..100 na skali -20..+9 VU trybu 4
+  uint32_t clips[2];        // bloki z próbką na pełnej skali
+  uint32_t blocks;          // bloki od startu
+  uint32_t updatedMs;       // millis() ostatniego bloku
+  bool     truePeak;        // czy true-peak był liczony
+} eq_vu_snapshot_t;
+
+// Hook na próbki (validSamples = ramki stereo) – lekki, bez alokacji
+void  eq_vu_push_samples_i16(const int16_t* interleavedLR, uint32_t frames);
+void  eq_vu_set_sample_rate(uint32_t sample_rate_hz);
+void  eq_vu_set_true_peak(bool en);      // +96 MAC na ramkę; domyślnie wyłączony
+bool  eq_vu_get_true_peak(void);
+
+// false = hook nie dostarczył bloku od 500 ms (out i tak wypełnione)
+bool  eq_vu_get(eq_vu_snapshot_t* out);
+void  eq_vu_reset(void);
+
+// Stan zadany (/displayScript, testy zrzutów ekranu): dopóki on, eq_vu_get()
+// oddaje te poziomy [dBFS] ze wskaźnikami liczonymi jak z pomiaru; on = false
+// wraca do hooka
+void  eq_vu_set_script(bool on, float vuDbL, float vuDbR, float ppmDbL, float ppmDbR);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
@@ -0,0 +1,60 @@
+#include "OLED_BgCache.h"
+
+#include <U8g2lib.h>
+#include <string.h>
+#include "esp_heap_caps.h"
+
+static const uint16_t OLED_BG_BYTES = 256 * 64 / 8;
+
+struct OledBgEntry {
+  uint8_t* buf;
+  uint32_t key;
+  bool     valid;
+};
+
+static OledBgEntry oledBg[OLED_BG_SLOTS] = {};
+
+uint32_t oledBgHash(uint32_t h, const void* data, size_t len)
+{
+  const uint8_t* p = (const uint8_t*)data;
+  for (size_t i = 0; i < len; i++)
+  {
+    h ^= p[i];
+    h *= 16777619UL;
+  }
+  return h;
+}
+
+bool oledBgBlit(U8G2& gfx, uint8_t slot, uint32_t key)
+{
+#if ENABLE_OLED_BG_CACHE
+  if (slot >= OLED_BG_SLOTS) return false;
+  OledBgEntry& e = oledBg[slot];
+  if (!e.valid || e.key != key) return false;
+  memcpy(gfx.getBufferPtr(), e.buf, OLED_BG_BYTES);
+  return true;
+#else
+  (void)gfx; (void)slot; (void)key;
+  return false;
+#endif
+}
+
+void oledBgStore(U8G2& gfx, uint8_t slot, uint32_t key)
+{
+#if ENABLE_OLED_BG_CACHE
+  if (slot >= OLED_BG_SLOTS) return;
+  OledBgEntry& e = oledBg[slot];
+  if (!e.buf)
+  {
+    // memcpy co klatkę – bufor w wewnętrznym RAM, PSRAM tylko awaryjnie
+    e.buf = (uint8_t*)heap_caps_malloc(OLED_BG_BYTES, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if (!e.buf) e.buf = (uint8_t*)ps_malloc(OLED_BG_BYTES);
+    if (!e.buf) return;
+  }
+  memcpy(e.buf, gfx.getBufferPtr(), OLED_BG_BYTES);
+  e.key   = key;
+  e.valid = true;
+#else
+  (void)gfx; (void)slot; (void)key;
+#endif
+}
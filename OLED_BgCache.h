@@ -0,0 +1,28 @@
+#pragma once
+#include <Arduino.h>
+
+// Cache statycznego tła ekranu (pełny bufor u8g2 1bpp, 2 KB na slot).
+// Styl rysuje warstwę statyczną raz, zapisuje ją oledBgStore(), a w
+// kolejnych klatkach oledBgBlit() kopiuje ją memcpy do bufora i rysuje
+// tylko elementy ruchome. Klucz opisuje treść tła (układ, konfiguracja,
+// teksty) – inny klucz = tło rysowane od nowa.
+
+#ifndef ENABLE_OLED_BG_CACHE
+#define ENABLE_OLED_BG_CACHE 1
+#endif
+
+class U8G2;
+
+enum OledBgSlot : uint8_t {
+  OLED_BG_MODE4 = 0,     // vuMeterMode4: ramki, skale, opisy dB
+  OLED_BG_MODE5,         // styl 5: pasek zegar/stacja/głośnik
+  OLED_BG_MODE6,         // styl 6: jw.
+  OLED_BG_SLOTS
+};
+
+// FNV-1a – do budowania kluczy tła
+static const uint32_t OLED_BG_HASH_INIT = 2166136261UL;
+uint32_t oledBgHash(uint32_t h, const void* data, size_t len);
+
+bool oledBgBlit(U8G2& gfx, uint8_t slot, uint32_t key);    // true = tło skopiowane
+void oledBgStore(U8G2& gfx, uint8_t slot, uint32_t key);   // zapamiętaj bieżący bufor jako tło
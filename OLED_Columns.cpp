@@ -0,0 +1,120 @@
+#include "OLED_Columns.h"
+
+#include <U8g2lib.h>
+#include <string.h>
+
+static const uint16_t OLED_COL_ROW_BYTES = 256;
+
+bool oledColumnsBegin(U8G2& gfx, OledColumns& c)
+{
+  c.buf  = nullptr;
+  c.flip = false;
+#if ENABLE_OLED_COLUMNS
+  u8g2_t* g = gfx.getU8g2();
+  if (gfx.getBufferTileWidth() != 32 || gfx.getBufferTileHeight() != 8) return false;
+  if (g->cb == U8G2_R0)      c.flip = false;
+  else if (g->cb == U8G2_R2) c.flip = true;
+  else return false;
+  c.buf = gfx.getBufferPtr();
+  return c.buf != nullptr;
+#else
+  (void)gfx;
+  return false;
+#endif
+}
+
+void oledColumnsDraw(const OledColumns& c, int16_t x, uint8_t w, uint64_t mask)
+{
+  int16_t x0 = x;
+  int16_t x1 = x + w - 1;
+  if (x0 < 0) x0 = 0;
+  if (x1 > 255) x1 = 255;
+  if (x0 > x1 || mask == 0) return;
+
+  if (c.flip)
+  {
+    int16_t t = 255 - x1;
+    x1 = 255 - x0;
+    x0 = t;
+  }
+  const uint16_t n = x1 - x0 + 1;
+
+  uint8_t* row = c.buf + x0;
+  for (uint8_t ty = 0; ty < 8; ty++, row += OLED_COL_ROW_BYTES, mask >>= 8)
+  {
+    const uint8_t b = (uint8_t)mask;
+    if (!b) continue;
+    for (uint16_t k = 0; k < n; k++) row[k] |= b;
+  }
+}
+
+void oledColumnsPut(const OledColumns& c, int16_t x, uint64_t mask)
+{
+  if (x < 0 || x > 255) return;
+  uint8_t* p = c.buf + (c.flip ? 255 - x : x);
+  for (uint8_t ty = 0; ty < 8; ty++, p += OLED_COL_ROW_BYTES, mask >>= 8) *p = (uint8_t)mask;
+}
+
+void oledColumnsShift(const OledColumns& c, uint8_t n)
+{
+  uint8_t* row = c.buf;
+  for (uint8_t ty = 0; ty < 8; ty++, row += OLED_COL_ROW_BYTES)
+  {
+    // w U8G2_R2 lewo na ekranie = prawo w buforze
+    if (c.flip)
+    {
+      memmove(row + n, row, OLED_COL_ROW_BYTES - n);
+      memset(row, 0, n);
+    }
+    else
+    {
+      memmove(row, row + n, OLED_COL_ROW_BYTES - n);
+      memset(row + OLED_COL_ROW_BYTES - n, 0, n);
+    }
+  }
+}
+
+void oledSpriteFinish(OledSprite& s)
+{
+  if (s.w > 32) s.w = 32;
+  for (uint8_t i = 0; i < s.w; i++)
+  {
+    uint32_t m = s.col[i];
+    m = ((m >> 1) & 0x55555555UL) | ((m & 0x55555555UL) << 1);
+    m = ((m >> 2) & 0x33333333UL) | ((m & 0x33333333UL) << 2);
+    m = ((m >> 4) & 0x0F0F0F0FUL) | ((m & 0x0F0F0F0FUL) << 4);
+    s.rev[i] = __builtin_bswap32(m);
+  }
+}
+
+void oledColumnsBlit(const OledColumns& c, int16_t x, int16_t y, const OledSprite& s)
+{
+  if (y >= 64 || y + s.h <= 0 || s.h > 32) return;   // dalej przesunięcia mieszczą się w 0..63
+
+  for (uint8_t i = 0; i < s.w; i++)
+  {
+    int16_t  sx = x + i;
+    if (sx < 0 || sx > 255) continue;
+    uint64_t m;
+    if (!c.flip)
+    {
+      m = s.col[i];
+      m = (y >= 0) ? (m << y) : (m >> -y);
+    }
+    else
+    {
+      // wiersz ekranu y+j → bit 63-y-j bufora; rev ma wiersz j na bicie 31-j
+      const int16_t sh = 32 - y;
+      m  = s.rev[i];
+      m  = (sh >= 0) ? (m << sh) : (m >> -sh);
+      sx = 255 - sx;
+    }
+
+    uint8_t* p = c.buf + sx;
+    for (uint8_t ty = 0; ty < 8 && m; ty++, p += OLED_COL_ROW_BYTES, m >>= 8)
+    {
+      const uint8_t b = (uint8_t)m;
+      if (b) *p |= b;
+    }
+  }
+}
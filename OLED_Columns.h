@@ -0,0 +1,62 @@
+#pragma once
+#include <Arduino.h>
+
+// Rysowanie pionowych kolumn (słupki analizatora) prosto w bufor u8g2.
+// Kolumna opisana jest 64-bitową maską wierszy ekranu (bit = wiersz
+// w układzie bufora), więc cały słupek razem z segmentami i peakiem to
+// najwyżej 8 bajtów na kolumnę pikseli zamiast dziesiątek drawBox().
+// Obsługuje pełny bufor 256x64 w rotacji U8G2_R0 i U8G2_R2 – dla innych
+// oledColumnsBegin() zwraca false i styl rysuje po staremu.
+
+#ifndef ENABLE_OLED_COLUMNS
+#define ENABLE_OLED_COLUMNS 1   // 0 = słupki zawsze przez drawBox()
+#endif
+
+class U8G2;
+
+struct OledColumns {
+  uint8_t* buf;    // bufor u8g2 (8 wierszy kafelków po 256 bajtów)
+  bool     flip;   // U8G2_R2: x → 255-x, y → 63-y
+};
+
+bool oledColumnsBegin(U8G2& gfx, OledColumns& c);
+
+// Odwrócenie kolejności bitów maski (y → 63-y)
+static inline uint64_t oledColumnsRev64(uint64_t m)
+{
+  m = ((m >> 1) & 0x5555555555555555ULL) | ((m & 0x5555555555555555ULL) << 1);
+  m = ((m >> 2) & 0x3333333333333333ULL) | ((m & 0x3333333333333333ULL) << 2);
+  m = ((m >> 4) & 0x0F0F0F0F0F0F0F0FULL) | ((m & 0x0F0F0F0F0F0F0F0FULL) << 4);
+  return __builtin_bswap64(m);
+}
+
+// Maska wierszy yTop..yBottom (współrzędne ekranu, przycinane do 0..63)
+static inline uint64_t oledColumnsSpan(const OledColumns& c, int16_t yTop, int16_t yBottom)
+{
+  if (yTop < 0) yTop = 0;
+  if (yBottom > 63) yBottom = 63;
+  if (yTop > yBottom) return 0;
+  uint64_t m = (~0ULL >> (63 - (yBottom - yTop))) << yTop;   // bity yTop..yBottom
+  return c.flip ? oledColumnsRev64(m) : m;
+}
+
+// OR maski w kolumny x..x+w-1 (przycinane do ekranu)
+void oledColumnsDraw(const OledColumns& c, int16_t x, uint8_t w, uint64_t mask);
+// Zastąp całą kolumnę x maską (układ bufora, jak z oledColumnsSpan)
+void oledColumnsPut(const OledColumns& c, int16_t x, uint64_t mask);
+// Przesuń obraz o n kolumn w lewo (na ekranie); z prawej n pustych kolumn
+void oledColumnsShift(const OledColumns& c, uint8_t n);
+
+// Sprite do 32x32 zapisany kolumnami: bit j = wiersz j od góry sprite'a.
+// rev to te same kolumny z odwróconą kolejnością bitów (bufor w U8G2_R2) –
+// liczy je oledSpriteFinish() po wypełnieniu col.
+struct OledSprite {
+  uint8_t  w;
+  uint8_t  h;
+  uint32_t col[32];
+  uint32_t rev[32];
+};
+
+void oledSpriteFinish(OledSprite& s);
+// OR sprite'a z lewym górnym rogiem w (x, y) – przycinane do ekranu
+void oledColumnsBlit(const OledColumns& c, int16_t x, int16_t y, const OledSprite& s);
@@ -0,0 +1,525 @@
+#include "OLED_Display.h"
+#include "EQ_AnalyzerDisplay.h"   // analyzerSetRenderTarget(), analyzerRenderStyle(), analyzerRenderPreview()
+#include "OLED_SpiDma.h"
+#include "OLED_Gray.h"
+
+#include <U8g2lib.h>
+#include <string.h>
+#include <atomic>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_heap_caps.h"
+
+extern U8G2_SSD1322_NHD_256X64_F_4W_HW_SPI u8g2;
+
+// ─────────────────────────────────────
+// Geometria bufora (SSD1322 256x64, pełny bufor u8g2)
+// ─────────────────────────────────────
+// Bufor u8g2 to 8 wierszy kafelków po 32 kafelki; kafelek = 8 bajtów
+// (8 kolumn po 8 pikseli w pionie). Rotacja U8G2_R2 jest już zrobiona
+// przy rysowaniu, więc bufor i kafelki są w układzie natywnym panelu.
+static const uint8_t  OLED_TILE_COLS  = 32;
+static const uint8_t  OLED_TILE_ROWS  = 8;
+static const uint16_t OLED_ROW_BYTES  = OLED_TILE_COLS * 8;
+static const uint16_t OLED_BUF_BYTES  = OLED_ROW_BYTES * OLED_TILE_ROWS;
+static const uint16_t OLED_TILES      = OLED_TILE_COLS * OLED_TILE_ROWS;
+
+// Powyżej tylu zmienionych kafelków taniej jest wysłać całość jednym wywołaniem
+static const uint16_t OLED_FULL_THRESHOLD = (OLED_TILES * 3) / 4;
+
+static uint8_t oledShadow[OLED_BUF_BYTES];   // ostatnio wysłana ramka
+static bool    oledShadowValid = false;      // false = wyślij całość
+static std::atomic<bool> oledInvalidReq(false);
+
+static OledStats oledStats = {};
+
+static void oledStatsAdd(uint32_t us, uint16_t tiles)
+{
+  oledStats.frames++;
+  oledStats.tilesSent  += tiles;
+  oledStats.tilesTotal += OLED_TILES;
+  oledStats.lastUs = us;
+  oledStats.avgUs  = (oledStats.frames == 1) ? us : (oledStats.avgUs * 15 + us) / 16;
+  if (us > oledStats.maxUs) oledStats.maxUs = us;
+}
+
+void oledInvalidate()
+{
+  oledInvalidReq.store(true);
+}
+
+// Wysłanie jednego wiersza kafelków prosto przez u8x8 – to samo co robi
+// u8g2.updateDisplayArea(), ale z dowolnego bufora, nie tylko z bufora u8g2.
+// setContrast()/setPowerSave() z loop() mogą iść w tym samym czasie: każdy
+// transfer u8x8 to jedna transakcja SPIClass (własna blokada) albo, z
+// OLED_SpiDma, jest pod jego mutexem magistrali. Z DMA okno idzie w tle,
+// a u8x8_DrawTile() zostaje jako zapas.
+static inline void oledSendTiles(u8x8_t* u8x8, const uint8_t* buf, uint8_t tx, uint8_t ty, uint8_t tw)
+{
+  if (oledSpiDmaSendSpan(buf, tx, ty, tw)) return;
+  u8x8_DrawTile(u8x8, tx, ty, tw, (uint8_t*)(buf + ty * OLED_ROW_BYTES + tx * 8));
+}
+
+// Wyślij ramkę z bufora buf (układ jak bufor u8g2) – tylko zmienione kafelki
+static void oledSendFrameTiles(const uint8_t* buf)
+{
+  uint32_t t0 = micros();
+  u8x8_t* u8x8 = u8g2.getU8x8();
+
+  if (oledInvalidReq.exchange(false)) oledShadowValid = false;
+
+#if ENABLE_OLED_DIRTY_FLUSH
+  if (oledShadowValid)
+  {
+    // zakres zmienionych kafelków w każdym wierszu
+    int8_t   first[OLED_TILE_ROWS];
+    int8_t   last[OLED_TILE_ROWS];
+    uint16_t dirty = 0;
+
+    for (uint8_t ty = 0; ty < OLED_TILE_ROWS; ty++)
+    {
+      const uint8_t* row  = buf + ty * OLED_ROW_BYTES;
+      const uint8_t* srow = oledShadow + ty * OLED_ROW_BYTES;
+      first[ty] = -1;
+      last[ty]  = -1;
+      for (uint8_t tx = 0; tx < OLED_TILE_COLS; tx++)
+      {
+        if (memcmp(row + tx * 8, srow + tx * 8, 8) != 0)
+        {
+          if (first[ty] < 0) first[ty] = tx;
+          last[ty] = tx;
+        }
+      }
+      if (first[ty] >= 0) dirty += last[ty] - first[ty] + 1;
+    }
+
+    if (dirty == 0)
+    {
+      oledStats.framesIdle++;
+      oledStatsAdd(micros() - t0, 0);
+      return;
+    }
+
+    if (dirty < OLED_FULL_THRESHOLD)
+    {
+      for (uint8_t ty = 0; ty < OLED_TILE_ROWS; ty++)
+      {
+        if (first[ty] < 0) continue;
+        uint8_t tw = last[ty] - first[ty] + 1;
+        oledSendTiles(u8x8, buf, first[ty], ty, tw);
+        memcpy(oledShadow + ty * OLED_ROW_BYTES + first[ty] * 8,
+               buf + ty * OLED_ROW_BYTES + first[ty] * 8, tw * 8);
+      }
+      oledStatsAdd(micros() - t0, dirty);
+      return;
+    }
+  }
+#endif
+
+  // pełna ramka: pierwsza po starcie / oledInvalidate() albo dużo zmian
+  for (uint8_t ty = 0; ty < OLED_TILE_ROWS; ty++)
+    oledSendTiles(u8x8, buf, 0, ty, OLED_TILE_COLS);
+  if (!oledSpiDmaActive()) u8x8_RefreshDisplay(u8x8);   // SSD1322 i tak nic tu nie wysyła
+  memcpy(oledShadow, buf, OLED_BUF_BYTES);
+  oledShadowValid = true;
+  oledStats.framesFull++;
+  oledStatsAdd(micros() - t0, OLED_TILES);
+}
+
+// Na panelu jest ramka 4bpp (OLED_Gray) – cień 1bpp jej nie opisuje
+static bool oledGrayShown = false;
+
+// Czas w statystykach to czas CPU (konwersja + kolejkowanie), bez czekania
+// na DMA – to liczy osobno OLED_SpiDma (dmaWaitUs).
+static void oledSendFrame(const uint8_t* buf)
+{
+  if (oledGrayShown)
+  {
+    oledInvalidate();
+    oledGrayShown = false;
+  }
+  oledSpiDmaFrameBegin();
+  oledSendFrameTiles(buf);
+  oledSpiDmaFrameEnd();
+}
+
+// Klatka stylu w skali szarości – ramkę 4bpp złożył już styl (OLED_Gray)
+static void oledSendGrayFrame()
+{
+  if (!oledGrayShown)
+  {
+    oledGrayInvalidate();
+    oledGrayShown = true;
+  }
+  oledSpiDmaFrameBegin();
+  oledGrayFlush();
+  oledSpiDmaFrameEnd();
+}
+
+// ─────────────────────────────────────
+// Stan od loop() dla zadania
+// ─────────────────────────────────────
+static OledFrameState oledState = {};
+static portMUX_TYPE   oledStateMux = portMUX_INITIALIZER_UNLOCKED;
+
+void oledPostState(const OledFrameState& st)
+{
+  portENTER_CRITICAL(&oledStateMux);
+  oledState = st;
+  portEXIT_CRITICAL(&oledStateMux);
+}
+
+void oledGetState(OledFrameState* out)
+{
+  if (!out) return;
+  portENTER_CRITICAL(&oledStateMux);
+  *out = oledState;
+  portEXIT_CRITICAL(&oledStateMux);
+}
+
+// Bufor u8g2 → PBM (P4 256x64 w orientacji ekranu, MSB = lewy piksel,
+// 1 = czarny/zapalony); flip dla U8G2_R2, bo bufor jest w układzie panelu
+static void oledEncodePbm(const uint8_t* buf, bool flip, uint8_t* out)
+{
+  memcpy(out, "P4\n256 64\n", 10);
+  uint8_t* dst = out + 10;
+  for (uint8_t y = 0; y < 64; y++)
+  {
+    const uint8_t py  = flip ? 63 - y : y;
+    const uint8_t bit = 1 << (py & 7);
+    const uint8_t* row = buf + (py >> 3) * OLED_ROW_BYTES;
+    for (uint16_t xb = 0; xb < 256; xb += 8)
+    {
+      uint8_t b = 0;
+      for (uint8_t k = 0; k < 8; k++)
+      {
+        const uint16_t x  = xb + k;
+        const uint16_t px = flip ? 255 - x : x;
+        if (row[px] & bit) b |= 0x80 >> k;
+      }
+      *dst++ = b;
+    }
+  }
+}
+
+// ─────────────────────────────────────
+// Zadanie renderujące (Core1)
+// ─────────────────────────────────────
+// Trzy bufory ramki: loop() pisze do "back", zadanie wysyła "front", a
+// "ready" to ostatnia kompletna ramka. Zamiana indeksów to jedna operacja
+// atomowa, więc żadna strona nie czeka na drugą. Producent jest jeden –
+// oledFlush() woła tylko loop(), tak jak wcześniej sendBuffer().
+static const uint8_t OLED_FRAME_IDX = 0x03;
+static const uint8_t OLED_FRAME_NEW = 0x80;
+
+static uint8_t*  oledFrames[3]   = { nullptr, nullptr, nullptr };
+static uint8_t   oledBack        = 0;          // tylko loop()
+static uint8_t   oledFront       = 2;          // tylko zadanie
+static std::atomic<uint8_t> oledReady(1);      // indeks | OLED_FRAME_NEW
+static TaskHandle_t oledTask     = nullptr;
+
+// Płótno stylów 5-9 rysowanych w zadaniu. Obiekt u8g2 służy tylko do
+// rysowania (nigdy begin()); bufor trzeba mu podmienić, bo wszystkie
+// instancje tego samego wyświetlacza dzielą jeden statyczny bufor u8g2.
+static U8G2_SSD1322_NHD_256X64_F_4W_HW_SPI oledCanvas(U8G2_R2, U8X8_PIN_NONE, U8X8_PIN_NONE, U8X8_PIN_NONE);
+static uint8_t* oledCanvasBuf = nullptr;
+
+static uint8_t* oledAllocFrame()
+{
+  uint8_t* p = (uint8_t*)heap_caps_malloc(OLED_BUF_BYTES, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+  if (p) memset(p, 0, OLED_BUF_BYTES);
+  return p;
+}
+
+// Podgląd /analyzerPreview: handler WWW zapisuje tryb w oledPreviewReq
+// (i niezapisane ustawienia formularza w oledPreviewCfg), zadanie rysuje go na oledCanvas z podmienionym buforem i publikuje PBM
+// z numerem (nieparzysty = zapis w toku). Handler nie czeka ani na ekran,
+// ani na sam podgląd – oddaje ostatni gotowy, a zadanie nie rysuje
+// podglądu częściej, niż pozwala budżet.
+static std::atomic<uint8_t> oledPreviewReq(0);   // zamówiony tryb, 0 = brak
+static uint8_t*  oledPreviewBuf    = nullptr;     // płótno podglądu
+static uint8_t*  oledPreviewOut    = nullptr;     // ostatni podgląd (PBM)
+static uint8_t   oledPreviewMode   = 0;
+static uint32_t  oledPreviewSeqNo  = 0;
+static uint32_t  oledPreviewNextMs = 0;           // wcześniej – poza budżetem
+static AnalyzerStyleCfg oledPreviewCfg;           // ustawienia podglądu (pod oledPreviewMux)
+static bool      oledPreviewHasCfg = false;       // false = rysuj z bieżących
+static portMUX_TYPE oledPreviewMux = portMUX_INITIALIZER_UNLOCKED;
+
+static void oledPreviewService()
+{
+  if (oledPreviewReq.load() == 0) return;
+  const uint32_t now = millis();
+  if ((int32_t)(now - oledPreviewNextMs) < 0) return;   // zamówienie czeka na następny takt
+  const uint8_t mode = oledPreviewReq.exchange(0);
+  if (mode == 0) return;
+
+  AnalyzerStyleCfg cfg;
+  portENTER_CRITICAL(&oledPreviewMux);
+  const bool hasCfg = oledPreviewHasCfg;
+  if (hasCfg) cfg = oledPreviewCfg;
+  portEXIT_CRITICAL(&oledPreviewMux);
+
+  uint32_t t0 = micros();
+  u8g2_t* g = oledCanvas.getU8g2();
+  g->tile_buf_ptr = oledPreviewBuf;
+  analyzerRenderPreview(mode, hasCfg ? &cfg : nullptr);
+  g->tile_buf_ptr = oledCanvasBuf;
+
+  __atomic_store_n(&oledPreviewSeqNo, oledPreviewSeqNo + 1, __ATOMIC_RELAXED);
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+  oledEncodePbm(oledPreviewBuf, g->cb == U8G2_R2, oledPreviewOut);
+  oledPreviewMode = mode;
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+  __atomic_store_n(&oledPreviewSeqNo, oledPreviewSeqNo + 1, __ATOMIC_RELAXED);
+
+  uint32_t us = micros() - t0;
+  oledStats.framesPreview++;
+  oledStats.previewUs = (oledStats.framesPreview == 1) ? us : (oledStats.previewUs * 15 + us) / 16;
+
+  // przerwa co najmniej OLED_PREVIEW_DUTY razy dłuższa niż sam podgląd
+  uint32_t gapMs = us * OLED_PREVIEW_DUTY / 1000;
+  if (gapMs < OLED_PREVIEW_MIN_MS) gapMs = OLED_PREVIEW_MIN_MS;
+  oledPreviewNextMs = millis() + gapMs;
+}
+
+static void oledRenderTaskFn(void*)
+{
+  const TickType_t period = pdMS_TO_TICKS(1000 / OLED_RENDER_FPS);
+  TickType_t nextRender = xTaskGetTickCount();
+
+  for (;;)
+  {
+    // budzi nas nowa ramka z loop() albo termin następnej klatki analizatora
+    int32_t wait = (int32_t)(nextRender - xTaskGetTickCount());
+    ulTaskNotifyTake(pdTRUE, (wait > 0) ? (TickType_t)wait : 0);
+
+    if (oledReady.load() & OLED_FRAME_NEW)
+    {
+      oledFront = oledReady.exchange(oledFront) & OLED_FRAME_IDX;
+      oledSendFrame(oledFrames[oledFront]);
+    }
+    oledPreviewService();
+
+    OledFrameState st;
+    oledGetState(&st);
+    TickType_t now = xTaskGetTickCount();
+
+    if (!st.analyzer)
+    {
+      nextRender = now + period;
+      continue;
+    }
+    if ((int32_t)(now - nextRender) < 0) continue;
+
+    // takt zadania jest stały, a analyzerFrameDue() pomija klatki ponad
+    // limit FPS stylu i te, w których analizator nic nowego nie dał
+    nextRender += period;
+    if ((int32_t)(now - nextRender) >= 0) nextRender = now + period;   // nie nadrabiamy zaległych
+    if (!analyzerFrameDue(st)) continue;
+
+    // 4bpp tylko przez DMA (okna wierszy 4bpp); bufory przy pierwszym użyciu
+    const bool gray = analyzerGrayWanted(st.displayMode) && oledSpiDmaActive() && oledGrayBegin();
+    analyzerSetGray(gray);
+
+    uint32_t t0 = micros();
+    analyzerRenderStyle(st.displayMode);
+    uint32_t us = micros() - t0;
+    oledStats.framesRendered++;
+    oledStats.renderUs = (oledStats.framesRendered == 1) ? us : (oledStats.renderUs * 15 + us) / 16;
+    oledNoteDrawTime(st.displayMode, us);
+
+    if (gray) oledSendGrayFrame();
+    else      oledSendFrame(oledCanvasBuf);
+  }
+}
+
+bool oledRenderStart()
+{
+#if ENABLE_OLED_RENDER_TASK
+  if (oledTask) return true;
+
+  for (uint8_t i = 0; i < 3; i++)
+  {
+    if (!oledFrames[i]) oledFrames[i] = oledAllocFrame();
+    if (!oledFrames[i]) return false;
+  }
+  if (!oledCanvasBuf) oledCanvasBuf = oledAllocFrame();
+  if (!oledCanvasBuf) return false;
+
+  oledCanvas.getU8g2()->tile_buf_ptr = oledCanvasBuf;
+  analyzerSetRenderTarget(&oledCanvas);
+
+  if (xTaskCreatePinnedToCore(oledRenderTaskFn, "oledRender", 6144, nullptr, 1, &oledTask, 1) != pdPASS)
+  {
+    oledTask = nullptr;
+    analyzerSetRenderTarget(nullptr);
+    return false;
+  }
+  return true;
+#else
+  return false;
+#endif
+}
+
+bool oledRenderActive()
+{
+  return oledTask != nullptr;
+}
+
+void oledFlush()
+{
+  if (!oledTask)
+  {
+    oledSendFrame(u8g2.getBufferPtr());
+    return;
+  }
+
+  // ramka z loop() odbiera ekran stylom 5-9 do następnego oledPostState()
+  portENTER_CRITICAL(&oledStateMux);
+  oledState.analyzer = false;
+  portEXIT_CRITICAL(&oledStateMux);
+
+  memcpy(oledFrames[oledBack], u8g2.getBufferPtr(), OLED_BUF_BYTES);
+  uint8_t prev = oledReady.exchange(oledBack | OLED_FRAME_NEW);
+  if (prev & OLED_FRAME_NEW) oledStats.framesDropped++;
+  oledBack = prev & OLED_FRAME_IDX;
+  xTaskNotifyGive(oledTask);
+}
+
+void oledGetStats(OledStats* out)
+{
+  if (out) *out = oledStats;
+}
+
+void oledNoteDrawTime(uint8_t mode, uint32_t us)
+{
+  if (mode >= OLED_STATS_MODES) return;
+  uint32_t& avg = oledStats.drawUs[mode];
+  avg = (avg == 0) ? us : (avg * 15 + us) / 16;
+  if (us > oledStats.drawMaxUs[mode]) oledStats.drawMaxUs[mode] = us;
+}
+
+size_t oledSnapshotPbm(uint8_t* out, size_t cap)
+{
+  if (!out || cap < OLED_PBM_BYTES || oledStats.frames == 0) return 0;
+
+  // Kopia cienia bez blokady – przy wysyłaniu w tym samym czasie zrzut
+  // może mieszać dwie kolejne ramki, do podglądu to bez znaczenia.
+  // Z ramką 4bpp na panelu cień 1bpp jest nieaktualny – zrzut z cienia
+  // OLED_Gray (każdy zapalony poziom = piksel).
+  static uint8_t snap[OLED_BUF_BYTES];
+  if (!oledGrayShown || !oledGrayTo1bpp(snap, 1))
+    memcpy(snap, oledShadow, OLED_BUF_BYTES);
+  oledEncodePbm(snap, u8g2.getU8g2()->cb == U8G2_R2, out);   // bufor w układzie panelu
+  return OLED_PBM_BYTES;
+}
+
+uint32_t oledPreviewSeq()
+{
+  return __atomic_load_n(&oledPreviewSeqNo, __ATOMIC_ACQUIRE) >> 1;
+}
+
+bool oledPreviewRequest(uint8_t mode, const AnalyzerStyleCfg* cfg)
+{
+  if (!oledTask || mode < 5 || mode > 12) return false;
+  // bufory przy pierwszym podglądzie; zadanie sięga po nie dopiero po zamówieniu
+  if (!oledPreviewBuf) oledPreviewBuf = oledAllocFrame();
+  if (!oledPreviewOut) oledPreviewOut = (uint8_t*)heap_caps_malloc(OLED_PBM_BYTES, MALLOC_CAP_8BIT);
+  if (!oledPreviewBuf || !oledPreviewOut) return false;
+  portENTER_CRITICAL(&oledPreviewMux);
+  oledPreviewHasCfg = (cfg != nullptr);
+  if (cfg) oledPreviewCfg = *cfg;
+  portEXIT_CRITICAL(&oledPreviewMux);
+  oledPreviewReq.store(mode);
+  xTaskNotifyGive(oledTask);
+  return true;
+}
+
+// Nie czeka: handler WWW działa w async_tcp, więc przy zapisie w toku
+// tylko ponawia kopię, a po kilku próbach oddaje 0 (klient spróbuje znowu).
+size_t oledPreviewPbm(uint8_t* out, size_t cap, uint8_t* mode, uint32_t* seq)
+{
+  if (!out || cap < OLED_PBM_BYTES || !oledPreviewOut) return 0;
+  for (uint8_t tries = 0; tries < 4; tries++)
+  {
+    const uint32_t s1 = __atomic_load_n(&oledPreviewSeqNo, __ATOMIC_ACQUIRE);
+    if (s1 == 0) return 0;                       // jeszcze żadnego podglądu
+    if (s1 & 1) continue;                        // zadanie właśnie koduje
+    memcpy(out, oledPreviewOut, OLED_PBM_BYTES);
+    const uint8_t m = oledPreviewMode;
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    if (__atomic_load_n(&oledPreviewSeqNo, __ATOMIC_RELAXED) == s1)
+    {
+      if (mode) *mode = m;
+      if (seq)  *seq  = s1 >> 1;
+      return OLED_PBM_BYTES;
+    }
+  }
+  return 0;
+}
+
+void oledResetStats()
+{
+  memset(&oledStats, 0, sizeof(oledStats));
+  oledSpiDmaResetStats();
+  oledGrayResetStats();
+}
+
+String oledStatsToJson()
+{
+  OledStats s = oledStats;
+  OledSpiDmaStats d;
+  oledSpiDmaGetStats(&d);
+  OledGrayStats g;
+  oledGrayGetStats(&g);
+  const uint32_t grayRows = g.frames ? g.rowsSent / g.frames : 0;
+  // czas samego SPI dla średniej ramki 4bpp (128 B na wiersz)
+  const uint32_t grayWireUs = (uint32_t)((uint64_t)grayRows * 128 * 8 * 1000000ULL / OLED_SPI_CLOCK_HZ);
+  float sentPct = (s.tilesTotal > 0) ? 100.0f * (float)s.tilesSent / (float)s.tilesTotal : 0.0f;
+
+  String json;
+  json.reserve(800);
+  json += "{";
+  json += "\"task\":"           + String(oledTask ? 1 : 0) + ",";
+  json += "\"frames\":"         + String(s.frames) + ",";
+  json += "\"framesIdle\":"     + String(s.framesIdle) + ",";
+  json += "\"framesFull\":"     + String(s.framesFull) + ",";
+  json += "\"framesDropped\":"  + String(s.framesDropped) + ",";
+  json += "\"framesRendered\":" + String(s.framesRendered) + ",";
+  json += "\"renderUs\":"       + String(s.renderUs) + ",";
+  json += "\"framesPreview\":"  + String(s.framesPreview) + ",";
+  json += "\"previewUs\":"      + String(s.previewUs) + ",";
+  json += "\"tilesSent\":"      + String(s.tilesSent) + ",";
+  json += "\"tilesTotal\":"     + String(s.tilesTotal) + ",";
+  json += "\"sentPct\":"        + String(sentPct, 1) + ",";
+  json += "\"lastUs\":"         + String(s.lastUs) + ",";
+  json += "\"avgUs\":"          + String(s.avgUs) + ",";
+  json += "\"maxUs\":"          + String(s.maxUs) + ",";
+  json += "\"dma\":"            + String(oledSpiDmaActive() ? 1 : 0) + ",";
+  json += "\"spiHz\":"          + String((uint32_t)OLED_SPI_CLOCK_HZ) + ",";
+  json += "\"dmaBytes\":"       + String(d.bytes) + ",";
+  json += "\"dmaWaitUs\":"      + String(d.waitUs) + ",";
+  json += "\"dmaMaxWaitUs\":"   + String(d.maxWaitUs) + ",";
+  json += "\"grayFrames\":"     + String(g.frames) + ",";
+  json += "\"grayIdle\":"       + String(g.framesIdle) + ",";
+  json += "\"grayRows\":"       + String(grayRows) + ",";
+  json += "\"grayConvUs\":"     + String(g.convUs) + ",";
+  json += "\"grayFlushUs\":"    + String(g.flushUs) + ",";
+  json += "\"grayMaxFlushUs\":" + String(g.maxFlushUs) + ",";
+  json += "\"grayWireUs\":"     + String(grayWireUs) + ",";
+  json += "\"drawUs\":[";
+  for (uint8_t m = 0; m < OLED_STATS_MODES; m++)
+  {
+    if (m) json += ",";
+    json += String(s.drawUs[m]);
+  }
+  json += "],\"drawMaxUs\":[";
+  for (uint8_t m = 0; m < OLED_STATS_MODES; m++)
+  {
+    if (m) json += ",";
+    json += String(s.drawMaxUs[m]);
+  }
+  json += "]}";
+  return json;
+}
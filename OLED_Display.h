@@ -0,0 +1,96 @@
+#pragma once
+#include <Arduino.h>
+
+// Wysyłanie ramki u8g2 do SSD1322.
+// oledFlush() zastępuje u8g2.sendBuffer(): porównuje bufor z kopią ostatnio
+// wysłanej ramki i wysyła tylko zmienione kafelki 8x8 (osobno dla każdego
+// wiersza kafelków). Zegar czy jedna linia scrollera to kilka-kilkanaście
+// kafelków zamiast 256.
+//
+// Z ENABLE_OLED_RENDER_TASK transfer SPI robi osobne zadanie na Core1:
+// oledFlush() tylko kopiuje bufor u8g2 do wolnego bufora ramki (potrójne
+// buforowanie) i budzi zadanie, więc loop() wraca do audio.loop() od razu.
+// Style analizatora 5-12 zadanie rysuje samo na własnym płótnie ze stałą
+// liczbą klatek – loop() przekazuje mu tylko stan (oledPostState()).
+// Style 5, 6 i 8 z włączoną skalą szarości idą ramką 4bpp (OLED_Gray).
+
+#ifndef ENABLE_OLED_DIRTY_FLUSH
+#define ENABLE_OLED_DIRTY_FLUSH 1   // 0 = zawsze pełna ramka
+#endif
+
+#ifndef ENABLE_OLED_RENDER_TASK
+#define ENABLE_OLED_RENDER_TASK 1   // 0 = oledFlush() wysyła synchronicznie z loop()
+#endif
+
+#ifndef OLED_RENDER_FPS
+#define OLED_RENDER_FPS 60          // takt zadania; FPS stylu ogranicza analyzerFrameDue()
+#endif
+
+#define OLED_STATS_MODES 13         // czasy rysowania dla displayMode 0-12
+
+struct OledStats {
+  uint32_t frames;          // wysłane ramki (również puste)
+  uint32_t framesIdle;      // ramki bez żadnej zmiany (nic nie wysłano)
+  uint32_t framesFull;      // ramki wysłane w całości
+  uint32_t tilesSent;       // wysłane kafelki 8x8
+  uint32_t tilesTotal;      // kafelki, które poszłyby przy samym sendBuffer()
+  uint32_t lastUs;          // czas ostatniego wysłania [us]
+  uint32_t avgUs;           // średnia krocząca [us]
+  uint32_t maxUs;           // najdłuższe wysłanie [us]
+  uint32_t framesDropped;   // ramki z loop() nadpisane zanim zadanie je wysłało
+  uint32_t framesRendered;  // klatki stylów 5-9 narysowane w zadaniu
+  uint32_t framesPreview;   // podglądy /analyzerPreview narysowane w zadaniu
+  uint32_t previewUs;       // średni czas podglądu (rysowanie + PBM) [us]
+  uint32_t renderUs;        // średni czas rysowania klatki w zadaniu [us]
+  uint32_t drawUs[OLED_STATS_MODES];  // średni czas rysowania ekranu VU/analizatora wg trybu [us]
+  uint32_t drawMaxUs[OLED_STATS_MODES];  // najdłuższe rysowanie wg trybu [us] (regresje kosztu)
+};
+
+// Stan, z którego zadanie rysuje style 5-9 (bez sięgania po Stringi z loop())
+struct OledFrameState {
+  uint8_t displayMode;
+  uint8_t volume;
+  bool    mute;
+  bool    analyzer;         // true = ekran należy do zadania (style 5-12)
+  uint8_t audioFill;        // zapełnienie bufora audio [%] (adaptacyjne FPS)
+  char    station[64];      // nazwa stacji do paska u góry
+};
+
+void oledFlush();                    // wyślij (lub przekaż zadaniu) bufor u8g2
+void oledInvalidate();               // następna ramka pójdzie w całości
+void oledGetStats(OledStats* out);
+void oledResetStats();
+String oledStatsToJson();            // dla /displayStats
+void oledNoteDrawTime(uint8_t mode, uint32_t us);   // czas rysowania stylu (loop() lub zadanie)
+
+// Zrzut ostatnio wysłanej ramki jako PBM (P4, 256x64, w orientacji ekranu;
+// ramka 4bpp progowana – każdy zapalony poziom = piksel) – do /display.pbm, podglądu bez sprzętu obok i porównań z wzorcem.
+// Zwraca liczbę bajtów (0 = brak ramki albo za mały bufor).
+#define OLED_PBM_BYTES (10 + 256 * 64 / 8)
+size_t oledSnapshotPbm(uint8_t* out, size_t cap);
+
+// Podgląd stylu 5-12 dla edytora /analyzer bez zmiany ekranu. WWW tylko
+// zamawia tryb (opcjonalnie z niezapisanymi ustawieniami); zadanie renderujące rysuje go między klatkami ekranu na
+// osobnym płótnie (analyzerRenderPreview()) i koduje do PBM jak wyżej.
+// Najwyżej jeden podgląd na OLED_PREVIEW_MIN_MS, a drogi styl rzadziej –
+// podglądy biorą co najwyżej 1/OLED_PREVIEW_DUTY czasu zadania.
+#ifndef OLED_PREVIEW_MIN_MS
+#define OLED_PREVIEW_MIN_MS 100
+#endif
+#define OLED_PREVIEW_DUTY 10
+
+struct AnalyzerStyleCfg;
+// cfg kopiowane przy zamówieniu, nullptr = bieżące ustawienia; false = brak zadania/pamięci albo tryb spoza 5-12
+bool     oledPreviewRequest(uint8_t mode, const AnalyzerStyleCfg* cfg = nullptr);
+uint32_t oledPreviewSeq();                   // rośnie po każdym gotowym podglądzie
+// ostatni gotowy podgląd (bez czekania); seq = jego numer jak w oledPreviewSeq(); 0 = brak/zapis w toku
+size_t   oledPreviewPbm(uint8_t* out, size_t cap, uint8_t* mode, uint32_t* seq);
+
+// Zadanie renderujące (wywołać po u8g2.begin()); bez niego oledFlush() działa synchronicznie
+bool oledRenderStart();
+bool oledRenderActive();
+
+// loop() publikuje stan co przebieg scrollera; analyzer=true oddaje ekran zadaniu.
+// Każdy oledFlush() z loop() odbiera ekran zadaniu do następnego oledPostState().
+void oledPostState(const OledFrameState& st);
+void oledGetState(OledFrameState* out);
@@ -0,0 +1,114 @@
+#include "OLED_Glyphs.h"
+
+#include <U8g2lib.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+
+struct OledGlyph {
+  int8_t  dx;         // przesunięcie kursora
+  uint8_t w;          // szerokość bitmapy (0 = np. spacja, bez korekty ostatniego znaku)
+  int8_t  xoff;       // offset bitmapy w x
+  uint8_t found;      // 0 = brak glifu w foncie
+};
+
+struct OledGlyphFont {
+  const uint8_t* font;
+  volatile bool  ready;   // tablica wypełniona – od tej chwili tylko odczyt
+  OledGlyph      g[256];
+};
+
+// Sloty zajmowane raz na font i nigdy nie zwalniane: gotowa tablica się nie
+// zmienia, więc loop() i zadanie OLED mogą z niej czytać bez blokady.
+static OledGlyphFont oledGlyphFonts[OLED_GLYPH_FONTS];
+static portMUX_TYPE  oledGlyphMux = portMUX_INITIALIZER_UNLOCKED;
+
+static OledGlyph oledGlyphFetch(u8g2_t* u, uint8_t c)
+{
+  OledGlyph g = {0, 0, 0, 0};
+  if (!u8g2_font_get_glyph_data(u, c)) return g;
+  g.dx    = u8g2_GetGlyphWidth(u, c);
+  g.w     = u->font_decode.glyph_width;   // efekty uboczne u8g2_GetGlyphWidth()
+  g.xoff  = u->glyph_x_offset;
+  g.found = 1;
+  return g;
+}
+
+// Tablica dla fontu; nullptr = nie ma jeszcze/brak miejsca (pomiar bez cache)
+static const OledGlyphFont* oledGlyphTable(u8g2_t* u, const uint8_t* font)
+{
+  OledGlyphFont* slot = nullptr;
+
+  portENTER_CRITICAL(&oledGlyphMux);
+  for (uint8_t i = 0; i < OLED_GLYPH_FONTS; i++)
+  {
+    if (oledGlyphFonts[i].font == font)
+    {
+      OledGlyphFont* f = &oledGlyphFonts[i];
+      portEXIT_CRITICAL(&oledGlyphMux);
+      return f->ready ? f : nullptr;   // budowany w innym zadaniu – tym razem bez cache
+    }
+    if (!slot && !oledGlyphFonts[i].font) slot = &oledGlyphFonts[i];
+  }
+  if (slot) slot->font = font;          // zajmujemy slot, budujemy już poza sekcją krytyczną
+  portEXIT_CRITICAL(&oledGlyphMux);
+  if (!slot) return nullptr;
+
+  for (uint16_t c = 0; c < 256; c++) slot->g[c] = oledGlyphFetch(u, (uint8_t)c);
+  slot->ready = true;
+  return slot;
+}
+
+void oledTextMeasure(U8G2& gfx, const uint8_t* font, const char* text, uint16_t maxWidth, OledTextMetrics& out)
+{
+  u8g2_t* u = gfx.getU8g2();
+  const uint8_t* prevFont = u->font;
+  if (!font) font = prevFont;
+  if (font != prevFont) gfx.setFont(font);
+
+  const OledGlyphFont* tab = font ? oledGlyphTable(u, font) : nullptr;
+
+  // Jak u8g2_string_width(): suma dx, a dla ostatniego znalezionego glifu
+  // zamiast jego dx szerokość bitmapy + offset (chyba że bitmapa ma 0 px)
+  uint16_t adv = 0;
+  uint16_t width = 0;
+  int8_t   lastDx = 0;
+  uint8_t  lastW = 0;
+  int8_t   lastXoff = 0;
+
+  out.fitLen   = 0;
+  out.fitWidth = 0;
+
+  uint16_t n = 0;
+  if (font)
+  {
+    const uint8_t* p = (const uint8_t*)text;
+    for (; *p && *p != '\n'; p++, n++)
+    {
+      OledGlyph g = tab ? tab->g[*p] : oledGlyphFetch(u, *p);
+      if (g.found)
+      {
+        adv     += g.dx;
+        lastDx   = g.dx;
+        lastW    = g.w;
+        lastXoff = g.xoff;
+      }
+      else
+      {
+        lastDx = 0;
+      }
+      width = lastW ? (uint16_t)(adv - lastDx + lastW + lastXoff) : adv;
+      if (width <= maxWidth)
+      {
+        out.fitLen   = n + 1;
+        out.fitWidth = width;
+      }
+    }
+    // u8g2 kończy pomiar na '\n' – dłuższe prefiksy mają tę samą szerokość
+    if (*p && out.fitLen == n) out.fitLen = n + strlen((const char*)p);
+  }
+
+  out.advance = adv;
+  out.width   = width;
+
+  if (font != prevFont && prevFont) gfx.setFont(prevFont);
+}
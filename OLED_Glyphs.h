@@ -0,0 +1,31 @@
+#pragma once
+#include <Arduino.h>
+
+// Szerokości tekstu z tablicy glifów fontu zamiast getStrWidth() w pętli.
+// Dla każdego fontu raz czytamy z u8g2 dane 256 znaków (przesunięcie,
+// szerokość bitmapy, offset x), potem pomiar i przycinanie tekstu to jedno
+// przejście po bajtach. Tekst liczony jak drawStr()/print() bez UTF-8:
+// bajt = znak, brak glifu = 0 px (np. nieprzetworzone bajty UTF-8).
+
+#ifndef OLED_GLYPH_FONTS
+#define OLED_GLYPH_FONTS 6     // ile fontów trzymamy w cache (bez wymiany – potem pomiar bez cache)
+#endif
+
+class U8G2;
+
+struct OledTextMetrics {
+  uint16_t advance;   // przesunięcie kursora po drawStr() – okres powtarzania w scrollerze
+  uint16_t width;     // szerokość w pikselach jak getStrWidth()
+  uint16_t fitLen;    // najdłuższy prefiks z width <= maxWidth (jak obcinanie po znaku od końca)
+  uint16_t fitWidth;  // jego szerokość
+};
+
+// font == nullptr → bieżący font gfx. Font gfx zostaje taki, jak przed wywołaniem.
+void oledTextMeasure(U8G2& gfx, const uint8_t* font, const char* text, uint16_t maxWidth, OledTextMetrics& out);
+
+static inline uint16_t oledTextAdvance(U8G2& gfx, const uint8_t* font, const char* text)
+{
+  OledTextMetrics m;
+  oledTextMeasure(gfx, font, text, 0xFFFF, m);
+  return m.advance;
+}
@@ -0,0 +1,225 @@
+#include "OLED_Gray.h"
+#include "OLED_SpiDma.h"
+
+#include <string.h>
+#include "esp_heap_caps.h"
+
+// ─────────────────────────────────────
+// Geometria ramki 4bpp (układ panelu)
+// ─────────────────────────────────────
+static const uint16_t OLED_GRAY_W          = 256;
+static const uint8_t  OLED_GRAY_H          = 64;
+static const uint16_t OLED_GRAY_ROW_BYTES  = OLED_GRAY_W / 2;
+static const uint16_t OLED_GRAY_BYTES      = OLED_GRAY_ROW_BYTES * OLED_GRAY_H;
+static const uint8_t  OLED_GRAY_MAX_SPANS  = 8;   // tyle okien mieści kolejka OLED_SpiDma
+
+static uint8_t* oledGrayBuf    = nullptr;   // bieżąca klatka
+static uint8_t* oledGrayShadow = nullptr;   // ostatnio wysłana
+static bool     oledGrayShadowValid = false;
+static bool     oledGrayFlip   = true;
+static OledGrayStats oledGrayStats = {};
+
+static uint8_t* oledGrayAlloc()
+{
+  uint8_t* p = (uint8_t*)heap_caps_malloc(OLED_GRAY_BYTES, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+  if (!p) p = (uint8_t*)ps_malloc(OLED_GRAY_BYTES);
+  if (p) memset(p, 0, OLED_GRAY_BYTES);
+  return p;
+}
+
+bool oledGrayBegin()
+{
+#if ENABLE_OLED_GRAY
+  if (!oledGrayBuf)    oledGrayBuf    = oledGrayAlloc();
+  if (!oledGrayShadow) oledGrayShadow = oledGrayAlloc();
+  return oledGrayBuf && oledGrayShadow;
+#else
+  return false;
+#endif
+}
+
+bool oledGrayReady()
+{
+  return oledGrayBuf && oledGrayShadow;
+}
+
+void oledGrayInvalidate()
+{
+  oledGrayShadowValid = false;
+}
+
+// ─────────────────────────────────────
+// Rysowanie
+// ─────────────────────────────────────
+void oledGrayFrom1bpp(const uint8_t* buf, uint8_t level, bool flip)
+{
+  if (!oledGrayBuf || !buf) return;
+  uint32_t t0 = micros();
+
+  if (level > OLED_GRAY_MAX) level = OLED_GRAY_MAX;
+  // 2 bity wejścia (piksel parzysty, nieparzysty) → bajt 4bpp
+  const uint8_t nib[4] = { 0x00, level, (uint8_t)(level << 4), (uint8_t)((level << 4) | level) };
+
+  // Bufor u8g2: 8 wierszy kafelków po 256 bajtów, bajt = 8 pikseli w pionie (LSB u góry)
+  for (uint8_t ty = 0; ty < OLED_GRAY_H / 8; ty++)
+  {
+    const uint8_t* src = buf + ty * OLED_GRAY_W;
+    uint8_t* dst = oledGrayBuf + (ty * 8) * OLED_GRAY_ROW_BYTES;
+    for (uint16_t xb = 0; xb < OLED_GRAY_ROW_BYTES; xb++)
+    {
+      uint8_t a = src[2 * xb];
+      uint8_t b = src[2 * xb + 1];
+      uint8_t* d = dst + xb;
+      for (uint8_t k = 0; k < 8; k++)
+      {
+        *d = nib[((a & 1) << 1) | (b & 1)];
+        d += OLED_GRAY_ROW_BYTES;
+        a >>= 1;
+        b >>= 1;
+      }
+    }
+  }
+
+  oledGrayFlip = flip;
+  uint32_t us = micros() - t0;
+  oledGrayStats.convUs = (oledGrayStats.convUs == 0) ? us : (oledGrayStats.convUs * 15 + us) / 16;
+}
+
+static inline void oledGrayPut(uint8_t* row, uint16_t px, uint8_t level)
+{
+  uint8_t& b = row[px >> 1];
+  b = (px & 1) ? (uint8_t)((b & 0xF0) | level) : (uint8_t)((b & 0x0F) | (level << 4));
+}
+
+// Kolumna ekranowa x, wiersze y..y+h-1 (już przycięte) – z obrotem R2
+static inline void oledGrayColumn(int16_t x, int16_t y, int16_t h, uint8_t level)
+{
+  const uint16_t px = oledGrayFlip ? (OLED_GRAY_W - 1 - x) : x;
+  for (int16_t j = 0; j < h; j++)
+  {
+    const uint8_t py = oledGrayFlip ? (OLED_GRAY_H - 1 - (y + j)) : (y + j);
+    oledGrayPut(oledGrayBuf + py * OLED_GRAY_ROW_BYTES, px, level);
+  }
+}
+
+static bool oledGrayClip(int16_t& x, int16_t& y, int16_t& w, int16_t& h)
+{
+  if (x < 0) { w += x; x = 0; }
+  if (y < 0) { h += y; y = 0; }
+  if (x + w > OLED_GRAY_W) w = OLED_GRAY_W - x;
+  if (y + h > OLED_GRAY_H) h = OLED_GRAY_H - y;
+  return w > 0 && h > 0;
+}
+
+void oledGrayFillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint8_t level)
+{
+  if (!oledGrayBuf || !oledGrayClip(x, y, w, h)) return;
+  if (level > OLED_GRAY_MAX) level = OLED_GRAY_MAX;
+  for (int16_t i = 0; i < w; i++) oledGrayColumn(x + i, y, h, level);
+}
+
+void oledGrayHGradient(int16_t x, int16_t y, int16_t w, int16_t h, int16_t span, uint8_t l0, uint8_t l1)
+{
+  if (!oledGrayBuf || span < 1) return;
+  if (w > span) w = span;
+  if (l0 > OLED_GRAY_MAX) l0 = OLED_GRAY_MAX;
+  if (l1 > OLED_GRAY_MAX) l1 = OLED_GRAY_MAX;
+
+  const int16_t x0 = x;
+  if (!oledGrayClip(x, y, w, h)) return;
+  const int16_t den = (span > 1) ? span - 1 : 1;
+  for (int16_t i = 0; i < w; i++)
+  {
+    const int16_t pos = x + i - x0;   // pozycja w gradiencie (po przycięciu z lewej)
+    const uint8_t lv = (uint8_t)(l0 + ((int16_t)l1 - (int16_t)l0) * pos / den);
+    oledGrayColumn(x + i, y, h, lv);
+  }
+}
+
+// ─────────────────────────────────────
+// Wysyłanie – tylko zmienione wiersze
+// ─────────────────────────────────────
+// Wiersz 4bpp to 128 bajtów, więc porównanie całej ramki to 8 KB memcmp –
+// mniej niż wysłanie jednego wiersza kafelków. Ciągi zmienionych wierszy
+// idą jako okna pełnej szerokości; jeśli ciągów jest więcej niż okien
+// w kolejce DMA, ostatnie okno obejmuje resztę aż do ostatniej zmiany.
+void oledGrayFlush()
+{
+  if (!oledGrayReady()) return;
+  uint32_t t0 = micros();
+
+  uint8_t  spanY[OLED_GRAY_MAX_SPANS];
+  uint8_t  spanN[OLED_GRAY_MAX_SPANS];
+  uint8_t  spans = 0;
+  uint16_t rows  = 0;
+
+  for (uint8_t y = 0; y < OLED_GRAY_H; y++)
+  {
+    const uint16_t off = y * OLED_GRAY_ROW_BYTES;
+    if (oledGrayShadowValid && memcmp(oledGrayBuf + off, oledGrayShadow + off, OLED_GRAY_ROW_BYTES) == 0) continue;
+
+    if (spans > 0 && spanY[spans - 1] + spanN[spans - 1] == y)
+      spanN[spans - 1]++;
+    else if (spans == OLED_GRAY_MAX_SPANS)
+      spanN[spans - 1] = y - spanY[spans - 1] + 1;
+    else
+    {
+      spanY[spans] = y;
+      spanN[spans] = 1;
+      spans++;
+    }
+  }
+
+  for (uint8_t s = 0; s < spans; s++)
+  {
+    const uint16_t off = spanY[s] * OLED_GRAY_ROW_BYTES;
+    const uint16_t len = spanN[s] * OLED_GRAY_ROW_BYTES;
+    if (!oledSpiDmaSendRows(oledGrayBuf + off, spanY[s], spanN[s]))
+    {
+      oledGrayShadowValid = false;   // nie poszło – następna ramka w całości
+      return;
+    }
+    memcpy(oledGrayShadow + off, oledGrayBuf + off, len);
+    rows += spanN[s];
+  }
+  oledGrayShadowValid = true;
+
+  uint32_t us = micros() - t0;
+  oledGrayStats.frames++;
+  if (spans == 0) oledGrayStats.framesIdle++;
+  oledGrayStats.rowsSent += rows;
+  oledGrayStats.flushUs = (oledGrayStats.frames == 1) ? us : (oledGrayStats.flushUs * 15 + us) / 16;
+  if (us > oledGrayStats.maxFlushUs) oledGrayStats.maxFlushUs = us;
+}
+
+bool oledGrayTo1bpp(uint8_t* buf, uint8_t minLevel)
+{
+  if (!buf || !oledGrayReady() || !oledGrayShadowValid) return false;
+  if (minLevel < 1) minLevel = 1;
+
+  // oba bufory w układzie panelu – bez obrotu; bez blokady, jak zrzut cienia 1bpp
+  memset(buf, 0, (OLED_GRAY_W * OLED_GRAY_H) / 8);
+  for (uint8_t py = 0; py < OLED_GRAY_H; py++)
+  {
+    const uint8_t* row = oledGrayShadow + py * OLED_GRAY_ROW_BYTES;
+    uint8_t* dst = buf + (py >> 3) * OLED_GRAY_W;
+    const uint8_t bit = 1 << (py & 7);
+    for (uint16_t px = 0; px < OLED_GRAY_W; px++)
+    {
+      const uint8_t b = row[px >> 1];
+      const uint8_t level = (px & 1) ? (b & 0x0F) : (b >> 4);
+      if (level >= minLevel) dst[px] |= bit;
+    }
+  }
+  return true;
+}
+
+void oledGrayGetStats(OledGrayStats* out)
+{
+  if (out) *out = oledGrayStats;
+}
+
+void oledGrayResetStats()
+{
+  memset(&oledGrayStats, 0, sizeof(oledGrayStats));
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include <Arduino.h>
+
+// Ramka 4bpp (16 poziomów szarości) dla stylów analizatora.
+// u8g2 rysuje tylko 1bpp, więc klatka w skali szarości powstaje tak:
+// styl rysuje zwykłe płótno, oledGrayFrom1bpp() przepisuje je do ramki
+// 4bpp w układzie SSD1322 (wiersz = 128 bajtów, piksel parzysty w starszej
+// połówce), a elementy szare (gradient, gasnący peak) dorysowuje się
+// oledGrayFillRect()/oledGrayHGradient(). oledGrayFlush() porównuje wiersze
+// z kopią ostatnio wysłanej ramki i wysyła przez OLED_SpiDma tylko zmienione
+// wiersze, sklejone w najwyżej 8 okien. Wymaga DMA (bez niego zostaje 1bpp).
+
+#ifndef ENABLE_OLED_GRAY
+#define ENABLE_OLED_GRAY 1
+#endif
+
+static const uint8_t OLED_GRAY_MAX = 15;   // najjaśniejszy poziom
+
+struct OledGrayStats {
+  uint32_t frames;       // wysłane ramki 4bpp (również bez zmian)
+  uint32_t framesIdle;   // ramki bez żadnego zmienionego wiersza
+  uint32_t rowsSent;     // wysłane wiersze pikseli (128 B każdy)
+  uint32_t convUs;       // średni czas 1bpp → 4bpp [us]
+  uint32_t flushUs;      // średni czas porównania i kolejkowania [us]
+  uint32_t maxFlushUs;
+};
+
+bool oledGrayBegin();          // bufory ramki i cienia (16 KB); false = brak pamięci
+bool oledGrayReady();
+void oledGrayInvalidate();     // następna ramka 4bpp pójdzie w całości
+
+// Początek klatki: płótno 1bpp (układ bufora u8g2) jako poziom level.
+// flip = płótno w U8G2_R2 – współrzędne rysowania poniżej są ekranowe.
+void oledGrayFrom1bpp(const uint8_t* buf, uint8_t level, bool flip);
+void oledGrayFillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint8_t level);
+// Gradient poziomy l0 → l1 na szerokości span; rysowane jest pierwsze w kolumn
+void oledGrayHGradient(int16_t x, int16_t y, int16_t w, int16_t h, int16_t span, uint8_t l0, uint8_t l1);
+
+// Wysłanie ramki – między oledSpiDmaFrameBegin() a oledSpiDmaFrameEnd()
+void oledGrayFlush();
+
+// Ostatnio wysłana ramka 4bpp jako bufor 1bpp w układzie u8g2 (piksel zapalony
+// = poziom >= minLevel) – do zrzutu /display.pbm; false = brak wysłanej ramki
+bool oledGrayTo1bpp(uint8_t* buf, uint8_t minLevel);
+
+void oledGrayGetStats(OledGrayStats* out);
+void oledGrayResetStats();
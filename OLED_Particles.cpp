@@ -0,0 +1,256 @@
+#include "OLED_Particles.h"
+#include "OLED_Columns.h"
+#include "OLED_Trig.h"
+
+#include <U8g2lib.h>
+#include <string.h>
+
+// ─────────────────────────────────────
+// Pula (SoA)
+// ─────────────────────────────────────
+static int16_t  pX[OLED_PARTICLES_MAX];      // Q4
+static int16_t  pY[OLED_PARTICLES_MAX];      // Q4
+static int8_t   pVx[OLED_PARTICLES_MAX];     // Q4 / klatkę
+static int8_t   pVy[OLED_PARTICLES_MAX];
+static uint8_t  pLife[OLED_PARTICLES_MAX];   // klatki do zgaśnięcia
+static uint8_t  pSize[OLED_PARTICLES_MAX];   // kubełek sprite'a
+static uint16_t pAlive = 0;
+
+static OledParticleStats pStats = {};
+static uint32_t pRng = 0x9E3779B9UL;
+
+// Krótka sekwencja pseudolosowa dla drgań – bez esp_random() co cząstkę
+static inline uint32_t particlesRand()
+{
+  pRng ^= pRng << 13;
+  pRng ^= pRng >> 17;
+  pRng ^= pRng << 5;
+  return pRng;
+}
+
+// ─────────────────────────────────────
+// Sprite'y gwiazdek
+// ─────────────────────────────────────
+static const int8_t PARTICLE_SPR_C = 15;     // środek w siatce 32x32
+
+static OledSprite sprites[OLED_PARTICLE_SIZES];
+static int8_t     sprOx[OLED_PARTICLE_SIZES];   // lewy górny róg względem środka
+static int8_t     sprOy[OLED_PARTICLE_SIZES];
+static uint32_t   sprKey   = 0;
+static bool       sprValid = false;
+
+static inline void sprPixel(OledSprite& s, int16_t x, int16_t y)
+{
+  if (x >= 0 && x < 32 && y >= 0 && y < 32) s.col[x] |= 1UL << y;
+}
+
+static void sprLine(OledSprite& s, int16_t x0, int16_t y0, int16_t x1, int16_t y1)
+{
+  const int16_t dx = abs(x1 - x0), sx = (x0 < x1) ? 1 : -1;
+  const int16_t dy = -abs(y1 - y0), sy = (y0 < y1) ? 1 : -1;
+  int16_t err = dx + dy;
+  for (;;)
+  {
+    sprPixel(s, x0, y0);
+    if (x0 == x1 && y0 == y1) break;
+    const int16_t e2 = 2 * err;
+    if (e2 >= dy) { err += dy; x0 += sx; }
+    if (e2 <= dx) { err += dx; y0 += sy; }
+  }
+}
+
+static void sprDisc(OledSprite& s, int16_t cx, int16_t cy, int16_t r)
+{
+  for (int16_t dy = -r; dy <= r; dy++)
+    for (int16_t dx = -r; dx <= r; dx++)
+      if (dx * dx + dy * dy <= r * r + r) sprPixel(s, cx + dx, cy + dy);
+}
+
+// Gwiazdka jak w dawnym stylu 9: środek, 6 ramion co 60°, dyszki ±45° na końcach
+static void sprStar(OledSprite& s, float starSize, bool filled, bool spikes)
+{
+  const int16_t c = PARTICLE_SPR_C;
+  if (filled) sprDisc(s, c, c, max(1, (int)(starSize * 0.2f)));
+  else        sprPixel(s, c, c);
+
+  int armLength = (int)(starSize * 0.8f);
+  if (armLength < 2) armLength = 2;
+
+  for (uint8_t arm = 0; arm < 6; arm++)
+  {
+    int32_t angle = ((int32_t)arm * TRIG_STEPS + 3) / 6;
+    int16_t ex = c + trigMulCos(armLength, angle);
+    int16_t ey = c + trigMulSin(armLength, angle);
+    sprLine(s, c, c, ex, ey);
+
+    if (spikes && starSize > 3.0f)
+    {
+      float spikeLength = starSize * 0.3f;
+      if (spikeLength < 2) spikeLength = 2;
+      int spikeLen = (int)(spikeLength + 0.5f);
+      int32_t a1 = angle - TRIG_STEPS / 8;
+      int32_t a2 = angle + TRIG_STEPS / 8;
+      sprLine(s, ex, ey, ex + trigMulCos(spikeLen, a1), ey + trigMulSin(spikeLen, a1));
+      sprLine(s, ex, ey, ex + trigMulCos(spikeLen, a2), ey + trigMulSin(spikeLen, a2));
+    }
+  }
+}
+
+// Obcięcie pustych kolumn i wierszy – mniej pracy przy kopiowaniu
+static void sprTrim(OledSprite& s, int8_t& ox, int8_t& oy)
+{
+  int8_t x0 = -1, x1 = -1;
+  uint32_t any = 0;
+  for (uint8_t x = 0; x < 32; x++)
+  {
+    if (!s.col[x]) continue;
+    if (x0 < 0) x0 = x;
+    x1 = x;
+    any |= s.col[x];
+  }
+  if (x0 < 0) { s.w = s.h = 0; ox = oy = 0; return; }
+
+  const uint8_t y0 = __builtin_ctz(any);
+  const uint8_t y1 = 31 - __builtin_clz(any);
+  s.w = x1 - x0 + 1;
+  s.h = y1 - y0 + 1;
+  for (uint8_t x = 0; x < s.w; x++) s.col[x] = s.col[x0 + x] >> y0;
+  ox = x0 - PARTICLE_SPR_C;
+  oy = y0 - PARTICLE_SPR_C;
+  oledSpriteFinish(s);
+}
+
+void particlesSprites(uint8_t minSize, uint8_t maxSize, bool filled, bool spikes)
+{
+  const uint32_t key = ((uint32_t)minSize << 16) | ((uint32_t)maxSize << 8) | (filled ? 2 : 0) | (spikes ? 1 : 0);
+  if (sprValid && key == sprKey) return;
+  if (maxSize < minSize) maxSize = minSize;
+
+  for (uint8_t b = 0; b < OLED_PARTICLE_SIZES; b++)
+  {
+    OledSprite& s = sprites[b];
+    memset(&s, 0, sizeof(s));
+    const float starSize = minSize + (float)(maxSize - minSize) * b / (OLED_PARTICLE_SIZES - 1);
+    sprStar(s, starSize, filled, spikes);
+    sprTrim(s, sprOx[b], sprOy[b]);
+  }
+  sprKey   = key;
+  sprValid = true;
+}
+
+// ─────────────────────────────────────
+// Cząstki
+// ─────────────────────────────────────
+bool particlesSpawn(int16_t x, int16_t y, int8_t vx, int8_t vy, uint8_t size, uint8_t life)
+{
+  if (pAlive >= OLED_PARTICLES_MAX)
+  {
+    pStats.dropped++;
+    return false;
+  }
+  const uint16_t i = pAlive++;
+  pX[i]    = x << OLED_PARTICLE_Q;
+  pY[i]    = y << OLED_PARTICLE_Q;
+  pVx[i]   = vx;
+  pVy[i]   = vy;
+  pLife[i] = life ? life : 1;
+  pSize[i] = (size < OLED_PARTICLE_SIZES) ? size : OLED_PARTICLE_SIZES - 1;
+  pStats.spawned++;
+  return true;
+}
+
+static inline void particlesKill(uint16_t i)
+{
+  const uint16_t last = --pAlive;
+  pX[i]    = pX[last];
+  pY[i]    = pY[last];
+  pVx[i]   = pVx[last];
+  pVy[i]   = pVy[last];
+  pLife[i] = pLife[last];
+  pSize[i] = pSize[last];
+}
+
+void particlesStep(int8_t gravity, int8_t maxVy, int8_t wobble)
+{
+  const int16_t bottom = (64 + 16) << OLED_PARTICLE_Q;   // cały sprite pod ekranem
+  const uint32_t span  = (uint32_t)(2 * wobble + 1);
+
+  uint16_t i = 0;
+  while (i < pAlive)
+  {
+    if (--pLife[i] == 0 || pY[i] > bottom)
+    {
+      particlesKill(i);   // na miejscu i jest teraz inna cząstka – bez i++
+      continue;
+    }
+
+    int16_t vy = pVy[i] + gravity;
+    if (vy > maxVy) vy = maxVy;
+    pVy[i] = (int8_t)vy;
+
+    int16_t vx = pVx[i];
+    if (wobble > 0) vx += (int16_t)(particlesRand() % span) - wobble;
+    if (vx >  2 * wobble) vx =  2 * wobble;
+    if (vx < -2 * wobble) vx = -2 * wobble;
+    pVx[i] = (int8_t)vx;
+
+    pX[i] += pVx[i];
+    pY[i] += pVy[i];
+
+    // pod koniec życia gwiazdka topnieje o kubełek co 4 klatki
+    if (pLife[i] < 16 && (pLife[i] & 3) == 0 && pSize[i] > 0) pSize[i]--;
+    i++;
+  }
+
+  pStats.alive = pAlive;
+  if (pAlive > pStats.maxAlive) pStats.maxAlive = pAlive;
+}
+
+void particlesDraw(U8G2& gfx)
+{
+  if (!sprValid) return;
+
+  OledColumns cols;
+  const bool direct = oledColumnsBegin(gfx, cols);
+  const int16_t half = 1 << (OLED_PARTICLE_Q - 1);
+
+  for (uint16_t i = 0; i < pAlive; i++)
+  {
+    const uint8_t b = pSize[i];
+    const OledSprite& s = sprites[b];
+    const int16_t x = ((pX[i] + half) >> OLED_PARTICLE_Q) + sprOx[b];
+    const int16_t y = ((pY[i] + half) >> OLED_PARTICLE_Q) + sprOy[b];
+
+    if (direct)
+    {
+      oledColumnsBlit(cols, x, y, s);
+      continue;
+    }
+    // bufor w innej rotacji – piksel po pikselu
+    for (uint8_t cx = 0; cx < s.w; cx++)
+      for (uint8_t cy = 0; cy < s.h; cy++)
+        if (s.col[cx] & (1UL << cy)) gfx.drawPixel(x + cx, y + cy);
+  }
+}
+
+void particlesClear()
+{
+  pAlive = 0;
+  pStats.alive = 0;
+}
+
+uint16_t particlesAlive()
+{
+  return pAlive;
+}
+
+void particlesGetStats(OledParticleStats* out)
+{
+  if (out) *out = pStats;
+}
+
+void particlesResetStats()
+{
+  memset(&pStats, 0, sizeof(pStats));
+  pStats.alive = pAlive;
+}
@@ -0,0 +1,43 @@
+#pragma once
+#include <Arduino.h>
+
+// Pula cząstek stylu 9 ("spadające gwiazdki").
+// Stała pojemność, tablice osobno dla każdego pola (SoA), bez sterty.
+// Żywe cząstki leżą zawsze w [0, alive) – usunięcie to przeniesienie
+// ostatniej na miejsce zgasłej, więc krok i rysowanie kosztują tyle,
+// ile jest cząstek, a najwyżej OLED_PARTICLES_MAX.
+// Pozycje i prędkości w Q4 (1/16 piksela), fizyka całkowita, jeden krok
+// na klatkę. Gwiazdki rysowane są z sprite'ów policzonych raz na rozmiar
+// (OLED_PARTICLE_SIZES kubełków) i kopiowanych maską kolumn (OLED_Columns).
+
+#ifndef OLED_PARTICLES_MAX
+#define OLED_PARTICLES_MAX 48
+#endif
+
+#define OLED_PARTICLE_SIZES 8   // kubełki rozmiaru sprite'ów
+#define OLED_PARTICLE_Q     4   // Q4: 16 = 1 piksel
+
+class U8G2;
+
+struct OledParticleStats {
+  uint32_t spawned;     // utworzone cząstki
+  uint32_t dropped;     // odrzucone – pula pełna
+  uint16_t alive;       // żywe w ostatniej klatce
+  uint16_t maxAlive;
+};
+
+// Sprite'y gwiazdek dla rozmiarów minSize..maxSize [px]; przelicza tylko
+// przy zmianie parametrów (wygląd z dawnego stylu 9: ramiona, dyszki, środek)
+void particlesSprites(uint8_t minSize, uint8_t maxSize, bool filled, bool spikes);
+
+// x, y w pikselach (środek gwiazdki), vx/vy w Q4 na klatkę, size 0..SIZES-1
+bool particlesSpawn(int16_t x, int16_t y, int8_t vx, int8_t vy, uint8_t size, uint8_t life);
+
+// Krok fizyki: grawitacja i prędkość graniczna w Q4, drganie poziome ±wobble
+void particlesStep(int8_t gravity, int8_t maxVy, int8_t wobble);
+void particlesDraw(U8G2& gfx);
+void particlesClear();
+
+uint16_t particlesAlive();
+void particlesGetStats(OledParticleStats* out);
+void particlesResetStats();
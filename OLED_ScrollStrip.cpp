@@ -0,0 +1,198 @@
+#include "OLED_ScrollStrip.h"
+#include "OLED_Columns.h"
+#include "OLED_BgCache.h"          // oledBgHash()
+
+#include <U8g2lib.h>
+#include <string.h>
+
+static const uint16_t STRIP_ROW_BYTES = 256;
+static const uint16_t STRIP_BUF_BYTES = 256 * 64 / 8;
+
+// Płótno do rasteryzacji – ta sama rotacja co wyświetlacz, własny bufor
+// (instancje tego samego wyświetlacza dzielą statyczny bufor u8g2)
+static U8G2_SSD1322_NHD_256X64_F_4W_HW_SPI stripCanvas(U8G2_R2, U8X8_PIN_NONE, U8X8_PIN_NONE, U8X8_PIN_NONE);
+
+struct ScrollStrip {
+  uint8_t* ink;       // [rows][period] zapalone piksele (układ bufora)
+  uint8_t* cover;     // [rows][period] piksele nadpisane przez glify
+  size_t   cap;       // zaalokowane bajty na każdą z masek
+  uint16_t period;
+  uint8_t  row0;      // pierwszy wiersz kafelków pasma
+  uint8_t  rows;      // liczba wierszy kafelków pasma
+  bool     flip;
+  uint32_t key;
+  bool     keyValid;  // key opisuje ostatnią próbę (również nieudaną)
+  bool     valid;
+};
+
+static ScrollStrip strip = {};
+
+static bool stripAlloc(size_t bytes)
+{
+  if (strip.cap >= bytes) return true;
+  free(strip.ink);
+  free(strip.cover);
+  strip.ink = strip.cover = nullptr;
+  strip.cap = 0;
+
+  strip.ink   = (uint8_t*)ps_malloc(bytes);
+  strip.cover = (uint8_t*)ps_malloc(bytes);
+  if (!strip.ink)   strip.ink   = (uint8_t*)malloc(bytes);
+  if (!strip.cover) strip.cover = (uint8_t*)malloc(bytes);
+  if (!strip.ink || !strip.cover) return false;
+  strip.cap = bytes;
+  return true;
+}
+
+// Rasteryzacja jednego kawałka tekstu (256 px) do bufora płótna wypełnionego fill
+static void stripRenderChunk(uint8_t* cbuf, uint8_t fill, uint16_t c0, uint8_t y, const char* text)
+{
+  memset(cbuf, fill, STRIP_BUF_BYTES);
+  stripCanvas.drawStr((u8g2_uint_t)(0 - c0), y, text);   // ujemne x przez zawinięcie – jak w scrollerze
+}
+
+static bool stripBuild(const char* text, uint16_t period, uint8_t y, const uint8_t* font)
+{
+  uint8_t* cbuf = (uint8_t*)malloc(STRIP_BUF_BYTES);
+  if (!cbuf) return false;
+  stripCanvas.getU8g2()->tile_buf_ptr = cbuf;
+
+  OledColumns cols;
+  if (!oledColumnsBegin(stripCanvas, cols)) { free(cbuf); return false; }
+
+  stripCanvas.setFont(font);
+  stripCanvas.setFontMode(0);
+  stripCanvas.setDrawColor(1);
+
+  // Pasmo wierszy: od góry najwyższego glifu do dolnych ogonków (z zapasem);
+  // gdyby coś wyszło poza pasmo, budowa się nie udaje i zostaje drawStr()
+  int16_t h = stripCanvas.getMaxCharHeight();
+  int16_t yTop = y - h;
+  int16_t yBot = y + h / 2;
+  if (yTop < 0)  yTop = 0;
+  if (yBot > 63) yBot = 63;
+  uint64_t band = oledColumnsSpan(cols, yTop, yBot);
+  uint8_t r0 = 8, r1 = 0;
+  for (uint8_t r = 0; r < 8; r++)
+  {
+    if (!((band >> (r * 8)) & 0xFF)) continue;
+    if (r < r0) r0 = r;
+    r1 = r + 1;
+  }
+  if (r1 <= r0) { free(cbuf); return false; }
+
+  const uint8_t rows = r1 - r0;
+  if (!stripAlloc((size_t)rows * period)) { free(cbuf); return false; }
+
+  bool ok = true;
+  for (uint16_t c0 = 0; c0 < period && ok; c0 += STRIP_ROW_BYTES)
+  {
+    const uint16_t n = (period - c0 < STRIP_ROW_BYTES) ? (period - c0) : STRIP_ROW_BYTES;
+
+    // 1) zapalone piksele – płótno wyczyszczone
+    stripRenderChunk(cbuf, 0x00, c0, y, text);
+    for (uint8_t r = 0; r < 8 && ok; r++)
+    {
+      const uint8_t* src = cbuf + r * STRIP_ROW_BYTES;
+      if (r < r0 || r >= r1)
+      {
+        for (uint16_t px = 0; px < STRIP_ROW_BYTES; px++) if (src[px]) { ok = false; break; }
+        continue;
+      }
+      uint8_t* dst = strip.ink + (r - r0) * period;
+      for (uint16_t x = 0; x < n; x++)
+      {
+        uint16_t u = c0 + x;
+        dst[cols.flip ? period - 1 - u : u] = src[cols.flip ? 255 - x : x];
+      }
+    }
+
+    // 2) pokrycie – płótno zapalone, tło glifów (font mode solid) gasi piksele
+    stripRenderChunk(cbuf, 0xFF, c0, y, text);
+    for (uint8_t r = 0; r < 8 && ok; r++)
+    {
+      const uint8_t* src = cbuf + r * STRIP_ROW_BYTES;
+      if (r < r0 || r >= r1)
+      {
+        for (uint16_t px = 0; px < STRIP_ROW_BYTES; px++) if (src[px] != 0xFF) { ok = false; break; }
+        continue;
+      }
+      const uint8_t* ink = strip.ink + (r - r0) * period;
+      uint8_t* dst = strip.cover + (r - r0) * period;
+      for (uint16_t x = 0; x < n; x++)
+      {
+        uint16_t u = c0 + x;
+        uint16_t j = cols.flip ? period - 1 - u : u;
+        dst[j] = ink[j] | (uint8_t)~src[cols.flip ? 255 - x : x];
+      }
+    }
+  }
+
+  free(cbuf);
+  stripCanvas.getU8g2()->tile_buf_ptr = nullptr;
+  if (!ok) return false;
+
+  strip.period = period;
+  strip.row0   = r0;
+  strip.rows   = rows;
+  strip.flip   = cols.flip;
+  return true;
+}
+
+bool scrollStripPrepare(const char* text, uint16_t period, uint8_t y, const uint8_t* font)
+{
+#if ENABLE_OLED_SCROLL_STRIP
+  uint32_t key = oledBgHash(OLED_BG_HASH_INIT, text, strlen(text));
+  key = oledBgHash(key, &period, sizeof(period));
+  key = oledBgHash(key, &y, sizeof(y));
+  key = oledBgHash(key, &font, sizeof(font));
+  if (strip.keyValid && strip.key == key) return strip.valid;
+
+  strip.key      = key;
+  strip.keyValid = true;
+  strip.valid    = false;
+  if (period == 0 || period > SCROLL_STRIP_MAX_PX || !text[0]) return false;
+  strip.valid = stripBuild(text, period, y, font);
+  return strip.valid;
+#else
+  (void)text; (void)period; (void)y; (void)font;
+  return false;
+#endif
+}
+
+bool scrollStripDraw(U8G2& gfx, int16_t pos)
+{
+#if ENABLE_OLED_SCROLL_STRIP
+  if (!strip.valid) return false;
+  OledColumns cols;
+  if (!oledColumnsBegin(gfx, cols) || cols.flip != strip.flip) return false;
+
+  // Kolumna paska dla px = 0; dalej kolejne px to kolejne kolumny paska
+  const uint16_t w = strip.period;
+  int32_t u0 = (cols.flip ? (255 - (int32_t)pos) : -(int32_t)pos) % w;
+  if (u0 < 0) u0 += w;
+  const uint16_t j0 = cols.flip ? (w - 1 - u0) : u0;
+
+  for (uint8_t k = 0; k < strip.rows; k++)
+  {
+    uint8_t*       dst = cols.buf + (strip.row0 + k) * STRIP_ROW_BYTES;
+    const uint8_t* ink = strip.ink   + k * w;
+    const uint8_t* cov = strip.cover + k * w;
+
+    uint16_t px = 0;
+    uint16_t j  = j0;
+    while (px < STRIP_ROW_BYTES)
+    {
+      uint16_t n = w - j;
+      if (n > STRIP_ROW_BYTES - px) n = STRIP_ROW_BYTES - px;
+      for (uint16_t i = 0; i < n; i++) dst[px + i] = (dst[px + i] & ~cov[j + i]) | ink[j + i];
+      px += n;
+      j = 0;
+    }
+  }
+  return true;
+#else
+  (void)gfx; (void)pos;
+  return false;
+#endif
+}
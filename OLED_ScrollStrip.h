@@ -0,0 +1,27 @@
+#pragma once
+#include <Arduino.h>
+
+// Przewijany tekst stacji (scroller trybów 0, 1 i 3) renderowany raz do
+// paska 1bpp o szerokości jednego okresu przewijania. Krok przewijania to
+// potem tylko skopiowanie 256 kolumn paska (z zawinięciem) w pasmo wierszy
+// bufora u8g2 – bez rasteryzowania kilkuset znaków co 50 ms.
+// Pasek trzyma dwie maski: zapalone piksele i piksele pokryte glifami
+// (tło glifu w trybie solid), więc wynik jest identyczny z drawStr().
+
+#ifndef ENABLE_OLED_SCROLL_STRIP
+#define ENABLE_OLED_SCROLL_STRIP 1   // 0 = scroller zawsze przez drawStr()
+#endif
+
+#ifndef SCROLL_STRIP_MAX_PX
+#define SCROLL_STRIP_MAX_PX 3072     // dłuższe teksty przewijane po staremu
+#endif
+
+class U8G2;
+
+// Pasek dla tekstu (period = szerokość powtórzenia w px, y = linia bazowa).
+// Renderuje tylko gdy zmienił się tekst, okres, y albo font. false = brak paska.
+bool scrollStripPrepare(const char* text, uint16_t period, uint8_t y, const uint8_t* font);
+
+// Pasek z początkiem tekstu w x = pos (jak drawStr() powtarzany co period).
+// false = paska brak albo nie pasuje do bufora – wtedy drawStr() jak dawniej.
+bool scrollStripDraw(U8G2& gfx, int16_t pos);
@@ -0,0 +1,295 @@
+#include "OLED_SpiDma.h"
+
+#include <U8g2lib.h>
+#include <string.h>
+#include "driver/spi_master.h"
+#include "driver/gpio.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "esp_heap_caps.h"
+
+extern U8G2_SSD1322_NHD_256X64_F_4W_HW_SPI u8g2;
+
+// ─────────────────────────────────────
+// Bufory i transakcje
+// ─────────────────────────────────────
+// Ramka to najwyżej 8 okien (po jednym na wiersz kafelków), okno to
+// 6 transakcji: 0x15 | kolumny | 0x75 | wiersze | 0x5C | dane 4bpp.
+static const uint16_t OLED_DMA_ROW_BYTES  = 256;            // wiersz kafelków w buforze u8g2
+static const uint8_t  OLED_DMA_ROWS       = 8;
+static const uint8_t  OLED_DMA_TRANS_SPAN = 6;
+static const uint16_t OLED_DMA_MAX_TRANS  = OLED_DMA_ROWS * OLED_DMA_TRANS_SPAN;
+static const uint16_t OLED_DMA_BUF_BYTES  = 256 * 64 / 2;   // cały ekran w 4bpp
+
+// user transakcji = poziom DC ustawiany w pre_cb
+#define OLED_DC_CMD   0
+#define OLED_DC_DATA  1
+
+static spi_device_handle_t oledDev       = nullptr;
+static SemaphoreHandle_t   oledBusMutex  = nullptr;   // rekurencyjny: ramka DMA + ruch u8x8
+static uint8_t*            oledDmaBuf    = nullptr;
+static uint16_t            oledDmaUsed   = 0;         // bajty bufora zajęte w bieżącej ramce
+static spi_transaction_t   oledTrans[OLED_DMA_MAX_TRANS];
+static uint16_t            oledTransUsed = 0;         // transakcje użyte w bieżącej ramce
+static uint16_t            oledPending   = 0;         // zakolejkowane, jeszcze nieodebrane
+static int                 oledPinDc     = -1;
+static uint8_t             oledDcLevel   = 0;         // ostatni U8X8_MSG_BYTE_SET_DC
+static OledSpiDmaStats     oledDmaStats  = {};
+
+// 2 bity wejścia (piksel parzysty, nieparzysty) → bajt 4bpp, parzysty w starszej połówce
+static const uint8_t oledNibble[4] = { 0x00, 0x0F, 0xF0, 0xFF };
+
+static void IRAM_ATTR oledSpiPre(spi_transaction_t* t)
+{
+  gpio_set_level((gpio_num_t)oledPinDc, (uint32_t)(uintptr_t)t->user);
+}
+
+static void oledCs(bool on)
+{
+  u8x8_t* u8x8 = u8g2.getU8x8();
+  u8x8_gpio_SetCS(u8x8, on ? u8x8->display_info->chip_enable_level : u8x8->display_info->chip_disable_level);
+}
+
+// Odbierz wszystkie zakolejkowane transfery (pod oledBusMutex)
+static void oledDrain()
+{
+  if (oledPending == 0) return;
+  spi_transaction_t* done;
+  while (oledPending > 0)
+  {
+    spi_device_get_trans_result(oledDev, &done, portMAX_DELAY);
+    oledPending--;
+  }
+  oledCs(false);
+}
+
+static void oledFillTrans(spi_transaction_t* t, const uint8_t* data, uint16_t len, uint8_t dc)
+{
+  memset(t, 0, sizeof(*t));
+  t->length = (size_t)len * 8;
+  t->user   = (void*)(uintptr_t)dc;
+  if (len <= 4)
+  {
+    t->flags = SPI_TRANS_USE_TXDATA;
+    memcpy(t->tx_data, data, len);
+  }
+  else
+  {
+    t->tx_buffer = data;
+  }
+}
+
+static void oledQueue(const uint8_t* data, uint16_t len, uint8_t dc)
+{
+  spi_transaction_t* t = &oledTrans[oledTransUsed++];
+  oledFillTrans(t, data, len, dc);
+  if (spi_device_queue_trans(oledDev, t, portMAX_DELAY) == ESP_OK) oledPending++;
+}
+
+// ─────────────────────────────────────
+// Byte callback u8x8 (init, kontrast, power save, ew. sendBuffer)
+// ─────────────────────────────────────
+// Krótkie transfery w trybie polling; najpierw czekamy na zakolejkowaną
+// ramkę DMA, żeby komendy nie wcięły się w środek okna.
+static uint8_t oledByteCb(u8x8_t* u8x8, uint8_t msg, uint8_t arg_int, void* arg_ptr)
+{
+  switch (msg)
+  {
+    case U8X8_MSG_BYTE_INIT:
+      u8x8_gpio_SetCS(u8x8, u8x8->display_info->chip_disable_level);
+      break;
+    case U8X8_MSG_BYTE_SET_DC:
+      oledDcLevel = arg_int;
+      break;
+    case U8X8_MSG_BYTE_START_TRANSFER:
+      xSemaphoreTakeRecursive(oledBusMutex, portMAX_DELAY);
+      oledDrain();
+      u8x8_gpio_SetCS(u8x8, u8x8->display_info->chip_enable_level);
+      break;
+    case U8X8_MSG_BYTE_SEND:
+    {
+      spi_transaction_t t;
+      oledFillTrans(&t, (const uint8_t*)arg_ptr, arg_int, oledDcLevel);
+      spi_device_polling_transmit(oledDev, &t);
+      break;
+    }
+    case U8X8_MSG_BYTE_END_TRANSFER:
+      u8x8_gpio_SetCS(u8x8, u8x8->display_info->chip_disable_level);
+      xSemaphoreGiveRecursive(oledBusMutex);
+      break;
+    default:
+      return 0;
+  }
+  return 1;
+}
+
+// ─────────────────────────────────────
+// API
+// ─────────────────────────────────────
+bool oledSpiDmaBegin(int8_t sck, int8_t mosi)
+{
+#if ENABLE_OLED_SPI_DMA
+  if (oledDev) return true;
+
+  u8x8_t* u8x8 = u8g2.getU8x8();
+  if (u8x8->pins[U8X8_PIN_DC] == U8X8_PIN_NONE) return false;
+  oledPinDc = u8x8->pins[U8X8_PIN_DC];
+
+  if (!oledDmaBuf)   oledDmaBuf   = (uint8_t*)heap_caps_malloc(OLED_DMA_BUF_BYTES, MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
+  if (!oledBusMutex) oledBusMutex = xSemaphoreCreateRecursiveMutex();
+  if (!oledDmaBuf || !oledBusMutex) return false;
+
+  spi_bus_config_t bus;
+  memset(&bus, 0, sizeof(bus));
+  bus.mosi_io_num     = mosi;
+  bus.miso_io_num     = -1;
+  bus.sclk_io_num     = sck;
+  bus.quadwp_io_num   = -1;
+  bus.quadhd_io_num   = -1;
+  bus.max_transfer_sz = OLED_DMA_BUF_BYTES;
+  if (spi_bus_initialize(SPI2_HOST, &bus, SPI_DMA_CH_AUTO) != ESP_OK) return false;
+
+  // CS steruje u8x8 (pinMode w u8g2.begin()), DC ustawia pre_cb
+  spi_device_interface_config_t dev;
+  memset(&dev, 0, sizeof(dev));
+  dev.clock_speed_hz = OLED_SPI_CLOCK_HZ;
+  dev.mode           = 0;
+  dev.spics_io_num   = -1;
+  dev.queue_size     = OLED_DMA_MAX_TRANS;
+  dev.pre_cb         = oledSpiPre;
+  if (spi_bus_add_device(SPI2_HOST, &dev, &oledDev) != ESP_OK)
+  {
+    oledDev = nullptr;
+    spi_bus_free(SPI2_HOST);
+    return false;
+  }
+
+  u8x8->byte_cb = oledByteCb;
+  return true;
+#else
+  (void)sck;
+  (void)mosi;
+  return false;
+#endif
+}
+
+bool oledSpiDmaActive()
+{
+  return oledDev != nullptr;
+}
+
+void oledSpiDmaFrameBegin()
+{
+  if (!oledDev) return;
+  xSemaphoreTakeRecursive(oledBusMutex, portMAX_DELAY);
+
+  uint32_t t0 = micros();
+  oledDrain();
+  uint32_t us = micros() - t0;
+
+  oledDmaStats.frames++;
+  oledDmaStats.waitUs = (oledDmaStats.frames == 1) ? us : (oledDmaStats.waitUs * 15 + us) / 16;
+  if (us > oledDmaStats.maxWaitUs) oledDmaStats.maxWaitUs = us;
+
+  oledDmaUsed   = 0;
+  oledTransUsed = 0;
+}
+
+bool oledSpiDmaSendSpan(const uint8_t* buf, uint8_t tx, uint8_t ty, uint8_t tw)
+{
+  if (!oledDev || tw == 0) return false;
+
+  const uint16_t stride = (uint16_t)tw * 4;   // bajty 4bpp na linię pikseli
+  const uint16_t len    = stride * 8;
+  if (oledDmaUsed + len > OLED_DMA_BUF_BYTES) return false;
+  if (oledTransUsed + OLED_DMA_TRANS_SPAN > OLED_DMA_MAX_TRANS) return false;
+
+  // Kafelek u8g2: 8 bajtów = 8 kolumn po 8 pikseli w pionie (LSB u góry).
+  // SSD1322 w oknie pisze linia po linii, 2 piksele na bajt – to samo co
+  // u8x8_ssd1322_8to32(), tylko dla całego okna naraz.
+  uint8_t* dst = oledDmaBuf + oledDmaUsed;
+  const uint8_t* tile = buf + ty * OLED_DMA_ROW_BYTES + tx * 8;
+  for (uint8_t t = 0; t < tw; t++, tile += 8)
+  {
+    for (uint8_t j = 0; j < 4; j++)
+    {
+      uint8_t a = tile[2 * j];
+      uint8_t b = tile[2 * j + 1];
+      uint8_t* d = dst + t * 4 + j;
+      for (uint8_t i = 0; i < 8; i++)
+      {
+        *d = oledNibble[((a & 1) << 1) | (b & 1)];
+        d += stride;
+        a >>= 1;
+        b >>= 1;
+      }
+    }
+  }
+
+  const uint8_t x = tx * 2 + u8g2.getU8x8()->x_offset;   // adres kolumny = 4 piksele
+  const uint8_t y = ty * 8;
+  const uint8_t cmdCol = 0x15, cmdRow = 0x75, cmdWrite = 0x5C;
+  const uint8_t col[2] = { x, (uint8_t)(x + tw * 2 - 1) };
+  const uint8_t row[2] = { y, (uint8_t)(y + 7) };
+
+  if (oledPending == 0) oledCs(true);
+  oledQueue(&cmdCol,   1,   OLED_DC_CMD);
+  oledQueue(col,       2,   OLED_DC_DATA);
+  oledQueue(&cmdRow,   1,   OLED_DC_CMD);
+  oledQueue(row,       2,   OLED_DC_DATA);
+  oledQueue(&cmdWrite, 1,   OLED_DC_CMD);
+  oledQueue(dst,       len, OLED_DC_DATA);
+
+  oledDmaUsed += len;
+  oledDmaStats.spans++;
+  oledDmaStats.bytes += len;
+  return true;
+}
+
+bool oledSpiDmaSendRows(const uint8_t* rows, uint8_t y, uint8_t n)
+{
+  if (!oledDev || n == 0 || y + n > 64) return false;
+
+  const uint16_t len = (uint16_t)n * 128;
+  if (oledDmaUsed + len > OLED_DMA_BUF_BYTES) return false;
+  if (oledTransUsed + OLED_DMA_TRANS_SPAN > OLED_DMA_MAX_TRANS) return false;
+
+  // kopia: źródło zmienia się przy rysowaniu następnej klatki, a transfer
+  // odbiera dopiero następne oledSpiDmaFrameBegin()
+  uint8_t* dst = oledDmaBuf + oledDmaUsed;
+  memcpy(dst, rows, len);
+
+  const uint8_t x = u8g2.getU8x8()->x_offset;
+  const uint8_t cmdCol = 0x15, cmdRow = 0x75, cmdWrite = 0x5C;
+  const uint8_t col[2] = { x, (uint8_t)(x + 64 - 1) };   // 256 pikseli = 64 adresy kolumn
+  const uint8_t row[2] = { y, (uint8_t)(y + n - 1) };
+
+  if (oledPending == 0) oledCs(true);
+  oledQueue(&cmdCol,   1,   OLED_DC_CMD);
+  oledQueue(col,       2,   OLED_DC_DATA);
+  oledQueue(&cmdRow,   1,   OLED_DC_CMD);
+  oledQueue(row,       2,   OLED_DC_DATA);
+  oledQueue(&cmdWrite, 1,   OLED_DC_CMD);
+  oledQueue(dst,       len, OLED_DC_DATA);
+
+  oledDmaUsed += len;
+  oledDmaStats.spans++;
+  oledDmaStats.bytes += len;
+  return true;
+}
+
+void oledSpiDmaFrameEnd()
+{
+  if (!oledDev) return;
+  xSemaphoreGiveRecursive(oledBusMutex);   // transfer leci dalej, odbierze go następna ramka
+}
+
+void oledSpiDmaGetStats(OledSpiDmaStats* out)
+{
+  if (out) *out = oledDmaStats;
+}
+
+void oledSpiDmaResetStats()
+{
+  memset(&oledDmaStats, 0, sizeof(oledDmaStats));
+}
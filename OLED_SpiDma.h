@@ -0,0 +1,43 @@
+#pragma once
+#include <Arduino.h>
+
+// SSD1322 przez sterownik spi_master z ESP-IDF (DMA) zamiast SPIClass.
+// oledFlush()/zadanie renderujące zamieniają zmienione wiersze kafelków na
+// 4bpp w buforze DMA i tylko kolejkują transfer – CPU nie kręci się w pętli
+// SPI. Na koniec transferu czeka dopiero następna ramka (oledSpiDmaFrameBegin).
+// Pozostały ruch u8x8 (init, kontrast, power save) idzie tym samym
+// urządzeniem przez własny byte callback, więc nic się nie przeplata.
+
+#ifndef ENABLE_OLED_SPI_DMA
+#define ENABLE_OLED_SPI_DMA 1          // 0 = jak dawniej, SPIClass + u8x8_byte_arduino_hw_spi
+#endif
+
+#ifndef OLED_SPI_CLOCK_HZ
+#define OLED_SPI_CLOCK_HZ 10000000     // SSD1322 wg noty 10 MHz; większość paneli działa też na 16-20 MHz
+#endif
+
+struct OledSpiDmaStats {
+  uint32_t frames;        // ramki wysłane przez DMA
+  uint32_t spans;         // zakolejkowane okna (wiersz kafelków)
+  uint32_t bytes;         // bajty danych 4bpp
+  uint32_t waitUs;        // średnie czekanie na koniec poprzedniej ramki [us]
+  uint32_t maxWaitUs;
+};
+
+// Przed u8g2.begin(): zajmuje SPI2 (FSPI) i podmienia byte callback u8g2.
+// false = brak DMA (wyłączone albo błąd) – wtedy zwykłe SPI.begin().
+bool oledSpiDmaBegin(int8_t sck, int8_t mosi);
+bool oledSpiDmaActive();
+
+// Ramka: Begin czeka na poprzednie transfery i blokuje magistralę,
+// SendSpan kolejkuje okno tw kafelków z wiersza ty, End zwalnia magistralę
+// (transfer leci dalej w tle).
+void oledSpiDmaFrameBegin();
+bool oledSpiDmaSendSpan(const uint8_t* buf, uint8_t tx, uint8_t ty, uint8_t tw);
+// Wiersze pikseli już w formacie SSD1322 (128 B na wiersz, 4bpp) – okno
+// pełnej szerokości od wiersza y (ramka w skali szarości, OLED_Gray)
+bool oledSpiDmaSendRows(const uint8_t* rows, uint8_t y, uint8_t n);
+void oledSpiDmaFrameEnd();
+
+void oledSpiDmaGetStats(OledSpiDmaStats* out);
+void oledSpiDmaResetStats();
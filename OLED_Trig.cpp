@@ -0,0 +1,19 @@
+#include "OLED_Trig.h"
+#include <math.h>
+
+int16_t trigSinTab[TRIG_STEPS];
+
+void trigInit()
+{
+  static bool done = false;
+  if (done) return;
+
+  for (uint16_t i = 0; i < TRIG_STEPS; i++)
+  {
+    float s = sinf((float)i * (2.0f * (float)M_PI / (float)TRIG_STEPS));
+    int32_t q = (int32_t)lrintf(s * (float)(1 << TRIG_SHIFT));
+    if (q > 32767) q = 32767;
+    trigSinTab[i] = (int16_t)q;
+  }
+  done = true;
+}
@@ -0,0 +1,31 @@
+#pragma once
+#include <Arduino.h>
+
+// Stałoprzecinkowy sin/cos dla rysowania (wskazówki VU, style 7 i 9).
+// Pełny obrót = TRIG_STEPS kroków, wartości w Q14 (16384 = 1.0).
+// Tablicę wypełnia trigInit() raz w setup() – potem tylko odczyt,
+// więc mogą z niej korzystać jednocześnie loop() i zadanie OLED.
+
+static const uint16_t TRIG_STEPS = 1024;            // kroków na 360°
+static const uint16_t TRIG_MASK  = TRIG_STEPS - 1;
+static const uint8_t  TRIG_SHIFT = 14;              // Q14
+static const uint16_t TRIG_QUARTER = TRIG_STEPS / 4;
+
+extern int16_t trigSinTab[TRIG_STEPS];
+
+void trigInit();
+
+// kąt w krokach (może być ujemny lub > TRIG_STEPS)
+static inline int16_t trigSinQ14(int32_t idx) { return trigSinTab[idx & TRIG_MASK]; }
+static inline int16_t trigCosQ14(int32_t idx) { return trigSinTab[(idx + TRIG_QUARTER) & TRIG_MASK]; }
+
+// stopnie → kroki (z zaokrągleniem, również dla ujemnych)
+static inline int32_t trigDegToIdx(int32_t deg)
+{
+  int32_t n = deg * (int32_t)TRIG_STEPS;
+  return (n >= 0) ? (n + 180) / 360 : -((-n + 180) / 360);
+}
+
+// r · sin / r · cos w pikselach (zaokrąglone)
+static inline int16_t trigMulSin(int16_t r, int32_t idx) { return (int16_t)(((int32_t)r * trigSinQ14(idx) + (1 << (TRIG_SHIFT - 1))) >> TRIG_SHIFT); }
+static inline int16_t trigMulCos(int16_t r, int32_t idx) { return (int16_t)(((int32_t)r * trigCosQ14(idx) + (1 << (TRIG_SHIFT - 1))) >> TRIG_SHIFT); }
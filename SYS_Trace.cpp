@@ -0,0 +1,241 @@
+#include "SYS_Trace.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <string.h>
+
+// ─────────────────────────────────────
+// Pierścień (ograniczona kolejka MPMC z numerem w każdym slocie)
+// ─────────────────────────────────────
+// Slot i jest wolny dla pozycji pos, gdy seq == pos; producent rezerwuje
+// pozycję CAS-em na głowie, wypełnia slot i ustawia seq = pos + 1.
+// Konsument (jedno zadanie) czyta slot, gdy seq == tail + 1, i oddaje go
+// z seq = tail + SIZE. Żadnych sekcji krytycznych – callback audio nie
+// zatrzyma się na rekordzie, który właśnie pisze inne zadanie.
+// Długi tekst TRACE_S rezerwuje naraz 'parts' kolejnych pozycji (konsument
+// zwalnia sloty po kolei, więc wolny ostatni = wolne wszystkie); sloty
+// kontynuacji niosą tylko txt i są publikowane przed pierwszym.
+
+static_assert((TRACE_RING_SIZE & (TRACE_RING_SIZE - 1)) == 0, "TRACE_RING_SIZE musi być potęgą 2");
+
+struct TraceRecord {
+  uint32_t    seq;
+  uint32_t    us;
+  const char* fmt;
+  int32_t     a;
+  int32_t     b;
+  uint8_t     cat;
+  uint8_t     level;
+  uint8_t     core;
+  uint8_t     hasTxt;
+  uint8_t     parts;      // slotów rekordu (1 + kontynuacje tekstu)
+  uint8_t     txtLen;     // długość całego tekstu (<= TRACE_TXT_LIMIT)
+  char        txt[TRACE_TXT_MAX];
+};
+
+static_assert(TRACE_TXT_LIMIT <= 255 && TRACE_TXT_SLOTS < TRACE_RING_SIZE, "TRACE_TXT_SLOTS za duże");
+
+static TraceRecord traceRing[TRACE_RING_SIZE];
+static uint32_t    traceHead = 0;
+static uint32_t    traceTail = 0;
+static bool        traceRingReady = false;
+static TaskHandle_t traceTask = nullptr;
+
+static uint32_t traceWritten = 0;
+static uint32_t traceDropped = 0;
+static uint32_t traceDrained = 0;
+static uint32_t traceMaxPending = 0;
+
+uint32_t traceMask  = 0xFFFFFFFFUL;
+uint8_t  traceLevel = TRACE_INFO;
+
+static const char* const kTraceCatNames[TRACE_CATEGORIES] = {
+  "SYS", "AUDIO", "STATION", "DISPLAY", "ANALYZER", "NET", "STORAGE", "INPUT"
+};
+static const char kTraceLevelChars[] = "?EWID";
+
+static void traceRingInit()
+{
+  for (uint32_t i = 0; i < TRACE_RING_SIZE; i++) traceRing[i].seq = i;
+  traceRingReady = true;
+}
+
+bool traceWrite(uint8_t cat, uint8_t level, const char* fmt, const char* txt, int32_t a, int32_t b)
+{
+  if (!traceRingReady || cat >= TRACE_CATEGORIES) return false;
+
+  const uint32_t len   = txt ? strnlen(txt, TRACE_TXT_LIMIT) : 0;
+  const uint32_t parts = len ? (len + TRACE_TXT_MAX - 1) / TRACE_TXT_MAX : 1;
+
+  uint32_t pos = __atomic_load_n(&traceHead, __ATOMIC_RELAXED);
+  TraceRecord* r;
+  for (;;)
+  {
+    r = &traceRing[pos & (TRACE_RING_SIZE - 1)];
+    const uint32_t seq = __atomic_load_n(&r->seq, __ATOMIC_ACQUIRE);
+    const int32_t diff = (int32_t)(seq - pos);
+    if (diff == 0)
+    {
+      // ostatni potrzebny slot też musi być już oddany przez konsumenta
+      const TraceRecord* last = &traceRing[(pos + parts - 1) & (TRACE_RING_SIZE - 1)];
+      if (parts > 1 && __atomic_load_n(&last->seq, __ATOMIC_ACQUIRE) != pos + parts - 1)
+      {
+        __atomic_fetch_add(&traceDropped, 1, __ATOMIC_RELAXED);
+        return false;
+      }
+      if (__atomic_compare_exchange_n(&traceHead, &pos, pos + parts, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) break;
+    }
+    else if (diff < 0)
+    {
+      __atomic_fetch_add(&traceDropped, 1, __ATOMIC_RELAXED);   // pełny – nie czekamy
+      return false;
+    }
+    else
+    {
+      pos = __atomic_load_n(&traceHead, __ATOMIC_RELAXED);
+    }
+  }
+
+  // kontynuacje tekstu – gotowe, zanim konsument zobaczy pierwszy slot
+  for (uint32_t k = 1; k < parts; k++)
+  {
+    TraceRecord* c = &traceRing[(pos + k) & (TRACE_RING_SIZE - 1)];
+    const uint32_t off = k * TRACE_TXT_MAX;
+    memcpy(c->txt, txt + off, (len - off < TRACE_TXT_MAX) ? len - off : TRACE_TXT_MAX);
+    __atomic_store_n(&c->seq, pos + k + 1, __ATOMIC_RELEASE);
+  }
+
+  r->us    = micros();
+  r->fmt   = fmt;
+  r->a     = a;
+  r->b     = b;
+  r->cat   = cat;
+  r->level = level;
+  r->core  = (uint8_t)xPortGetCoreID();
+  r->hasTxt = txt ? 1 : 0;
+  r->parts  = (uint8_t)parts;
+  r->txtLen = (uint8_t)len;
+  if (txt) memcpy(r->txt, txt, (len < TRACE_TXT_MAX) ? len : TRACE_TXT_MAX);
+  __atomic_store_n(&r->seq, pos + 1, __ATOMIC_RELEASE);
+  __atomic_fetch_add(&traceWritten, 1, __ATOMIC_RELAXED);
+  return true;
+}
+
+// Jeden rekord → Serial; false = pierścień pusty
+static bool traceDrainOne()
+{
+  TraceRecord* r = &traceRing[traceTail & (TRACE_RING_SIZE - 1)];
+  if (__atomic_load_n(&r->seq, __ATOMIC_ACQUIRE) != traceTail + 1) return false;
+
+  TraceRecord rec = *r;
+  char txt[TRACE_TXT_LIMIT + 1];
+  if (rec.hasTxt)
+  {
+    for (uint32_t k = 0; k < rec.parts; k++)
+    {
+      const uint32_t off = k * TRACE_TXT_MAX;
+      const uint32_t n   = (rec.txtLen - off < TRACE_TXT_MAX) ? rec.txtLen - off : TRACE_TXT_MAX;
+      memcpy(txt + off, traceRing[(traceTail + k) & (TRACE_RING_SIZE - 1)].txt, n);
+    }
+    txt[rec.txtLen] = '\0';
+  }
+  for (uint32_t k = 0; k < rec.parts; k++)
+  {
+    TraceRecord* s = &traceRing[(traceTail + k) & (TRACE_RING_SIZE - 1)];
+    __atomic_store_n(&s->seq, traceTail + k + TRACE_RING_SIZE, __ATOMIC_RELEASE);
+  }
+  traceTail += rec.parts;
+
+  const uint8_t lv = (rec.level < sizeof(kTraceLevelChars) - 1) ? rec.level : 0;
+  Serial.printf("[%6lu.%03lu c%u %c %s] ", (unsigned long)(rec.us / 1000000UL),
+                (unsigned long)((rec.us / 1000UL) % 1000UL), rec.core, kTraceLevelChars[lv], kTraceCatNames[rec.cat]);
+  if (rec.hasTxt) Serial.printf(rec.fmt, txt, rec.a, rec.b);
+  else            Serial.printf(rec.fmt, rec.a, rec.b);
+  Serial.println();
+  traceDrained++;
+  return true;
+}
+
+static void traceTaskFn(void*)
+{
+  for (;;)
+  {
+    const uint32_t pending = __atomic_load_n(&traceHead, __ATOMIC_RELAXED) - traceTail;
+    if (pending > traceMaxPending) traceMaxPending = pending;
+
+    // porcja rekordów, potem oddanie CPU – UART nie zagłodzi reszty
+    uint8_t n = 0;
+    while (n < 16 && traceDrainOne()) n++;
+    vTaskDelay(pdMS_TO_TICKS(n ? 1 : 20));
+  }
+}
+
+bool traceStart()
+{
+#if ENABLE_TRACE
+  if (traceTask) return true;
+  if (!traceRingReady) traceRingInit();
+  if (xTaskCreatePinnedToCore(traceTaskFn, "trace", 3072, nullptr, 0, &traceTask, 0) != pdPASS)
+  {
+    traceTask = nullptr;
+    return false;
+  }
+  return true;
+#else
+  return false;
+#endif
+}
+
+void traceSetMask(uint32_t mask)
+{
+  traceMask = mask;
+}
+
+void traceSetLevel(uint8_t level)
+{
+  traceLevel = (level > TRACE_DEBUG) ? TRACE_DEBUG : level;
+}
+
+void traceGetStats(TraceStats* out)
+{
+  if (!out) return;
+  out->written    = traceWritten;
+  out->dropped    = traceDropped;
+  out->drained    = traceDrained;
+  out->pending    = __atomic_load_n(&traceHead, __ATOMIC_RELAXED) - traceTail;
+  out->maxPending = traceMaxPending;
+}
+
+void traceResetStats()
+{
+  traceWritten = 0;
+  traceDropped = 0;
+  traceDrained = 0;
+  traceMaxPending = 0;
+}
+
+String traceStatsToJson()
+{
+  TraceStats s;
+  traceGetStats(&s);
+  String json;
+  json.reserve(320);
+  json += "{";
+  json += "\"running\":"    + String(traceTask ? 1 : 0) + ",";
+  json += "\"mask\":"       + String(traceMask) + ",";
+  json += "\"level\":"      + String(traceLevel) + ",";
+  json += "\"levelMax\":"   + String(TRACE_LEVEL_MAX) + ",";
+  json += "\"capacity\":"   + String(TRACE_RING_SIZE) + ",";
+  json += "\"written\":"    + String(s.written) + ",";
+  json += "\"dropped\":"    + String(s.dropped) + ",";
+  json += "\"drained\":"    + String(s.drained) + ",";
+  json += "\"pending\":"    + String(s.pending) + ",";
+  json += "\"maxPending\":" + String(s.maxPending) + ",";
+  json += "\"categories\":[";
+  for (uint8_t c = 0; c < TRACE_CATEGORIES; c++)
+  {
+    if (c) json += ",";
+    json += "\"" + String(kTraceCatNames[c]) + "\"";
+  }
+  json += "]}";
+  return json;
+}
@@ -0,0 +1,91 @@
+#pragma once
+#include <Arduino.h>
+
+// Śledzenie zdarzeń bez blokowania na UART.
+// TRACE()/TRACE_S() zapisują binarny rekord (czas, rdzeń, kategoria,
+// poziom, wskaźnik na format w pamięci programu, dwa int32 i opcjonalnie
+// tekst) do pierścienia w RAM – bez blokad, wielu producentów
+// (loop, callback audio, zadania). Formatowanie i Serial robi dopiero
+// zadanie "trace" o najniższym priorytecie. Pełny pierścień = rekord
+// odrzucony i policzony, producent nigdy nie czeka.
+//
+// Poziom ponad TRACE_LEVEL_MAX znika w kompilacji; w działaniu filtrują
+// maska kategorii i poziom (traceSetMask/traceSetLevel, /trace).
+// Format dostaje argumenty (a, b), a z TRACE_S – (tekst, a, b).
+
+#ifndef ENABLE_TRACE
+#define ENABLE_TRACE 1
+#endif
+
+#ifndef TRACE_RING_SIZE
+#define TRACE_RING_SIZE 128     // rekordów, potęga 2
+#endif
+
+#define TRACE_TXT_MAX 48        // bajtów tekstu w jednym slocie pierścienia
+#ifndef TRACE_TXT_SLOTS
+#define TRACE_TXT_SLOTS 4       // najwięcej slotów na jeden rekord TRACE_S
+#endif
+#define TRACE_TXT_LIMIT (TRACE_TXT_SLOTS * TRACE_TXT_MAX - 1)   // 191 znaków
+
+#define TRACE_ERROR 1
+#define TRACE_WARN  2
+#define TRACE_INFO  3
+#define TRACE_DEBUG 4
+
+#ifndef TRACE_LEVEL_MAX
+#define TRACE_LEVEL_MAX TRACE_DEBUG
+#endif
+
+enum TraceCategory : uint8_t {
+  TRACE_SYS = 0,
+  TRACE_AUDIO,      // callback Audio (my_audio_info), kodeki, strumień
+  TRACE_STATION,    // zmiana stacji, banki
+  TRACE_DISPLAY,    // OLED, style analizatora
+  TRACE_ANALYZER,   // FFT, VU
+  TRACE_NET,        // WiFi, WWW, WebSocket
+  TRACE_STORAGE,    // SD/SPIFFS
+  TRACE_INPUT,      // pilot, enkodery
+  TRACE_CATEGORIES
+};
+
+struct TraceStats {
+  uint32_t written;     // rekordy zapisane do pierścienia
+  uint32_t dropped;     // odrzucone – pierścień pełny
+  uint32_t drained;     // wypisane przez zadanie
+  uint32_t pending;     // czekające w pierścieniu
+  uint32_t maxPending;
+};
+
+extern uint32_t traceMask;    // bit = kategoria
+extern uint8_t  traceLevel;   // rekordy o poziomie <= traceLevel
+
+static inline bool traceEnabled(uint8_t cat, uint8_t level)
+{
+  return level <= traceLevel && (traceMask & (1UL << cat));
+}
+
+bool traceWrite(uint8_t cat, uint8_t level, const char* fmt, const char* txt, int32_t a, int32_t b);
+
+#if ENABLE_TRACE
+#define TRACE_IMPL(cat, level, fmt, txt, a, b, ...) \
+  do { if ((level) <= TRACE_LEVEL_MAX && traceEnabled((cat), (level))) \
+         traceWrite((cat), (level), (fmt), (txt), (int32_t)(a), (int32_t)(b)); } while (0)
+#else
+#define TRACE_IMPL(cat, level, fmt, txt, a, b, ...) do { } while (0)
+#endif
+
+// TRACE(TRACE_AUDIO, TRACE_INFO, "Sample Rate: %d Hz", sr);
+#define TRACE(cat, level, fmt, ...)        TRACE_IMPL(cat, level, fmt, nullptr, ##__VA_ARGS__, 0, 0)
+// TRACE_S(TRACE_STATION, TRACE_INFO, "Stacja: %s (%d)", name.c_str(), nr);
+// Tekst dłuższy niż TRACE_TXT_MAX zajmuje kolejne sloty pierścienia
+// (po TRACE_TXT_MAX bajtów), najwyżej TRACE_TXT_SLOTS – do TRACE_TXT_LIMIT
+// znaków (191), reszta jest obcinana. Długi tytuł/URL kosztuje więc do 4
+// rekordów z pojemności TRACE_RING_SIZE; wypisywany jest jako jedna linia.
+#define TRACE_S(cat, level, fmt, txt, ...) TRACE_IMPL(cat, level, fmt, (txt), ##__VA_ARGS__, 0, 0)
+
+bool traceStart();                 // zadanie opróżniające (po Serial.begin())
+void traceSetMask(uint32_t mask);
+void traceSetLevel(uint8_t level);
+void traceGetStats(TraceStats* out);
+void traceResetStats();
+String traceStatsToJson();         // dla /trace
@@ -32,6 +32,14 @@
 #include <ESPmDNS.h>           // Blibioteka mDNS dla ESP
 #include "EQ_AnalyzerDisplay.h"  // FFT analyzer (styles 5/6)
 #include "EQ_FFTAnalyzer.h"    // FFT analyzer functions
+#include "EQ_VUMeter.h"        // VU/PPM/true-peak liczone w hooku audio (tryby 0/3/4)
+#include "SYS_Trace.h"         // TRACE(): rekordy do pierścienia w RAM, Serial w osobnym zadaniu
+#include "OLED_Display.h"      // Wysyłanie ramki OLED tylko w zmienionych kafelkach
+#include "OLED_SpiDma.h"       // OLED przez spi_master z DMA
+#include "OLED_Trig.h"         // sin/cos z tablicy (Q14) dla wskazówek i stylów 7/9
+#include "OLED_BgCache.h"      // tło VU/analizatora rysowane raz, potem memcpy
+#include "OLED_ScrollStrip.h"  // scroller stacji z gotowego paska zamiast drawStr() co krok
+#include "OLED_Glyphs.h"       // szerokości tekstu z tablicy glifów
 
 
 #include "soc/rtc_cntl_reg.h"   // Biblioteki ESP aby móc zrobic pełny reset 
@@ -55,6 +63,7 @@
 //<-----TUTAJ WŁĄCZAMY KARTE SD / pamiec SPIFSS oraz drugi enkoder ------->
 #define USE_SD  //odkomentuj dla karty SD
 //#define twoEncoders // odkomentuj dla drugiego enkodera
+//#define USE_RUNTIME_EQ // odkomentuj gdy w torze audio pracuje AudioRuntimeEQ_Evo (korektor runtime + /peq)
 //<----------------------------------------------------------------------->
 const bool f_powerOffAnimation = 0; // Animacja przy power OFF
 
@@ -70,6 +79,10 @@ const bool f_powerOffAnimation = 0; // Animacja przy power OFF
   #define STORAGE_BEGIN() SPIFFS.begin(true)
   const bool useSD = false;
 #endif
+
+#ifdef USE_RUNTIME_EQ
+  #include "AudioRuntimeEQ_PEQ.h" // Tryb parametryczny korektora runtime (API /peq)
+#endif
  
 // Definicja pinow dla wyswietlacza OLED 
 #define SPI_MOSI_OLED 39  // Pin MOSI (Master Out Slave In) dla interfejsu SPI OLED
@@ -130,7 +143,7 @@ const bool f_powerOffAnimation = 0; // Animacja przy power OFF
 uint8_t analyzerStylesMode = 2;     // 0=0-4-5, 1=0-4-6, 2=0-4-5-6-7-8-9 (wszystkie)
 uint8_t analyzerCurrentPreset = 0;  // Aktualny preset analizatora (0-4)
 // Maksymalny numer stylu ekranu (dynamicznie obliczany na podstawie analyzerStylesMode)
-uint8_t displayModeMax = 9;         // WSZYSTKIE style 0..9 z analizatorem FFT
+uint8_t displayModeMax = 12;        // WSZYSTKIE style 0..12 z analizatorem FFT
 
 // DEBUG PRINTS - ON/OFF
 #define f_debug_web_on 0         // Flaga właczenia wydruku debug_web
@@ -408,6 +421,19 @@ String streamCodec;
 String stationLogoUrl;
 String timezone;
 
+// Stan zadany z /displayScript (tools/display_snapshot.py) – handler WWW tylko
+// wypełnia displayScriptReq, stosuje go loop(); off przywraca stan sprzed skryptu
+struct DisplayScript {
+  bool    off;
+  uint8_t mode;
+  bool    mute;
+  bool    setText;
+  String  station;
+  String  title;
+};
+DisplayScript displayScriptReq;
+volatile bool displayScriptPending = false;
+
 
 String header;                      // Zmienna dla serwera www
 String sliderValue = "0";
@@ -896,7 +922,7 @@ const char config_html[] PROGMEM = R"rawliteral(
   <tr><td>OLED Display Clock in Sleep Mode default:Off</td><td><input type="checkbox" name="f_displayPowerOffClock" value="1" %S19_checked></td></tr>
   <tr><td>OLED Display Power Save Mode, default:Off</td><td><input type="checkbox" name="displayPowerSaveEnabled" value="1" %S9_checked></td></tr>
   <tr><td>OLED Display Power Save Time (1-600sek.), default:20</td><td><input type="number" name="displayPowerSaveTime" min="1" max="600" value="%D9"></td></tr>
-  <tr><td>OLED Display Mode: 0-Radio, 1-Clock, 2-Lines, 3-Minimal, 4-VU, 5-Analyzer, 6-Segments, 7-Circles, 8-Lines, 9-Snow</td><td><input type="number" name="displayMode" min="0" max="9" value="%D6"></td></tr>
+  <tr><td>OLED Display Mode: 0-Radio, 1-Clock, 2-Lines, 3-Minimal, 4-VU, 5-Analyzer, 6-Segments, 7-Circles, 8-Lines, 9-Snow, 10-Waterfall, 11-Scope, 12-Lissajous</td><td><input type="number" name="displayMode" min="0" max="12" value="%D6"></td></tr>
 
   <tr><th>Other Setting</th><th></th></tr>
   <tr><td>Time Voice Info Every Hour, default:On</td><td><input type="checkbox" name="timeVoiceInfoEveryHour" value="1" %S3_checked></td></tr>
@@ -2474,7 +2500,7 @@ void saveStationToPSRAM(const char *station)
       int x = (stationsCount * 2) + 8;          // Dodajemy gdy stationCount=1 + 8 aby utrzymac warunek dla zaokrąglonego drawRBox - szerokość W>6 h>6 ma byc W>=2*(r+1), h >= 2*(r+1)
       u8g2.drawRBox(23, 44, x, 8, 2);       // Pasek postepu ladowania stacji z serwera lub karty SD / SPIFFS       
       
-      u8g2.sendBuffer();  
+      oledFlush();  
     } else {
       // Informacja o błędzie w przypadku zbyt długiego linku do stacji.
       Serial.println("Błąd: Link do stacji jest zbyt długi");
@@ -2573,7 +2599,7 @@ void fetchStationsFromServer()
   u8g2.clearBuffer();
   u8g2.setCursor(21, 23);
   u8g2.print("Loading bank:" + String(bank_nr) + " stations from:");
-  u8g2.sendBuffer();
+  oledFlush();
   
   currentSelection = 0;
   firstVisibleLine = 0;
@@ -2657,7 +2683,7 @@ void fetchStationsFromServer()
     u8g2.setFont(spleen6x12PL);
     //u8g2.drawStr(147, 23, "SD card");
     if (useSD) {u8g2.print("SD Card");} else if (!useSD) {u8g2.print("SPIFFS");}
-    u8g2.sendBuffer();
+    oledFlush();
     readSDStations();  // Jesli dany plik banku istnieje to odczytujemy go TYLKO z karty
   } 
   else
@@ -2666,7 +2692,7 @@ void fetchStationsFromServer()
     // stworz plik na karcie tylko jesli on nie istnieje GR
     //u8g2.drawStr(205, 23, "GitHub server");
     u8g2.print("GitHub");
-    u8g2.sendBuffer();
+    oledFlush();
     {
       // Próba utworzenia pliku, jeśli nie istnieje
       File bankFile = STORAGE.open(fileName, FILE_WRITE);
@@ -2777,6 +2803,30 @@ void calcNec() // Funkcja umozliwajaca przeliczanie odwrotne aby "udawac" przyci
 
 
 
+// Szerokość tekstu scrollera w px = przesunięcie kursora po drawStr() (tablica glifów
+// spleen6x12PL). Bajty bez glifu, np. nieprzetworzone UTF-8, mają 0 px – length()*6 ich nie widział.
+uint16_t stationStringScrollMeasure()
+{
+  uint16_t w = oledTextAdvance(u8g2, spleen6x12PL, stationStringScroll.c_str());
+  if (w == 0) { w = stationStringScroll.length() * 6; }  // żadnego glifu – szacunek jak dawniej, byle okres nie był 0
+  return w;
+}
+
+// Pasek przewijanego tekstu (OLED_ScrollStrip) dla trybów ze scrollerem jednej linii
+void stationStringStripPrepare()
+{
+  uint8_t y;
+  if (displayMode == 0)      { y = yPositionDisplayScrollerMode0; }
+  else if (displayMode == 1) { y = yPositionDisplayScrollerMode1; }
+  else if (displayMode == 3) { y = yPositionDisplayScrollerMode3; }
+  else { return; }
+
+  if (stationStringScroll.length() > maxStationVisibleStringScrollLength)
+  {
+    scrollStripPrepare(stationStringScroll.c_str(), stationStringScrollWidth, y, spleen6x12PL);
+  }
+}
+
 // Funkcja formatowania dla scorllera stationString/stationName  **** stationStringScroll ****
 void stationStringFormatting() 
 {
@@ -2803,11 +2853,11 @@ void stationStringFormatting()
     }             
     
     //Liczymy długość napisu stationStringScroll 
-    stationStringScrollWidth = stationStringScroll.length() * 6;    
+    stationStringScrollWidth = stationStringScrollMeasure();    
     if (f_debug_on) 
     {
       Serial.print("debug -> StationStringScroll Lenght [chars]:");  Serial.println(stationStringScroll.length());
-      Serial.print("debug -> StationStringScroll Width (Lenght * 6px) [px]:"); Serial.println(stationStringScrollWidth);
+      Serial.print("debug -> StationStringScroll Width [px]:"); Serial.println(stationStringScrollWidth);
       
       Serial.print("debug -> Display Mode-0 stationStringScroll Text: @");
       Serial.print(stationStringScroll);
@@ -2863,7 +2913,7 @@ void stationStringFormatting()
     //Serial.println(stationStringScroll);
 
     //Liczymy długość napisu stationStringScrollWidth 
-    stationStringScrollWidth = stationStringScroll.length() * 6;
+    stationStringScrollWidth = stationStringScrollMeasure();
   }
   else if (displayMode == 2) // Tryb wświetlania mode 2 - 3 linijki tekstu
   {             
@@ -2910,7 +2960,7 @@ void stationStringFormatting()
       stationStringScroll = "  " + stationString + "  " ; // Nie dodajemy separator do tekstu aby wyswietlał się rowno na srodku
     }             
     //Liczymy długość napisu stationStringScroll 
-    stationStringScrollWidth = stationStringScroll.length() * 6;
+    stationStringScrollWidth = stationStringScrollMeasure();
     //Serial.print("debug -> Display Mode-3 stationStringScroll:@");
     //Serial.print(stationStringScroll);
     //Serial.println("@");
@@ -2937,12 +2987,13 @@ void stationStringFormatting()
       stationStringScroll = "  " + stationString + "  " ; // Nie dodajemy separator do tekstu aby wyswietlał się rowno na srodku
     }             
     //Liczymy długość napisu stationStringScroll 
-    stationStringScrollWidth = stationStringScroll.length() * 6;
+    stationStringScrollWidth = stationStringScrollMeasure();
     //Serial.print("debug -> Display Mode-3 stationStringScroll:@");
     //Serial.print(stationStringScroll);
     //Serial.println("@");
   }
   
+  stationStringStripPrepare();  // pasek scrollera renderujemy od razu, przewijanie to potem tylko kopiowanie
 }
 
 // Obsługa wyświetlacza dla odtwarzanego strumienia radia internetowego
@@ -3175,6 +3226,8 @@ void audio_process_i2s(int16_t* outBuff, int32_t validSamples, bool* continueI2S
 {
   // Push audio samples to EQ analyzer (validSamples is number of stereo frames)
   eq_analyzer_push_samples_i16((const int16_t*)outBuff, validSamples);
+  // Mierniki VU/PPM z balistyką – tryby 0/3/4 czytają gotowy snapshot
+  eq_vu_push_samples_i16((const int16_t*)outBuff, validSamples);
   
   // Continue normal audio processing
   *continueI2S = true;
@@ -3190,7 +3243,7 @@ void my_audio_info(Audio::msg_t m)
       msg.trim(); // usuń spacje i \r\n
       // Sprawdź czy to błąd dekodera
       if (msg.indexOf("Error") != -1 || msg.indexOf("error") != -1) {
-        Serial.printf("[AUDIO ERROR] %s\n", msg.c_str());
+        TRACE_S(TRACE_AUDIO, TRACE_ERROR, "%s", msg.c_str());
         // Reset analizatora przy błędzie
         eq_analyzer_reset();
       }
@@ -3211,14 +3264,14 @@ void my_audio_info(Audio::msg_t m)
         
         f_audioInfoRefreshDisplayRadio = true;
         wsAudioRefresh = true;  //Web Socket - audio refresh
-        Serial.printf("bitrate: .... %s\n", m.msg); // icy-bitrate or bitrate from metadata
+        TRACE(TRACE_AUDIO, TRACE_INFO, "Bitrate: %d kbps", bitrateStringInt); // icy-bitrate or bitrate from metadata
       }
       
       // --- FLAC BitsPerSample ---
       int bitrateIndexFlac = msg.indexOf("FLAC bitspersample:");
       if ((bitrateIndexFlac != -1) && (flac == true))
       {
-        Serial.printf("bitrate FLAC: .... %s\n", m.msg); // icy-bitrate or bitrate from metadata
+        TRACE_S(TRACE_AUDIO, TRACE_DEBUG, "bitrate FLAC: %s", m.msg);
         int endIndex = msg.indexOf('\n', bitrateIndexFlac);
         if (endIndex == -1) endIndex = msg.length();
         bitrateString = msg.substring(bitrateIndexFlac + 19, endIndex); // POPRAWKA: bitrateIndexFlac zamiast bitrateIndex
@@ -3252,7 +3305,8 @@ void my_audio_info(Audio::msg_t m)
         
         // Ustaw sample rate w analizatorze
         eq_analyzer_set_sample_rate(fullSampleRate);
-        Serial.printf("[AUDIO] Sample Rate detected: %u Hz\n", fullSampleRate);
+        eq_vu_set_sample_rate(fullSampleRate);
+        TRACE(TRACE_AUDIO, TRACE_INFO, "Sample Rate detected: %u Hz", fullSampleRate);
         
         f_audioInfoRefreshDisplayRadio = true;
         wsAudioRefresh = true;  //Web Socket - audio refresh    
@@ -3268,7 +3322,7 @@ void my_audio_info(Audio::msg_t m)
         bitsPerSampleString.trim();
         
         uint8_t bitsPerSample = bitsPerSampleString.toInt();
-        Serial.printf("[AUDIO] Bits per sample: %u\n", bitsPerSample);
+        TRACE(TRACE_AUDIO, TRACE_INFO, "Bits per sample: %u", bitsPerSample);
         
         f_audioInfoRefreshDisplayRadio = true;	
         wsAudioRefresh = true;  //Web Socket - audio refresh    
@@ -3280,7 +3334,7 @@ void my_audio_info(Audio::msg_t m)
         mp3 = true; 
         flac = false; aac = false; vorbis = false; opus = false;
         streamCodec = "MP3";
-        Serial.println("[AUDIO] Codec: MP3 detected");
+        TRACE(TRACE_AUDIO, TRACE_INFO, "Codec: MP3 detected");
         f_audioInfoRefreshDisplayRadio = true; // refresh displayRadio screen
         wsAudioRefresh = true;  //Web Socket - audio refresh    
       }
@@ -3289,7 +3343,7 @@ void my_audio_info(Audio::msg_t m)
         flac = true; 
         mp3 = false; aac = false; vorbis = false; opus = false;
         streamCodec = "FLAC";
-        Serial.println("[AUDIO] Codec: FLAC detected");
+        TRACE(TRACE_AUDIO, TRACE_INFO, "Codec: FLAC detected");
         // Resetuj analizator dla nowego formatu
         eq_analyzer_reset();
         f_audioInfoRefreshDisplayRadio = true; // refresh displayRadio screen
@@ -3300,7 +3354,7 @@ void my_audio_info(Audio::msg_t m)
         aac = true;
         flac = false; mp3 = false; vorbis = false; opus = false;
         streamCodec = "AAC";
-        Serial.println("[AUDIO] Codec: AAC detected");
+        TRACE(TRACE_AUDIO, TRACE_INFO, "Codec: AAC detected");
         // Resetuj analizator dla nowego formatu
         eq_analyzer_reset();
         f_audioInfoRefreshDisplayRadio = true; // refresh displayRadio screen
@@ -3311,7 +3365,7 @@ void my_audio_info(Audio::msg_t m)
         vorbis = true;
         aac = false; flac = false; mp3 = false; opus = false;
         streamCodec = "VRB";
-        Serial.println("[AUDIO] Codec: VORBIS detected");
+        TRACE(TRACE_AUDIO, TRACE_INFO, "Codec: VORBIS detected");
         eq_analyzer_reset();
         f_audioInfoRefreshDisplayRadio = true; // refresh displayRadio screen
         wsAudioRefresh = true;  //Web Socket - audio refresh    
@@ -3321,19 +3375,19 @@ void my_audio_info(Audio::msg_t m)
         opus = true;
         aac = false; flac = false; mp3 = false; vorbis = false;
         streamCodec = "OPUS";
-        Serial.println("[AUDIO] Codec: OPUS detected");
+        TRACE(TRACE_AUDIO, TRACE_INFO, "Codec: OPUS detected");
         eq_analyzer_reset();
         f_audioInfoRefreshDisplayRadio = true; // refresh displayRadio screen
         wsAudioRefresh = true;  //Web Socket - audio refresh    
       }
 
       // --- Debug ---
-      Serial.printf("info: ....... %s\n", m.msg);      
+      TRACE_S(TRACE_AUDIO, TRACE_DEBUG, "info: %s", m.msg);
     }
     break;
 
     case Audio::evt_log:
-      Serial.printf("[AUDIO LOG] %s\n", m.msg);
+      TRACE_S(TRACE_AUDIO, TRACE_DEBUG, "log: %s", m.msg);
       // Sprawdź czy to błąd na podstawie treści logu
       if (strstr(m.msg, "error") || strstr(m.msg, "Error") || strstr(m.msg, "ERROR") ||
           strstr(m.msg, "failed") || strstr(m.msg, "Failed") || strstr(m.msg, "FAILED")) {
@@ -3344,7 +3398,7 @@ void my_audio_info(Audio::msg_t m)
 
     case Audio::evt_eof:
     {
-      Serial.printf("end of file:  %s\n", m.msg);
+      TRACE_S(TRACE_AUDIO, TRACE_INFO, "end of file: %s", m.msg);
       if (resumePlay == true)
       {
         ir_code = rcCmdOk; // Przypisujemy kod pilota - OK
@@ -3368,11 +3422,11 @@ void my_audio_info(Audio::msg_t m)
       
       f_audioInfoRefreshDisplayRadio = true;
       wsAudioRefresh = true;  //Web Socket - audio refresh
-      Serial.printf("info: ....... evt_bitrate: %s\n", m.msg); break; // icy-bitrate or bitrate from metadata
+      TRACE(TRACE_AUDIO, TRACE_INFO, "evt_bitrate: %d kbps", bitrateStringInt); break; // icy-bitrate or bitrate from metadata
     }
-    case Audio::evt_icyurl:         Serial.printf("icy URL: .... %s\n", m.msg); break;
-    case Audio::evt_id3data:        Serial.printf("ID3 data: ... %s\n", m.msg); break;
-    case Audio::evt_lasthost:       Serial.printf("last URL: ... %s\n", m.msg); break;
+    case Audio::evt_icyurl:         TRACE_S(TRACE_AUDIO, TRACE_DEBUG, "icy URL: %s", m.msg); break;
+    case Audio::evt_id3data:        TRACE_S(TRACE_AUDIO, TRACE_DEBUG, "ID3 data: %s", m.msg); break;
+    case Audio::evt_lasthost:       TRACE_S(TRACE_AUDIO, TRACE_DEBUG, "last URL: %s", m.msg); break;
     case Audio::evt_name:           
 	  {
       stationNameStream = String(m.msg);
@@ -3384,7 +3438,7 @@ void my_audio_info(Audio::msg_t m)
 
       f_audioInfoRefreshStationString = true;
       wsAudioRefresh = true;
-      Serial.printf("info: ....... station name: %s\n", m.msg); // station name lub icy-name
+      TRACE_S(TRACE_AUDIO, TRACE_INFO, "station name: %s", m.msg); // station name lub icy-name
 	  }
     break; 
 
@@ -3434,7 +3488,7 @@ void encoderFunctionOrderChange()
   u8g2.drawStr(1,14,"Encoder function order change:");
   if (encoderFunctionOrder == false) {u8g2.drawStr(1,28,"Rotate for volume, press for station list");}
   if (encoderFunctionOrder == true ) {u8g2.drawStr(1,28,"Rotate for station list, press for volume");}
-  u8g2.sendBuffer();
+  oledFlush();
 }
 
 void bankMenuDisplay()
@@ -3477,7 +3531,7 @@ void bankMenuDisplay()
   u8g2.drawRBox(sliderX, 44, sliderWidth, 10, 2);
 
   //u8g2.drawRBox((bank_nr * 13) + 10, 44, 15, 10, 2);  // wypełnienie slidera Rbox dla stałej wartosci max_bank = 16, stara wersja
-  u8g2.sendBuffer();
+  oledFlush();
   
 }
 
@@ -3888,7 +3942,7 @@ void rcInputKey(uint8_t i)
     u8g2.setFont(spleen6x12PL);
     u8g2.setCursor(0, 60);
     u8g2.print("Bank:" + String(bank_nr) + ", 1-" + String(stationsCount) + "     " + stationNameText);
-    u8g2.sendBuffer();
+    oledFlush();
 
     if ((rcInputDigit1 !=0xFF) && (rcInputDigit2 !=0xFF)) // jezeli wpisalismy obie cyfry to czyscimy pola aby mozna bylo je wpisac ponownie
     {
@@ -4029,7 +4083,7 @@ void changeStation()
   u8g2.setFont(u8g2_font_fub14_tf); // cziocnka 14x11
   u8g2.drawStr(34, 33, "Loading stream..."); // 8 znakow  x 11 szer
   //u8g2.drawStr(51, 33, "Loading stream"); // 8 znakow  x 11 szer
-  u8g2.sendBuffer();
+  oledFlush();
 
   mp3 = flac = aac = vorbis = opus = false;
   streamCodec = "";
@@ -4053,7 +4107,7 @@ void changeStation()
   bitsPerSampleString = "--";
   bitrateString = "-?-";
 
-  Serial.println("debug changeStation -> Read station from PSRAM");
+  TRACE(TRACE_STATION, TRACE_DEBUG, "changeStation -> Read station from PSRAM");
   String stationUrl = "";
 
   // Odczyt stacji pod daną komórka pamieci PSRAM:
@@ -4075,8 +4129,7 @@ void changeStation()
   
   // Wyciągnij pierwsze 42 znaki i przypisz do stationName
   stationName = line.substring(0, 41);  //42 Skopiuj pierwsze 42 znaki z linii
-  Serial.print("debug changeStation -> Nazwa stacji: ");
-  Serial.println(stationName);
+  TRACE_S(TRACE_STATION, TRACE_INFO, "changeStation -> Nazwa stacji: %s", stationName.c_str());
 
   // Znajdź część URL w linii, np. po numerze stacji
   int urlStart = line.indexOf("http");  // Szukamy miejsca, gdzie zaczyna się URL
@@ -4092,7 +4145,7 @@ void changeStation()
   
   if (stationUrl.isEmpty()) // jezeli link URL jest pusty
   {
-    Serial.println("debug changeStation -> Błąd: Nie znaleziono stacji dla podanego numeru.");
+    TRACE(TRACE_STATION, TRACE_ERROR, "changeStation -> Błąd: Nie znaleziono stacji dla podanego numeru.");
     return;
   }
   
@@ -4103,10 +4156,7 @@ void changeStation()
   if (stationUrl.startsWith("http://") || stationUrl.startsWith("https://")) 
   {
     // Wydrukuj nazwę stacji i link na serialu
-    Serial.print("debug changeStation -> Aktualnie wybrana stacja: ");
-    Serial.println(station_nr);
-    Serial.print("debug changeStation -> Link do stacji: ");
-    Serial.println(stationUrl);
+    TRACE_S(TRACE_STATION, TRACE_INFO, "changeStation -> %s (stacja %d)", stationUrl.c_str(), station_nr);
     
     u8g2.setFont(spleen6x12PL);  // wypisujemy jaki stream jakie stacji jest ładowany
     
@@ -4117,7 +4167,7 @@ void changeStation()
     int stationNamePositionX = (SCREEN_WIDTH - stationNameWidth) / 2;
     
     u8g2.drawStr(stationNamePositionX, 55, String(stationName.substring(0, stationNameLenghtCut)).c_str());
-    u8g2.sendBuffer();
+    oledFlush();
     
     // Płynne wyciszenie przed zmiana stacji jesli włączone
     if (f_volumeFadeOn && !volumeMute) {volumeFadeOut(volumeFadeOutTime);}
@@ -4137,8 +4187,7 @@ void changeStation()
   } 
   else 
   {
-    Serial.println("debug changeStation -> Błąd: link stacji nie zawiera 'http' lub 'https'");
-    Serial.println("debug changeStation -> Odczytany URL: " + stationUrl);
+    TRACE_S(TRACE_STATION, TRACE_ERROR, "changeStation -> Błąd: link bez http/https: %s", stationUrl.c_str());
   }
   currentSelection = station_nr - 1; // ustawiamy stacje na liscie na obecnie odtwarzaczną po zmianie stacji
   firstVisibleLine = currentSelection + 1; // pierwsza widoczna lina to grająca stacja przy starcie
@@ -4205,7 +4254,7 @@ void displayStations()
   }
   // Przywróć domyślne ustawienia koloru rysowania (biały tekst na czarnym tle)
   u8g2.setDrawColor(1);  // Biały kolor rysowania
-  u8g2.sendBuffer();     // Wyślij zawartość bufora do ekranu OLED, aby wyświetlić zmiany
+  oledFlush();     // Wyślij zawartość bufora do ekranu OLED, aby wyświetlić zmiany
 }
 
 void updateTimerFlag() 
@@ -4364,7 +4413,7 @@ void saveEqualizerOnSD()
   u8g2.clearBuffer();
   u8g2.setFont(u8g2_font_fub14_tf); // cziocnka 14x11
   u8g2.drawStr(1, 33, "Saving equalizer settings"); // 8 znakow  x 11 szer
-  u8g2.sendBuffer();
+  oledFlush();
   
   
   // Sprawdź, czy plik equalizer.txt istnieje
@@ -4634,9 +4683,20 @@ void vuMeterMode0new()
 
 void vuMeterMode0() 
 {
-  uint16_t raw = audio.getVUlevel();
-  vuMeterL = (raw >> 8) & 0xFF;
-  vuMeterR = raw & 0xFF;
+  // VU z balistyką z hooka audio (dBFS, 300 ms); bez hooka – stare getVUlevel()
+  eq_vu_snapshot_t vu;
+  const bool vuBallistic = eq_vu_get(&vu);
+  if (vuBallistic)
+  {
+    vuMeterL = vu.bar[0];
+    vuMeterR = vu.bar[1];
+  }
+  else
+  {
+    uint16_t raw = audio.getVUlevel();
+    vuMeterL = (raw >> 8) & 0xFF;
+    vuMeterR = raw & 0xFF;
+  }
 
   //vuMeterL = constrain(vuMeterL, 0, 243);
   //vuMeterR = constrain(vuMeterR, 0, 243);
@@ -4655,8 +4715,13 @@ void vuMeterMode0()
   vuMeterR = map(vuMeterR, 0, 255, 0, 243);
   vuMeterL = map(vuMeterL, 0, 255, 0, 243);  // 244 VU + start od x=10 +  peak hold 2px
 
-
-  if (vuSmooth)
+  if (vuBallistic)
+  {
+    // balistyka już policzona – słupek pokazuje wartość wprost
+    displayVuL = vuMeterL;
+    displayVuR = vuMeterR;
+  }
+  else if (vuSmooth)
   {
     // LEFT
     if (vuMeterL > displayVuL) 
@@ -4695,8 +4760,18 @@ void vuMeterMode0()
     }
   }
 
+  // Peak: z hooka wskaźnik PPM (barPeak) wprost – bez liczenia w klatce;
+  // liczniki peak&hold zostają tylko dla getVUlevel()
+  if (vuBallistic)
+  {
+    if (vuPeakHoldOn)
+    {
+      peakL = map(vu.barPeak[0], 0, 255, 0, 243);
+      peakR = map(vu.barPeak[1], 0, 255, 0, 243);
+    }
+  }
   // Aktualizacja peak&hold dla Lewego kanału
-  if (vuSmooth)
+  else if (vuSmooth)
   {
     if (vuPeakHoldOn)
     {
@@ -4884,15 +4959,30 @@ void vuMeterMode0()
 
 void vuMeterMode3() 
 {
-  // Pobranie poziomu VU
-  vuMeterR = min(audio.getVUlevel() & 0xFF, 255);
-  vuMeterL = min(audio.getVUlevel() >> 8, 255);
+  // Pobranie poziomu VU – z balistyką z hooka audio, bez niego getVUlevel()
+  eq_vu_snapshot_t vu;
+  const bool vuBallistic = eq_vu_get(&vu);
+  if (vuBallistic)
+  {
+    vuMeterR = vu.bar[1];
+    vuMeterL = vu.bar[0];
+  }
+  else
+  {
+    vuMeterR = min(audio.getVUlevel() & 0xFF, 255);
+    vuMeterL = min(audio.getVUlevel() >> 8, 255);
+  }
 
   vuMeterR = map(vuMeterR, 0, 255, 0, 128);
   vuMeterL = map(vuMeterL, 0, 255, 0, 128);
 
   // Wygładzanie
-  if (vuSmooth)
+  if (vuBallistic)
+  {
+    displayVuL = vuMeterL;
+    displayVuR = vuMeterR;
+  }
+  else if (vuSmooth)
   {
     if (vuMeterL > displayVuL) {
       displayVuL += vuRiseSpeed;
@@ -4917,8 +5007,13 @@ void vuMeterMode3()
     }
   }
 
-  // Peak & Hold
-  if (vuPeakHoldOn)
+  // Peak: z hooka wskaźnik PPM (barPeak) wprost; Peak & Hold tylko dla getVUlevel()
+  if (vuPeakHoldOn && vuBallistic)
+  {
+    peakL = map(vu.barPeak[0], 0, 255, 0, 128);
+    peakR = map(vu.barPeak[1], 0, 255, 0, 128);
+  }
+  else if (vuPeakHoldOn)
   {
     // LEFT
     if ((vuSmooth ? displayVuL : vuMeterL) >= peakL) {
@@ -4982,18 +5077,133 @@ void vuMeterMode3()
   }
 }
 
-void vuMeterMode4() // Mode4 eksperymetn z duzymi wskaznikami VU
+// ─────────────────────────────────────
+// Styl VU 4 – geometria wspólna dla vuMeterMode4() i /vuBench
+// ─────────────────────────────────────
+static const int vu4Radius      = 45;
+static const int vu4FrameWidth  = 120;
+static const int vu4FrameHeight = 60;
+static const int vu4CenterXL    = 65;
+static const int vu4CenterXR    = 195;
+static const int vu4CenterY     = 63;
+static const int vu4ArcStartDeg = -60;
+static const int vu4ArcEndDeg   = 60;
+
+// Struktura opisów dB
+struct Vu4Mark {
+  int angle;
+  const char* label;
+};
+
+static const Vu4Mark vu4Marks[] = {
+  { -60, "-20" },
+  { -40, "-10" },
+  { -20, "-5"  },
+  {   0,  "0"   },
+  {  20, "+3"  },
+  {  40, "+6"  },
+  {  60, "+9"  },
+};
+
+// Geometria skali (kreski + pozycje opisów) liczona raz – względem środka
+// wskaźnika, wspólna dla L i R. Co klatkę liczymy już tylko igły.
+static const uint8_t vu4TickCount = (vu4ArcEndDeg - vu4ArcStartDeg) / 6 + 1;
+static const uint8_t vu4MarkCount = sizeof(vu4Marks) / sizeof(vu4Marks[0]);
+struct Vu4Tick  { int8_t x1, y1, x2, y2; };
+struct Vu4Label { int8_t x, y; };
+static Vu4Tick  vu4Ticks[vu4TickCount];
+static Vu4Label vu4Labels[vu4MarkCount];
+
+static void vu4BakeScale()
 {
-  // Pobranie poziomów VU (0–255)
-  uint8_t rawL = audio.getVUlevel() >> 8;
-  uint8_t rawR = audio.getVUlevel() & 0xFF;
+  static bool baked = false;
+  if (baked) return;
+  for (uint8_t i = 0; i < vu4TickCount; i++)
+  {
+    int32_t idx = trigDegToIdx(vu4ArcStartDeg + i * 6);
+    vu4Ticks[i].x1 =  trigMulSin(vu4Radius - 4, idx);
+    vu4Ticks[i].y1 = -trigMulCos(vu4Radius - 4, idx);
+    vu4Ticks[i].x2 =  trigMulSin(vu4Radius, idx);
+    vu4Ticks[i].y2 = -trigMulCos(vu4Radius, idx);
+  }
+  for (uint8_t i = 0; i < vu4MarkCount; i++)
+  {
+    int32_t idx = trigDegToIdx(vu4Marks[i].angle);
+    vu4Labels[i].x =  trigMulSin(vu4Radius + 10, idx) - 8;
+    vu4Labels[i].y = -trigMulCos(vu4Radius + 10, idx) + 5;
+  }
+  baked = true;
+}
+
+// Ramki, skale i opisy obu wskaźników (font i kolor ustawia wołający)
+static void vu4DrawScale(U8G2& g)
+{
+  vu4BakeScale();
+  auto drawVUArc = [&](int cx, int cy, const char* label)
+  {
+    // Ramka
+    g.drawFrame((cx - vu4FrameWidth / 2), cy - vu4Radius - 18, vu4FrameWidth, vu4FrameHeight);
+
+    // Skala łuku
+    for (uint8_t i = 0; i < vu4TickCount; i++)
+    {
+      const Vu4Tick& t = vu4Ticks[i];
+      g.drawLine(cx + t.x1, cy + t.y1, cx + t.x2, cy + t.y2);
+    }
+
+    // Opisy dB
+    for (uint8_t i = 0; i < vu4MarkCount; i++)
+    {
+      g.setCursor(cx + vu4Labels[i].x, cy + vu4Labels[i].y);
+      g.print(vu4Marks[i].label);
+    }
+
+    // Opis kanału (L/R)
+    g.setCursor(cx - 2, cy - 18);
+    g.print(label);
+  };
+  drawVUArc(vu4CenterXL, vu4CenterY, "L");
+  drawVUArc(vu4CenterXR, vu4CenterY, "R");
+}
+
+// Igły – kąt w krokach tablicy trig (0..100 → -60°..+60°)
+static void vu4DrawNeedles(U8G2& g, int levelL, int levelR)
+{
+  const int32_t needleStart = trigDegToIdx(vu4ArcStartDeg);
+  const int32_t needleSpan  = trigDegToIdx(vu4ArcEndDeg - vu4ArcStartDeg);
+
+  // Igła lewa
+  int32_t idxL = needleStart + (needleSpan * levelL + 50) / 100;
+  g.drawLine(vu4CenterXL, vu4CenterY - 8, vu4CenterXL + trigMulSin(vu4Radius - 6, idxL), vu4CenterY - trigMulCos(vu4Radius - 6, idxL));
 
-  // Skalowanie do 0–100
-  int vuL = map(rawL, 0, 255, 0, 100);
-  int vuR = map(rawR, 0, 255, 0, 100);
+  // Igła prawa
+  int32_t idxR = needleStart + (needleSpan * levelR + 50) / 100;
+  g.drawLine(vu4CenterXR, vu4CenterY - 8, vu4CenterXR + trigMulSin(vu4Radius - 6, idxR), vu4CenterY - trigMulCos(vu4Radius - 6, idxR));
+}
+
+void vuMeterMode4() // Mode4 eksperymetn z duzymi wskaznikami VU
+{
+  // Wskazówki: pozycja na skali -20..+9 VU (0 VU = -18 dBFS) z balistyką VU
+  // liczoną w hooku audio; bez hooka – getVUlevel() i bezwładność poniżej
+  eq_vu_snapshot_t vu;
+  const bool vuBallistic = eq_vu_get(&vu);
+  int vuL, vuR;
+  if (vuBallistic)
+  {
+    vuL = vu.needle[0];
+    vuR = vu.needle[1];
+  }
+  else
+  {
+    // Pobranie poziomów VU (0–255), skalowanie do 0–100
+    uint8_t rawL = audio.getVUlevel() >> 8;
+    uint8_t rawR = audio.getVUlevel() & 0xFF;
+    vuL = map(rawL, 0, 255, 0, 100);
+    vuR = map(rawR, 0, 255, 0, 100);
+  }
 
   // Bezwładność analogowa
-  if (vuSmooth) {
+  if (vuSmooth && !vuBallistic) {
     // Lewy
     if (vuL > displayVuL) {
       displayVuL += max(1, (vuL - displayVuL) / vuRiseNeedleSpeed);  // szybciej w górę
@@ -5015,89 +5225,117 @@ void vuMeterMode4() // Mode4 eksperymetn z duzymi wskaznikami VU
     displayVuR = vuR;
   }
 
-  // Parametry wskaźników
-  const int radius = 45;
-  const int frameWidth = 120;
-  const int frameHeight = 60;
-
-  int centerXL = 65;
-  int centerYL = 63;
-
-  int centerXR = 195;
-  int centerYR = 63;
-
-  const int arcStartDeg = -60;
-  const int arcEndDeg = 60;
-
-  // Czyszczenie ekranu
-  u8g2.setDrawColor(0);
-  u8g2.drawBox(0, 0, 256, 64);
+  // Tło (ramki, skale, opisy dB) jest stałe – rysujemy je raz do cache
+  // (OLED_BgCache), a w kolejnych klatkach tylko kopiujemy i dorysowujemy igły.
+  // Zmiana geometrii/opisów wymaga zmiany vuBgKey.
+  const uint32_t vuBgKey = 1;
+  const bool vuBgCached = oledBgBlit(u8g2, OLED_BG_MODE4, vuBgKey);
   u8g2.setDrawColor(1);
   u8g2.setFont(u8g2_font_6x10_tr);
 
-  // Struktura opisów dB
-  struct Mark {
-    int angle;
-    const char* label;
-  };
-
-  const Mark scaleMarks[] = {
-    { -60, "-20" },
-    { -40, "-10" },
-    { -20, "-5"  },
-    {   0,  "0"   },
-    {  20, "+3"  },
-    {  40, "+6"  },
-    {  60, "+9"  },
-  };
-
-  // Funkcja rysująca łuk wskaźnika
-  auto drawVUArc = [&](int cx, int cy, const char* label) 
+  // Rysowanie wskaźników L i R (tylko gdy tła nie ma jeszcze w cache)
+  if (!vuBgCached)
   {
-    // Ramka
-    u8g2.drawFrame((cx - frameWidth / 2), cy - radius - 18, frameWidth, frameHeight);
+    // Czyszczenie ekranu
+    u8g2.setDrawColor(0);
+    u8g2.drawBox(0, 0, 256, 64);
+    u8g2.setDrawColor(1);
+    vu4DrawScale(u8g2);
+    oledBgStore(u8g2, OLED_BG_MODE4, vuBgKey);
+  }
 
-    // Skala łuku
-    for (int a = arcStartDeg; a <= arcEndDeg; a += 6) 
-    {
-      float angle = radians(a);
-      int x1 = cx + sin(angle) * (radius - 4);
-      int y1 = cy - cos(angle) * (radius - 4);
-      int x2 = cx + sin(angle) * radius;
-      int y2 = cy - cos(angle) * radius;
-      u8g2.drawLine(x1, y1, x2, y2);
-    }
+  vu4DrawNeedles(u8g2, displayVuL, displayVuR);
+}
 
-    // Opisy dB
-    for (const Mark& m : scaleMarks) 
+// Jedna pełna klatka stylu 4 (ramki, skale, opisy, igły) na prywatnym płótnie:
+// geometria z tablicy trig kontra dawna wersja z sin()/cos() w double.
+// Te same losowe poziomy igieł; diffPixels = średnio różnych pikseli na klatkę.
+String vuMode4BenchToJson(uint16_t frames)
+{
+  if (frames < 1) frames = 1;
+  if (frames > 2000) frames = 2000;   // handler async_tcp – bez długiego blokowania
+
+  static U8G2_SSD1322_NHD_256X64_F_4W_HW_SPI bench(U8G2_R2, U8X8_PIN_NONE, U8X8_PIN_NONE, U8X8_PIN_NONE);
+  static uint8_t* benchBuf = nullptr;
+  static uint8_t* refBuf   = nullptr;
+  const size_t bufBytes = 256 * 64 / 8;
+  if (!benchBuf) benchBuf = (uint8_t*)malloc(bufBytes);
+  if (!refBuf)   refBuf   = (uint8_t*)malloc(bufBytes);
+  if (!benchBuf || !refBuf) return "{\"error\":\"no memory\"}";
+  bench.getU8g2()->tile_buf_ptr = benchBuf;   // nie ruszamy wspólnego bufora u8g2
+  bench.setFont(u8g2_font_6x10_tr);
+  bench.setDrawColor(1);
+
+  // dawna klatka: każda kreska, opis i igła z sin()/cos() w double
+  auto legacyFrame = [&](int levelL, int levelR)
+  {
+    auto arc = [&](int cx, int cy, const char* label)
+    {
+      bench.drawFrame((cx - vu4FrameWidth / 2), cy - vu4Radius - 18, vu4FrameWidth, vu4FrameHeight);
+      for (int a = vu4ArcStartDeg; a <= vu4ArcEndDeg; a += 6)
+      {
+        float angle = radians(a);
+        int x1 = cx + sin(angle) * (vu4Radius - 4);
+        int y1 = cy - cos(angle) * (vu4Radius - 4);
+        int x2 = cx + sin(angle) * vu4Radius;
+        int y2 = cy - cos(angle) * vu4Radius;
+        bench.drawLine(x1, y1, x2, y2);
+      }
+      for (const Vu4Mark& m : vu4Marks)
+      {
+        float angle = radians(m.angle);
+        int tx = cx + sin(angle) * (vu4Radius + 10);
+        int ty = cy - cos(angle) * (vu4Radius + 10);
+        bench.setCursor(tx - 8, ty + 5);
+        bench.print(m.label);
+      }
+      bench.setCursor(cx - 2, cy - 18);
+      bench.print(label);
+    };
+    auto needle = [&](int cx, int cy, int level)
     {
-      float angle = radians(m.angle);
-      int tx = cx + sin(angle) * (radius + 10);
-      int ty = cy - cos(angle) * (radius + 10);
-      u8g2.setCursor(tx - 8, ty + 5);
-      u8g2.print(m.label);
-    }
-
-    // Opis kanału (L/R)
-    u8g2.setCursor(cx - 2, cy - 18);
-    u8g2.print(label);
+      float angle = radians(vu4ArcStartDeg + (vu4ArcEndDeg - vu4ArcStartDeg) * level / 100.0);
+      int x = cx + sin(angle) * (vu4Radius - 6);
+      int y = cy - cos(angle) * (vu4Radius - 6);
+      bench.drawLine(cx, cy - 8, x, y);
+    };
+    arc(vu4CenterXL, vu4CenterY, "L");
+    arc(vu4CenterXR, vu4CenterY, "R");
+    needle(vu4CenterXL, vu4CenterY, levelL);
+    needle(vu4CenterXR, vu4CenterY, levelR);
   };
 
-  // Rysowanie wskaźników L i R
-  drawVUArc(centerXL, centerYL,"L"); //x,y,label (L)
-  drawVUArc(centerXR, centerYR,"R"); //x,y,label (R)
-
-  // Igła lewa
-  float angleL = radians(arcStartDeg + (arcEndDeg - arcStartDeg) * displayVuL / 100.0);
-  int xNeedleL = centerXL + sin(angleL) * (radius - 6);
-  int yNeedleL = centerYL - cos(angleL) * (radius - 6);
-  u8g2.drawLine(centerXL, centerYL - 8, xNeedleL, yNeedleL);
-
-  // Igła prawa
-  float angleR = radians(arcStartDeg + (arcEndDeg - arcStartDeg) * displayVuR / 100.0);
-  int xNeedleR = centerXR + sin(angleR) * (radius - 6);
-  int yNeedleR = centerYR - cos(angleR) * (radius - 6);
-  u8g2.drawLine(centerXR, centerYR - 8, xNeedleR, yNeedleR);
+  vu4BakeScale();   // jednorazowe – poza pomiarem, jak w vuMeterMode4()
+  uint32_t floatUs = 0, tableUs = 0, diffPixels = 0;
+
+  for (uint16_t f = 0; f < frames; f++)
+  {
+    const int levelL = random(101);
+    const int levelR = random(101);
+
+    bench.clearBuffer();
+    uint32_t t0 = micros();
+    legacyFrame(levelL, levelR);
+    floatUs += micros() - t0;
+    memcpy(refBuf, benchBuf, bufBytes);
+
+    bench.clearBuffer();
+    t0 = micros();
+    vu4DrawScale(bench);
+    vu4DrawNeedles(bench, levelL, levelR);
+    tableUs += micros() - t0;
+    for (size_t i = 0; i < bufBytes; i++) diffPixels += __builtin_popcount(refBuf[i] ^ benchBuf[i]);
+  }
+
+  String json = "{";
+  json += "\"style\":4,";
+  json += "\"frames\":"     + String(frames) + ",";
+  json += "\"floatUs\":"    + String((float)floatUs / frames, 1) + ",";
+  json += "\"tableUs\":"    + String((float)tableUs / frames, 1) + ",";
+  json += "\"speedup\":"    + String(tableUs ? (float)floatUs / (float)tableUs : 0.0f, 2) + ",";
+  json += "\"diffPixels\":" + String((float)diffPixels / frames, 1);
+  json += "}";
+  return json;
 }
 
 void showIP(uint16_t xip, uint16_t yip)
@@ -5141,7 +5379,7 @@ void displayClearUnderScroller() // Funkcja odpwoiedzialna za przewijanie inform
     u8g2.drawStr(0,yPositionDisplayScrollerMode5, "                                           "); //43 spacje - czyszczenie ekranu   
   }
   */
-  u8g2.sendBuffer();  // rysujemy całą zawartosc ekranu.  
+  oledFlush();  // rysujemy całą zawartosc ekranu.  
 }
 
 void displayRadioScroller() // Funkcja odpwoiedzialna za przewijanie informacji strem tittle lub stringstation
@@ -5165,13 +5403,18 @@ void displayRadioScroller() // Funkcja odpwoiedzialna za przewijanie informacji
       xPositionStationString = offset;
       u8g2.setFont(spleen6x12PL);
       u8g2.setDrawColor(1);
-      do {
-        u8g2.drawStr(xPositionStationString, yPositionDisplayScrollerMode0, stationStringScroll.c_str());
-        xPositionStationString = xPositionStationString + stationStringScrollWidth;
-      } while (xPositionStationString < 256);
+      // Tekst wyrenderowany raz do paska – krok to kopiowanie kolumn; drawStr() tylko awaryjnie
+      if (!scrollStripPrepare(stationStringScroll.c_str(), stationStringScrollWidth, yPositionDisplayScrollerMode0, spleen6x12PL) ||
+          !scrollStripDraw(u8g2, (int16_t)offset))
+      {
+        do {
+          u8g2.drawStr(xPositionStationString, yPositionDisplayScrollerMode0, stationStringScroll.c_str());
+          xPositionStationString = xPositionStationString + stationStringScrollWidth;
+        } while (xPositionStationString < 256);
+      }
       
       offset = offset - 1;
-      if (offset < (65535 - stationStringScrollWidth)) { 
+      if (offset <= (65536 - stationStringScrollWidth)) {  // pozycje 0..-(szerokość-1), potem od nowa bez zatrzymania
         offset = 0;
       }
 
@@ -5191,14 +5434,18 @@ void displayRadioScroller() // Funkcja odpwoiedzialna za przewijanie informacji
       xPositionStationString = offset;
       u8g2.setFont(spleen6x12PL);
       u8g2.setDrawColor(1);
-      do {
-        u8g2.drawStr(xPositionStationString, yPositionDisplayScrollerMode1, stationStringScroll.c_str());
-
-        xPositionStationString = xPositionStationString + stationStringScrollWidth;
-      } while (xPositionStationString < 256);
+      // Tekst wyrenderowany raz do paska – krok to kopiowanie kolumn; drawStr() tylko awaryjnie
+      if (!scrollStripPrepare(stationStringScroll.c_str(), stationStringScrollWidth, yPositionDisplayScrollerMode1, spleen6x12PL) ||
+          !scrollStripDraw(u8g2, (int16_t)offset))
+      {
+        do {
+          u8g2.drawStr(xPositionStationString, yPositionDisplayScrollerMode1, stationStringScroll.c_str());
+          xPositionStationString = xPositionStationString + stationStringScrollWidth;
+        } while (xPositionStationString < 256);
+      }
       
       offset = offset - 1;
-      if (offset < (65535 - stationStringScrollWidth)) {
+      if (offset <= (65536 - stationStringScrollWidth)) {  // pozycje 0..-(szerokość-1), potem od nowa bez zatrzymania
         offset = 0;
       }
 
@@ -5269,13 +5516,18 @@ void displayRadioScroller() // Funkcja odpwoiedzialna za przewijanie informacji
       xPositionStationString = offset;
       u8g2.setFont(spleen6x12PL);
       u8g2.setDrawColor(1);
-      do {
-        u8g2.drawStr(xPositionStationString, yPositionDisplayScrollerMode3, stationStringScroll.c_str());
-        xPositionStationString = xPositionStationString + stationStringScrollWidth;
-      } while (xPositionStationString < 256);
+      // Tekst wyrenderowany raz do paska – krok to kopiowanie kolumn; drawStr() tylko awaryjnie
+      if (!scrollStripPrepare(stationStringScroll.c_str(), stationStringScrollWidth, yPositionDisplayScrollerMode3, spleen6x12PL) ||
+          !scrollStripDraw(u8g2, (int16_t)offset))
+      {
+        do {
+          u8g2.drawStr(xPositionStationString, yPositionDisplayScrollerMode3, stationStringScroll.c_str());
+          xPositionStationString = xPositionStationString + stationStringScrollWidth;
+        } while (xPositionStationString < 256);
+      }
       
       offset = offset - 1;
-      if (offset < (65535 - stationStringScrollWidth)) { 
+      if (offset <= (65536 - stationStringScrollWidth)) {  // pozycje 0..-(szerokość-1), potem od nowa bez zatrzymania
         offset = 0;
       }
     } else {
@@ -5335,7 +5587,7 @@ void handleKeyboard()
     u8g2.clearBuffer();
     u8g2.setCursor(10,10); u8g2.print("ADC:   " + String(keyboardValue));
     u8g2.setCursor(10,23); u8g2.print("BUTTON:" + String(keyboardButtonPressed));
-    u8g2.sendBuffer(); 
+    oledFlush(); 
     Serial.print("debug - ADC odczyt: ");
     Serial.print(keyboardValue);
     Serial.print(" flaga przycisk wcisniety:");
@@ -5473,7 +5725,7 @@ void volumeDisplay()
   u8g2.drawRFrame(21, 42, 214, 14, 3);                                                   // Rysujmey ramke dla progress bara głosnosci
   if (maxVolume == 42 && volumeValue > 0) { u8g2.drawRBox(23, 44, volumeValue * 5, 10, 2);}  // Progress bar głosnosci
   if (maxVolume == 21 && volumeValue > 0) { u8g2.drawRBox(23, 44, volumeValue * 10, 10, 2);} // Progress bar głosnosci
-  u8g2.sendBuffer();
+  oledFlush();
   wsVolumeChange(volumeValue); // Wyślij aktualizację przez WebSocket na strone WWW
   }
 
@@ -5916,7 +6168,7 @@ void displayEqualizer() // Funkcja rysująca menu 3-punktowego equalizera
     if ( toneLowValue < 0 )  { u8g2.drawRBox((2 * toneLowValue) + xTone + 138,yTone-7,10,5,1);}
     //u8g2.drawRBox((3 * toneLowValue) + xTone + 138,yTone-7,10,6,1);
   }
-  u8g2.sendBuffer(); 
+  oledFlush(); 
 }
 
 
@@ -5945,7 +6197,7 @@ String chipSN = buf;
   u8g2.setCursor(0,51); u8g2.print("WiFi SSID:" + String(wifiManager.getWiFiSSID()));
   u8g2.setCursor(0,64); u8g2.print("IP:" + currentIP + "  MAC:" + String(WiFi.macAddress()) );
   
-  u8g2.sendBuffer();
+  oledFlush();
 }
 /*
 void audioProcessing(void *p)
@@ -5965,7 +6217,7 @@ void handlePreOtaUpdateCallback()
   {
     u8g2.setCursor(1,56); u8g2.printf("Update: %u%%\r", (progress / (total / 100)) );
     u8g2.setCursor(80,56); u8g2.print(String(progress) + "/" + String(total));
-    u8g2.sendBuffer();
+    oledFlush();
     Serial.printf("Progress: %u%%\r", (progress / (total / 100)));
   });
 }
@@ -5980,12 +6232,12 @@ void recoveryModeCheck()
     u8g2.clearBuffer();
     u8g2.setFont(spleen6x12PL);
     u8g2.drawStr(1,14, "RECOVERY / RESET MODE - release encoder");
-    u8g2.sendBuffer();
+    oledFlush();
     delay(2000);
 
     while (digitalRead(SW_PIN2) == 0) {delay(10);}  
     u8g2.drawStr(1,14, "Please Wait...                         ");
-    u8g2.sendBuffer();
+    oledFlush();
     delay(1000);
     u8g2.clearBuffer();
      
@@ -6025,7 +6277,7 @@ void recoveryModeCheck()
         u8g2.drawStr(1,28, "   RESET BANK=1, STATION=1   ");
         u8g2.drawStr(1,42, ">> RESET WIFI SSID, PASSWD <<");      
       }
-      u8g2.sendBuffer();
+      oledFlush();
       
       if (digitalRead(SW_PIN2) == 0)
       {
@@ -6037,7 +6289,7 @@ void recoveryModeCheck()
           u8g2.clearBuffer(); 
           u8g2.drawStr(1,14, "SET BANK=1, STATION=1         ");
           u8g2.drawStr(1,28, "ESP will RESET in 3sec.       ");
-          u8g2.sendBuffer();
+          oledFlush();
           delay(3000);
           ESP.restart();
         }  
@@ -6046,7 +6298,7 @@ void recoveryModeCheck()
           u8g2.clearBuffer();
           u8g2.drawStr(1,14, "WIFI SSID, PASSWD CLEARED   ");
           u8g2.drawStr(1,28, "ESP will RESET in 3sec.     ");
-          u8g2.sendBuffer();
+          oledFlush();
           wifiManager.resetSettings();
           delay(3000);
           ESP.restart();
@@ -6331,7 +6583,7 @@ void handleEncoder2StationsVolumeClick()
     volumeSet = false;
     changeStation();
     displayRadio();
-    u8g2.sendBuffer();
+    oledFlush();
     clearFlags();
   }
 
@@ -7008,7 +7260,7 @@ void webUrlStationPlay()
   u8g2.clearBuffer();
   u8g2.setFont(u8g2_font_fub14_tf); // cziocnka 14x11
   u8g2.drawStr(34, 33, "Loading stream..."); // 8 znakow  x 11 szer
-  u8g2.sendBuffer();
+  oledFlush();
 
   mp3 = flac = aac = vorbis = opus = false;
   streamCodec = "";
@@ -7039,7 +7291,7 @@ void webUrlStationPlay()
     
     u8g2.setFont(spleen6x12PL);  // wypisujemy jaki stream jakie stacji jest ładowany
     u8g2.drawStr(34, 55, String(url2play).c_str());
-    u8g2.sendBuffer();
+    oledFlush();
     
     station_nr = 0;
     bank_nr = 0;
@@ -7589,7 +7841,7 @@ void displayCenterBigText(String stringText, int stringText_Y)
   int stringText_X = (SCREEN_WIDTH - stringTextWidth) / 2;
   u8g2.clearBuffer();
   u8g2.drawStr(stringText_X, stringText_Y, stringText.c_str());     
-  u8g2.sendBuffer();
+  oledFlush();
   //Serial.print("debug sleep -> Chart Max Height: ");       
   //Serial.println(u8g2.getMaxCharHeight(stringText.substring(0,1).c_str()));
   Serial.println(u8g2.getMaxCharHeight());
@@ -7641,7 +7893,7 @@ void powerOffAnimation()
     int boxHeight = height - 2 * i;
     u8g2.drawBox(0, i, width, boxHeight);
 
-    u8g2.sendBuffer();
+    oledFlush();
     delay(20); // czas między krokami animacji
   }
 
@@ -7650,13 +7902,13 @@ void powerOffAnimation()
   {
     u8g2.clearBuffer();
     u8g2.drawHLine(0, height / 2, width);
-    u8g2.sendBuffer();
+    oledFlush();
     delay(50);
   }
 
   // Całkowite wygaszenie
   u8g2.clearBuffer();
-  u8g2.sendBuffer();
+  oledFlush();
 }
 
 void displaySleepTimer()
@@ -7775,7 +8027,7 @@ void powerOffClock()
     u8g2.clearBuffer();
     u8g2.setFont(u8g2_font_7Segments_26x42_mn);
     u8g2.drawStr(40, 52, "--:--");
-    u8g2.sendBuffer();
+    oledFlush();
     return;  // Zakończ funkcję, gdy nie udało się uzyskać czasu
   }
       
@@ -7790,7 +8042,7 @@ void powerOffClock()
   snprintf(timeString, sizeof(timeString), "%2d:%02d", timeinfo.tm_hour, timeinfo.tm_min);
   u8g2.clearBuffer();
   u8g2.drawStr(53, 52, timeString);
-  u8g2.sendBuffer();
+  oledFlush();
 }
 
 void powerOff()
@@ -8020,7 +8272,78 @@ void startOta()
   u8g2.setDrawColor(1);
   u8g2.setFont(spleen6x12PL);     
   u8g2.setCursor(5, 12); u8g2.print("Evo Radio, OTA Firwmare Update");
-  u8g2.sendBuffer();
+  oledFlush();
+}
+
+// Pola formularza /analyzer (POST) -> AnalyzerStyleCfg; brak pola = bez zmiany,
+// poza checkboxami (niezaznaczony nie przychodzi). Wspólne dla Save/Apply/Preview.
+static void analyzerStyleFromForm(AsyncWebServerRequest *request, AnalyzerStyleCfg& c)
+{
+  auto getInt = [&](const char* n, int def)->int {
+    if(!request->hasParam(n, true)) return def;
+    return request->getParam(n, true)->value().toInt();
+  };
+  auto getFloat = [&](const char* n, float def)->float {
+    if(!request->hasParam(n, true)) return def;
+    return request->getParam(n, true)->value().toFloat();
+  };
+  auto getBool = [&](const char* n)->bool {
+    return request->hasParam(n, true) && request->getParam(n, true)->value() == "1";
+  };
+
+  // Styl 5
+  c.s5_barWidth = (uint8_t)getInt("s5w", c.s5_barWidth);
+  c.s5_barGap   = (uint8_t)getInt("s5g", c.s5_barGap);
+  c.s5_segments = (uint8_t)getInt("s5seg", c.s5_segments);
+  c.s5_segHeight = (uint8_t)getInt("s5segH", c.s5_segHeight);
+  c.s5_fill     = getFloat("s5fill", c.s5_fill);
+  c.s5_showPeaks = getBool("s5peaks");
+
+  // Styl 6
+  c.s6_gap      = (uint8_t)getInt("s6g", c.s6_gap);
+  c.s6_shrink   = (uint8_t)getInt("s6sh", c.s6_shrink);
+  c.s6_fill     = getFloat("s6fill", c.s6_fill);
+  c.s6_segMin   = (uint8_t)getInt("s6min", c.s6_segMin);
+  c.s6_segMax   = (uint8_t)getInt("s6max", c.s6_segMax);
+  c.s6_showPeaks = getBool("s6peaks");
+
+  // Styl 7 (Okrągły)
+  c.s7_circleRadius = (uint8_t)getInt("s7radius", c.s7_circleRadius);
+  c.s7_circleGap = (uint8_t)getInt("s7gap", c.s7_circleGap);
+  c.s7_filled = getBool("s7filled");
+  c.s7_maxHeight = (uint8_t)getInt("s7max", c.s7_maxHeight);
+
+  // Styl 8 (Liniowy)
+  c.s8_lineThickness = (uint8_t)getInt("s8thick", c.s8_lineThickness);
+  c.s8_lineGap = (uint8_t)getInt("s8gap", c.s8_lineGap);
+  c.s8_gradient = getBool("s8grad");
+  c.s8_maxHeight = (uint8_t)getInt("s8max", c.s8_maxHeight);
+
+  // Styl 9 (Gwiazda 6-ramienna)
+  c.s9_starRadius = (uint8_t)getInt("s9radius", c.s9_starRadius);
+  c.s9_armWidth = (uint8_t)getInt("s9armw", c.s9_armWidth);
+  c.s9_armLength = (uint8_t)getInt("s9arml", c.s9_armLength);
+  c.s9_spikeLength = (uint8_t)getInt("s9spike", c.s9_spikeLength);
+  c.s9_showSpikes = getBool("s9spikes");
+  c.s9_filled = getBool("s9filled");
+  c.s9_centerSize = (uint8_t)getInt("s9center", c.s9_centerSize);
+  c.s9_smoothness = (uint8_t)getInt("s9smooth", c.s9_smoothness);
+  c.s11_timebase = (uint8_t)getInt("s11tb", c.s11_timebase);
+
+  // Odświeżanie
+  c.s5_maxFps = (uint8_t)getInt("s5fps", c.s5_maxFps);
+  c.s6_maxFps = (uint8_t)getInt("s6fps", c.s6_maxFps);
+  c.s7_maxFps = (uint8_t)getInt("s7fps", c.s7_maxFps);
+  c.s8_maxFps = (uint8_t)getInt("s8fps", c.s8_maxFps);
+  c.s9_maxFps = (uint8_t)getInt("s9fps", c.s9_maxFps);
+  c.s10_maxFps = (uint8_t)getInt("s10fps", c.s10_maxFps);
+  c.s11_maxFps = (uint8_t)getInt("s11fps", c.s11_maxFps);
+  c.s12_maxFps = (uint8_t)getInt("s12fps", c.s12_maxFps);
+  c.fpsAdaptive = getBool("fpsAdapt");
+
+  // Globalne ustawienia
+  c.peakHoldTimeMs = (uint16_t)getInt("peakHoldMs", c.peakHoldTimeMs);
+  if (request->hasParam("gray", true)) c.grayscale = getBool("gray");   // brak pola = bez zmiany
 }
 
 //####################################################################################### SETUP ####################################################################################### //
@@ -8030,6 +8353,7 @@ void setup()
 
   // Inicjalizuj komunikację szeregową (Serial)
   Serial.begin(115200);
+  traceStart(); // TRACE() z callbacków audio i loop() wypisuje zadanie o najniższym priorytecie
     
   uint64_t chipid = ESP.getEfuseMac();
   Serial.println("");
@@ -8114,13 +8438,20 @@ void setup()
   
   audio.setPinout(I2S_BCLK, I2S_LRC, I2S_DOUT);  // Konfiguruj pinout dla interfejsu I2S audio
   
-  // Inicjalizuj interfejs SPI wyświetlacza
-  SPI.begin(SPI_SCK_OLED, SPI_MISO_OLED, SPI_MOSI_OLED);
-  SPI.setFrequency(2000000);
+  // Inicjalizuj interfejs SPI wyświetlacza – sterownik IDF z DMA, a gdy się nie uda SPIClass jak dawniej
+  if (!oledSpiDmaBegin(SPI_SCK_OLED, SPI_MOSI_OLED))
+  {
+    SPI.begin(SPI_SCK_OLED, SPI_MISO_OLED, SPI_MOSI_OLED);
+    SPI.setFrequency(2000000);
+  }
 
 
   // Inicjalizuj wyświetlacz i odczekaj na włączenie
   u8g2.begin();
+  oledInvalidate();  // pierwsza ramka idzie w całości
+  trigInit();        // tablica sin/cos przed pierwszym rysowaniem (loop i zadanie OLED)
+  vu4BakeScale();    // skala stylu 4 z tablicy – potem tylko odczyt (loop i /vuBench)
+  oledRenderStart(); // transfer SPI i style 5-9 w osobnym zadaniu na Core1
   delay(50); // Jeszcze bardziej skrócony czas inicjalizacji
   
   // ----------------- KARTA SD / PAMIEC SPIFFS - Inicjalizacja -----------------
@@ -8139,6 +8470,10 @@ void setup()
   readConfig();
   // Wczytaj osobny config wyglądu analizatora (/analyzer)
   analyzerStyleLoad();
+#ifdef USE_RUNTIME_EQ
+  eq_peq_load();             // Pasma korektora parametrycznego z /peq.cfg
+  eq_runtime_init();         // eqWorker + pierwszy blok parametrów (nie w callbacku audio)
+#endif
   eq_analyzer_init();
   eq_analyzer_set_enabled(eqAnalyzerOn);   // Set initial state from config
 if (configExist == false) { saveConfig(); readConfig();} // Jesli nie ma pliku config.txt to go tworzymy
@@ -8155,7 +8490,7 @@ if (configExist == false) { saveConfig(); readConfig();} // Jesli nie ma pliku c
     else
     {
       u8g2.drawXBMP(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, logo_bits); // obrazek - logo z pamieci
-      u8g2.sendBuffer();
+      oledFlush();
       delay(200); // Jeszcze szybsze uruchamianie
     }   
     u8g2.setFont(u8g2_font_fub14_tf);
@@ -8164,7 +8499,7 @@ if (configExist == false) { saveConfig(); readConfig();} // Jesli nie ma pliku c
     u8g2.drawStr(38, 14, "Evo Internet Radio");
     u8g2.setFont(spleen6x12PL);
     u8g2.drawStr(208, 62, softwareRev);
-    u8g2.sendBuffer();
+    oledFlush();
   }
   
   /*
@@ -8187,14 +8522,14 @@ if (configExist == false) { saveConfig(); readConfig();} // Jesli nie ma pliku c
     u8g2.drawBox(212, 0, 44, 45);
     u8g2.setDrawColor(1);
     u8g2.drawXBMP(220, 3, 30, 40, sdcard);  // ikona SD karty
-    u8g2.sendBuffer();
+    oledFlush();
   }
   
   u8g2.setFont(spleen6x12PL);
   if ((esp_reset_reason() == ESP_RST_POWERON) && (f_sleepAfterPowerFail)) {u8g2.drawStr(5, 50, "Wakeup after power loss, syncing NTP");}
   u8g2.drawStr(5, 62, "Connecting to network...    ");
 
-  u8g2.sendBuffer();
+  oledFlush();
   //u8g2.sendF("ca", 0xC7, displayBrightness); // Ustawiamy jasność ekranu zgodnie ze zmienna displayBrightness
   #ifdef twoEncoders
     button1.setDebounceTime(50);  // Ustawienie czasu debouncingu dla przycisku enkodera 2
@@ -8247,10 +8582,10 @@ if (configExist == false) { saveConfig(); readConfig();} // Jesli nie ma pliku c
     currentIP = WiFi.localIP().toString();  //konwersja IP na string
     u8g2.setFont(spleen6x12PL);
     u8g2.drawStr(5, 62, "                               ");  // czyszczenie lini spacjami
-    u8g2.sendBuffer();
+    oledFlush();
     u8g2.drawStr(5, 62, "Connected, IP:");  //wyswietlenie IP
     u8g2.drawStr(90, 62, currentIP.c_str());   //wyswietlenie IP
-    u8g2.sendBuffer();
+    oledFlush();
     delay(150);  // Jeszcze bardziej skrócone opóźnienie
     
     if (MDNS.begin(hostname)) { Serial.println("mDNS wystartowal, adres: " + String(hostname) + ".local w przeglądarce"); MDNS.addService("http", "tcp", 80);}
@@ -8384,7 +8719,7 @@ if (configExist == false) { saveConfig(); readConfig();} // Jesli nie ma pliku c
           Serial.printf("Progress: %d%% (%u/%u bytes)\n", percent, total, contentLength);
           u8g2.setCursor(5, 24); u8g2.print("File: " + String(filename));
           u8g2.setCursor(5, 36); u8g2.print("Flashing... " + String(total / 1024) + " KB");
-          u8g2.sendBuffer();
+          oledFlush();
           lastPrint = now;
         }
       }
@@ -8395,7 +8730,7 @@ if (configExist == false) { saveConfig(); readConfig();} // Jesli nie ma pliku c
           request->send(200, "text/plain", "Update done - reset in 3sec");
           Serial.println("Update complete");
           u8g2.setCursor(5, 48); u8g2.print("Completed - reset in 3sec");
-          u8g2.sendBuffer();
+          oledFlush();
               
           AsyncWebServerRequest *reqCopy = request;
           reqCopy->onDisconnect([]() 
@@ -8445,7 +8780,7 @@ if (configExist == false) { saveConfig(); readConfig();} // Jesli nie ma pliku c
       u8g2.setDrawColor(1);
       u8g2.setFont(spleen6x12PL);     
       u8g2.setCursor(5, 12); u8g2.print("Evo Radio, OTA Firwmare Update");
-      u8g2.sendBuffer();
+      oledFlush();
 
       /*
       String html = "";
@@ -9074,60 +9409,7 @@ server.on("/analyzer", HTTP_GET, [](AsyncWebServerRequest *request){
 
 server.on("/analyzerSave", HTTP_POST, [](AsyncWebServerRequest *request){
   AnalyzerStyleCfg c = analyzerGetStyle();
-
-  auto getInt = [&](const char* n, int def)->int {
-    if(!request->hasParam(n, true)) return def;
-    return request->getParam(n, true)->value().toInt();
-  };
-  auto getFloat = [&](const char* n, float def)->float {
-    if(!request->hasParam(n, true)) return def;
-    return request->getParam(n, true)->value().toFloat();
-  };
-  auto getBool = [&](const char* n)->bool {
-    return request->hasParam(n, true) && request->getParam(n, true)->value() == "1";
-  };
-
-  // Styl 5
-  c.s5_barWidth = (uint8_t)getInt("s5w", c.s5_barWidth);
-  c.s5_barGap   = (uint8_t)getInt("s5g", c.s5_barGap);
-  c.s5_segments = (uint8_t)getInt("s5seg", c.s5_segments);
-  c.s5_segHeight = (uint8_t)getInt("s5segH", c.s5_segHeight);
-  c.s5_fill     = getFloat("s5fill", c.s5_fill);
-  c.s5_showPeaks = getBool("s5peaks");
-
-  // Styl 6
-  c.s6_gap      = (uint8_t)getInt("s6g", c.s6_gap);
-  c.s6_shrink   = (uint8_t)getInt("s6sh", c.s6_shrink);
-  c.s6_fill     = getFloat("s6fill", c.s6_fill);
-  c.s6_segMin   = (uint8_t)getInt("s6min", c.s6_segMin);
-  c.s6_segMax   = (uint8_t)getInt("s6max", c.s6_segMax);
-  c.s6_showPeaks = getBool("s6peaks");
-
-  // Styl 7 (Okrągły)
-  c.s7_circleRadius = (uint8_t)getInt("s7radius", c.s7_circleRadius);
-  c.s7_circleGap = (uint8_t)getInt("s7gap", c.s7_circleGap);
-  c.s7_filled = getBool("s7filled");
-  c.s7_maxHeight = (uint8_t)getInt("s7max", c.s7_maxHeight);
-
-  // Styl 8 (Liniowy)
-  c.s8_lineThickness = (uint8_t)getInt("s8thick", c.s8_lineThickness);
-  c.s8_lineGap = (uint8_t)getInt("s8gap", c.s8_lineGap);
-  c.s8_gradient = getBool("s8grad");
-  c.s8_maxHeight = (uint8_t)getInt("s8max", c.s8_maxHeight);
-
-  // Styl 9 (Gwiazda 6-ramienna)
-  c.s9_starRadius = (uint8_t)getInt("s9radius", c.s9_starRadius);
-  c.s9_armWidth = (uint8_t)getInt("s9armw", c.s9_armWidth);
-  c.s9_armLength = (uint8_t)getInt("s9arml", c.s9_armLength);
-  c.s9_spikeLength = (uint8_t)getInt("s9spike", c.s9_spikeLength);
-  c.s9_showSpikes = getBool("s9spikes");
-  c.s9_filled = getBool("s9filled");
-  c.s9_centerSize = (uint8_t)getInt("s9center", c.s9_centerSize);
-  c.s9_smoothness = (uint8_t)getInt("s9smooth", c.s9_smoothness);
-
-  // Globalne ustawienia
-  c.peakHoldTimeMs = (uint16_t)getInt("peakHoldMs", c.peakHoldTimeMs);
-
+  analyzerStyleFromForm(request, c);
   analyzerSetStyle(c);
   analyzerStyleSave();
 
@@ -9137,67 +9419,207 @@ server.on("/analyzerSave", HTTP_POST, [](AsyncWebServerRequest *request){
 // Live podgląd: stosuje parametry od razu (bez zapisu)
 server.on("/analyzerApply", HTTP_POST, [](AsyncWebServerRequest *request){
   AnalyzerStyleCfg c = analyzerGetStyle();
+  analyzerStyleFromForm(request, c);
+  analyzerSetStyle(c);
+  request->send(200, "text/plain", "OK");
+});
 
-  auto getInt = [&](const char* n, int def)->int {
-    if(!request->hasParam(n, true)) return def;
-    return request->getParam(n, true)->value().toInt();
-  };
-  auto getFloat = [&](const char* n, float def)->float {
-    if(!request->hasParam(n, true)) return def;
-    return request->getParam(n, true)->value().toFloat();
-  };
-  auto getBool = [&](const char* n)->bool {
-    return request->hasParam(n, true) && request->getParam(n, true)->value() == "1";
+// (opcjonalnie) podejrzyj aktualne wartości w JSON
+server.on("/analyzerCfg", HTTP_GET, [](AsyncWebServerRequest *request){
+  request->send(200, "application/json", analyzerStyleToJson());
+});
+
+// Statystyki wysyłania ramek OLED (kafelki wysłane vs pełny sendBuffer, czas oledFlush)
+server.on("/displayStats", HTTP_GET, [](AsyncWebServerRequest *request){
+  if (request->hasParam("reset")) { oledResetStats(); }
+  request->send(200, "application/json", oledStatsToJson());
+});
+
+// Stan zadany dla testów zrzutów: mode, mute, station+title, vuL/vuR/ppmL/ppmR [dBFS]; off=1 przywraca
+server.on("/displayScript", HTTP_POST, [](AsyncWebServerRequest *request){
+  auto getParamStr = [&](const char* n)->String {
+    return request->hasParam(n, true) ? request->getParam(n, true)->value() : String();
   };
+  if (displayScriptPending) { request->send(409, "text/plain", "Busy"); return; }
 
-  // Styl 5
-  c.s5_barWidth = (uint8_t)getInt("s5w", c.s5_barWidth);
-  c.s5_barGap   = (uint8_t)getInt("s5g", c.s5_barGap);
-  c.s5_segments = (uint8_t)getInt("s5seg", c.s5_segments);
-  c.s5_segHeight = (uint8_t)getInt("s5segH", c.s5_segHeight);
-  c.s5_fill     = getFloat("s5fill", c.s5_fill);
-  c.s5_showPeaks = getBool("s5peaks");
+  displayScriptReq.off = getParamStr("off").toInt() != 0;
+  if (displayScriptReq.off)
+  {
+    eq_vu_set_script(false, 0, 0, 0, 0);
+  }
+  else
+  {
+    const int mode = request->hasParam("mode", true) ? getParamStr("mode").toInt() : displayMode;
+    if (mode < 0 || mode > 12) { request->send(400, "text/plain", "Mode 0-12"); return; }
+    displayScriptReq.mode = (uint8_t)mode;
+    displayScriptReq.mute = getParamStr("mute").toInt() != 0;
+    displayScriptReq.setText = request->hasParam("station", true);
+    displayScriptReq.station = getParamStr("station");
+    displayScriptReq.title = getParamStr("title");
+    if (request->hasParam("vuL", true))
+    {
+      const float vuL = getParamStr("vuL").toFloat();
+      const float vuR = request->hasParam("vuR", true) ? getParamStr("vuR").toFloat() : vuL;
+      const float ppmL = request->hasParam("ppmL", true) ? getParamStr("ppmL").toFloat() : vuL;
+      const float ppmR = request->hasParam("ppmR", true) ? getParamStr("ppmR").toFloat() : vuR;
+      eq_vu_set_script(true, vuL, vuR, ppmL, ppmR);
+    }
+  }
+  displayScriptPending = true;
+  request->send(204);
+});
 
-  // Styl 6
-  c.s6_gap      = (uint8_t)getInt("s6g", c.s6_gap);
-  c.s6_shrink   = (uint8_t)getInt("s6sh", c.s6_shrink);
-  c.s6_fill     = getFloat("s6fill", c.s6_fill);
-  c.s6_segMin   = (uint8_t)getInt("s6min", c.s6_segMin);
-  c.s6_segMax   = (uint8_t)getInt("s6max", c.s6_segMax);
-  c.s6_showPeaks = getBool("s6peaks");
+// Zrzut ekranu OLED (PBM 256x64) – podgląd i porównanie z wzorcem bez sprzętu obok
+server.on("/display.pbm", HTTP_GET, [](AsyncWebServerRequest *request){
+  uint8_t* pbm = (uint8_t*)malloc(OLED_PBM_BYTES);
+  size_t len = pbm ? oledSnapshotPbm(pbm, OLED_PBM_BYTES) : 0;
+  if (len == 0) { free(pbm); request->send(503, "text/plain", "No frame"); return; }
+  AsyncResponseStream *response = request->beginResponseStream("image/x-portable-bitmap");
+  response->write(pbm, len);
+  free(pbm);
+  request->send(response);
+});
 
-  // Styl 7 (Okrągły)
-  c.s7_circleRadius = (uint8_t)getInt("s7radius", c.s7_circleRadius);
-  c.s7_circleGap = (uint8_t)getInt("s7gap", c.s7_circleGap);
-  c.s7_filled = getBool("s7filled");
-  c.s7_maxHeight = (uint8_t)getInt("s7max", c.s7_maxHeight);
+// Podgląd stylu 5-12 bez zmiany ekranu (PBM 256x64): ?mode=N, domyślnie bieżący tryb;
+// POST z polami formularza /analyzer rysuje niezapisane ustawienia.
+// Rysuje zadanie renderujące w swoim budżecie – tu tylko zamówienie i ostatni gotowy
+// podgląd z numerem X-Preview-Seq, bez czekania w async_tcp; brak podglądu tego trybu = 202.
+server.on("/analyzerPreview", HTTP_GET | HTTP_POST, [](AsyncWebServerRequest *request){
+  uint8_t mode = request->hasParam("mode") ? (uint8_t)request->getParam("mode")->value().toInt() : (uint8_t)displayMode;
+  if (mode < 5 || mode > 12) { request->send(400, "text/plain", "Mode 5-12"); return; }
+  // POST = pola formularza /analyzer: podgląd z niezapisanymi ustawieniami, g_cfg bez zmian
+  AnalyzerStyleCfg c = analyzerGetStyle();
+  const bool fromForm = request->method() == HTTP_POST;
+  if (fromForm) analyzerStyleFromForm(request, c);
+  if (!oledPreviewRequest(mode, fromForm ? &c : nullptr)) { request->send(503, "text/plain", "No render task"); return; }
+
+  uint8_t* pbm = (uint8_t*)malloc(OLED_PBM_BYTES);
+  uint8_t got = 0;
+  uint32_t seq = 0;
+  size_t len = pbm ? oledPreviewPbm(pbm, OLED_PBM_BYTES, &got, &seq) : 0;
+  if (len == 0 || got != mode)
+  {
+    free(pbm);
+    AsyncWebServerResponse *pending = request->beginResponse(202, "text/plain", "Preview pending");
+    pending->addHeader("Retry-After", "1");
+    pending->addHeader("Cache-Control", "no-store");
+    request->send(pending);
+    return;
+  }
+  AsyncResponseStream *response = request->beginResponseStream("image/x-portable-bitmap");
+  response->addHeader("Cache-Control", "no-store");
+  response->addHeader("X-Preview-Seq", String(seq));
+  response->addHeader("X-Preview-Mode", String(got));
+  response->write(pbm, len);
+  free(pbm);
+  request->send(response);
+});
 
-  // Styl 8 (Liniowy)
-  c.s8_lineThickness = (uint8_t)getInt("s8thick", c.s8_lineThickness);
-  c.s8_lineGap = (uint8_t)getInt("s8gap", c.s8_lineGap);
-  c.s8_gradient = getBool("s8grad");
-  c.s8_maxHeight = (uint8_t)getInt("s8max", c.s8_maxHeight);
+// FPS stylów 5-9: osiągnięte, limit, klatki pominięte (brak danych / limit)
+server.on("/analyzerFps", HTTP_GET, [](AsyncWebServerRequest *request){
+  if (request->hasParam("reset")) { analyzerFpsResetStats(); }
+  request->send(200, "application/json", analyzerFpsToJson());
+});
 
-  // Styl 9 (Gwiazda 6-ramienna)
-  c.s9_starRadius = (uint8_t)getInt("s9radius", c.s9_starRadius);
-  c.s9_armWidth = (uint8_t)getInt("s9armw", c.s9_armWidth);
-  c.s9_armLength = (uint8_t)getInt("s9arml", c.s9_armLength);
-  c.s9_spikeLength = (uint8_t)getInt("s9spike", c.s9_spikeLength);
-  c.s9_showSpikes = getBool("s9spikes");
-  c.s9_filled = getBool("s9filled");
-  c.s9_centerSize = (uint8_t)getInt("s9center", c.s9_centerSize);
-  c.s9_smoothness = (uint8_t)getInt("s9smooth", c.s9_smoothness);
-  
-  // Globalne ustawienia
-  c.peakHoldTimeMs = (uint16_t)getInt("peakHoldMs", c.peakHoldTimeMs);
+// Słupki stylu 5/6: drawBox() kontra kolumny wprost w bufor (?style=5|6&frames=N)
+server.on("/analyzerBench", HTTP_GET, [](AsyncWebServerRequest *request){
+  uint8_t  style  = request->hasParam("style")  ? request->getParam("style")->value().toInt()  : 5;
+  uint16_t frames = request->hasParam("frames") ? request->getParam("frames")->value().toInt() : 1000;
+  request->send(200, "application/json", analyzerBarsBenchToJson(style, frames));
+});
 
-  analyzerSetStyle(c);
-  request->send(200, "text/plain", "OK");
+// Klatka stylu VU 4: tablica trig kontra dawne sin()/cos() w double (?frames=N)
+server.on("/vuBench", HTTP_GET, [](AsyncWebServerRequest *request){
+  uint16_t frames = request->hasParam("frames") ? request->getParam("frames")->value().toInt() : 500;
+  request->send(200, "application/json", vuMode4BenchToJson(frames));
 });
 
-// (opcjonalnie) podejrzyj aktualne wartości w JSON
-server.on("/analyzerCfg", HTTP_GET, [](AsyncWebServerRequest *request){
-  request->send(200, "application/json", analyzerStyleToJson());
+// Śledzenie TRACE(): ?mask=bity kategorii (np. 0x2 = AUDIO), ?level=1-4, ?reset zeruje liczniki
+server.on("/trace", HTTP_GET, [](AsyncWebServerRequest *request){
+  if (request->hasParam("mask")) { traceSetMask((uint32_t)strtoul(request->getParam("mask")->value().c_str(), nullptr, 0)); }
+  if (request->hasParam("level")) { traceSetLevel((uint8_t)request->getParam("level")->value().toInt()); }
+  if (request->hasParam("reset")) { traceResetStats(); }
+  request->send(200, "application/json", traceStatsToJson());
+});
+
+// Profil stylów 5-9: czas rysowania każdego widżetu, tło z cache vs rysowane
+server.on("/analyzerProfile", HTTP_GET, [](AsyncWebServerRequest *request){
+  if (request->hasParam("reset")) { analyzerProfileReset(); }
+  request->send(200, "application/json", analyzerProfileToJson());
+});
+
+// Historia pasm stylu 10 do podglądu zdalnego: ?format=pgm – obraz P5
+// (kolumna = klatka, najnowsza z prawej, niskie pasma na dole), inaczej JSON
+server.on("/analyzerWaterfall", HTTP_GET, [](AsyncWebServerRequest *request){
+  uint8_t* hist = (uint8_t*)malloc(ANALYZER_WF_FRAMES * EQ_BANDS);
+  if (!hist) { request->send(503, "text/plain", "No memory"); return; }
+  uint32_t seq = 0;
+  uint16_t frames = analyzerWaterfallSnapshot(hist, ANALYZER_WF_FRAMES * EQ_BANDS, &seq);
+
+  bool pgm = request->hasParam("format") && request->getParam("format")->value() == "pgm";
+  AsyncResponseStream *response = request->beginResponseStream(pgm ? "image/x-portable-graymap" : "application/json");
+  if (pgm)
+  {
+    response->printf("P5\n%u %u\n255\n", frames ? frames : 1, EQ_BANDS);
+    for (int8_t b = EQ_BANDS - 1; b >= 0; b--)
+    {
+      if (frames == 0) response->write((uint8_t)0);
+      for (uint16_t k = 0; k < frames; k++) response->write((uint8_t)(hist[k * EQ_BANDS + b] * 255 / 100));
+    }
+  }
+  else
+  {
+    response->printf("{\"bands\":%u,\"frames\":%u,\"seq\":%u,\"levels\":[", EQ_BANDS, frames, seq);
+    for (uint16_t k = 0; k < frames; k++)
+    {
+      response->print(k ? ",[" : "[");
+      for (uint8_t b = 0; b < EQ_BANDS; b++) response->printf(b ? ",%u" : "%u", hist[k * EQ_BANDS + b]);
+      response->print("]");
+    }
+    response->print("]}");
+  }
+  free(hist);
+  request->send(response);
+});
+
+// Produkt analizatora dla klientów WWW: ?id=0..3 (bands16, bands32, bands64, spectrum).
+// Tylko kopia gotowego bufora – pierwsze zapytanie o FFT włącza je na 5 s.
+server.on("/analyzerSpectrum", HTTP_GET, [](AsyncWebServerRequest *request){
+  uint8_t id = request->hasParam("id") ? (uint8_t)request->getParam("id")->value().toInt() : EQ_PRODUCT_BANDS16;
+  if (id >= EQ_PRODUCTS) { request->send(400, "text/plain", "Bad id"); return; }
+  uint8_t data[EQ_PRODUCT_MAX_LEN];
+  uint32_t seq = 0;
+  uint16_t n = eq_analyzer_get_product(id, data, sizeof(data), &seq);
+
+  AsyncResponseStream *response = request->beginResponseStream("application/json");
+  response->printf("{\"id\":%u,\"name\":\"%s\",\"len\":%u,\"count\":%u,\"seq\":%u,\"rate\":%u,",
+                   id, eq_analyzer_product_name(id), eq_analyzer_product_len(id), n, seq,
+                   (unsigned)eq_analyzer_get_effective_rate());
+  if (id == EQ_PRODUCT_BANDS16) response->print("\"scale\":\"level\",\"data\":[");
+  else response->printf("\"scale\":\"db\",\"dbFloor\":%.1f,\"dbStep\":0.5,\"data\":[", EQ_PRODUCT_DB_FLOOR);
+  for (uint16_t k = 0; k < n; k++) response->printf(k ? ",%u" : "%u", data[k]);
+  response->print("]}");
+  request->send(response);
+});
+
+// Mierniki VU/PPM z hooka audio: ?truePeak=0/1 włącza nadpróbkowanie 4×, ?reset zeruje balistykę
+server.on("/vuMeter", HTTP_GET, [](AsyncWebServerRequest *request){
+  if (request->hasParam("truePeak")) { eq_vu_set_true_peak(request->getParam("truePeak")->value().toInt() != 0); }
+  if (request->hasParam("reset")) { eq_vu_reset(); }
+  eq_vu_snapshot_t vu;
+  bool fresh = eq_vu_get(&vu);
+  char json[480];
+  snprintf(json, sizeof(json),
+    "{\"fresh\":%d,\"truePeak\":%d,\"blocks\":%u,"
+    "\"rmsDb\":[%.1f,%.1f],\"vuDb\":[%.1f,%.1f],\"peakDb\":[%.1f,%.1f],"
+    "\"truePeakDb\":[%.1f,%.1f],\"ppmDb\":[%.1f,%.1f],"
+    "\"bar\":[%u,%u],\"barPeak\":[%u,%u],\"needle\":[%u,%u],\"clips\":[%u,%u]}",
+    fresh ? 1 : 0, eq_vu_get_true_peak() ? 1 : 0, (unsigned)vu.blocks,
+    vu.rmsDb[0], vu.rmsDb[1], vu.vuDb[0], vu.vuDb[1], vu.peakDb[0], vu.peakDb[1],
+    vu.truePeakDb[0], vu.truePeakDb[1], vu.ppmDb[0], vu.ppmDb[1],
+    vu.bar[0], vu.bar[1], vu.barPeak[0], vu.barPeak[1], vu.needle[0], vu.needle[1],
+    (unsigned)vu.clips[0], (unsigned)vu.clips[1]);
+  request->send(200, "application/json", json);
 });
 
 // Diagnostyka analizatora
@@ -9225,6 +9647,45 @@ server.on("/analyzerPreset", HTTP_POST, [](AsyncWebServerRequest *request){
   request->redirect("/analyzer");
 });
 
+#ifdef USE_RUNTIME_EQ
+// Korektor parametryczny: odczyt wszystkich pasm (JSON)
+server.on("/peq", HTTP_GET, [](AsyncWebServerRequest *request){
+  request->send(200, "application/json", eq_peq_to_json());
+});
+
+// Korektor parametryczny: mode=0/1, band=0..15 + type/freq/q/gain, save=1 zapisuje /peq.cfg
+server.on("/peqSet", HTTP_POST, [](AsyncWebServerRequest *request){
+  auto getFloat = [&](const char* n, float def)->float {
+    if(!request->hasParam(n, true)) return def;
+    return request->getParam(n, true)->value().toFloat();
+  };
+
+  if (request->hasParam("mode", true)) {
+    eq_peq_set_mode(request->getParam("mode", true)->value().toInt() != 0);
+  }
+
+  if (request->hasParam("band", true)) {
+    int band = request->getParam("band", true)->value().toInt();
+    EqPeqBand b;
+    if (!eq_peq_get_band(band, &b)) {
+      request->send(400, "text/plain", "bad band");
+      return;
+    }
+    b.type   = (uint8_t)getFloat("type", b.type);
+    b.freq   = getFloat("freq", b.freq);
+    b.q      = getFloat("q", b.q);
+    b.gainDb = getFloat("gain", b.gainDb);
+    eq_peq_set_band(band, b);
+  }
+
+  if (request->hasParam("save", true) && request->getParam("save", true)->value() == "1") {
+    eq_peq_save();
+  }
+
+  request->send(200, "application/json", eq_peq_to_json());
+});
+#endif
+
 // -----------------------------------------------------------------------------------------
 
 server.begin();
@@ -9247,7 +9708,7 @@ server.begin();
     u8g2.drawStr(5, 13, "No network connection");  // W przypadku braku polaczenia wifi - wyswietl komunikat na wyswietlaczu OLED
     u8g2.drawStr(5, 26, "Connect to WiFi: ESP Internet Radio");
     u8g2.drawStr(5, 39, "Open web page http://192.168.4.1");
-    u8g2.sendBuffer();
+    oledFlush();
     while(true)
     { 
       wifiManager.process(); 
@@ -9326,7 +9787,7 @@ server.begin();
         currentIP = WiFi.localIP().toString();
         showIP(1,55);
         u8g2.drawStr(1, 63, "Reseting...");
-        u8g2.sendBuffer();
+        oledFlush();
         delay(2000);
         REG_WRITE(RTC_CNTL_OPTIONS0_REG, RTC_CNTL_SW_SYS_RST); // Restart pełen sprzętowy jak z przycisku reset
       }
@@ -9379,7 +9840,7 @@ void loop()
     displayDimmer(0); 
     clearFlags();
     displayRadio();
-    u8g2.sendBuffer();
+    oledFlush();
     currentSelection = station_nr - 1; // Przywracamy zaznaczenie obecnie grajacej stacji
   }
 
@@ -9466,7 +9927,7 @@ void loop()
           if (station_nr > stationsCount) { station_nr = 1; } // Przwijanie listy stacji w pętli po osiągnieciu ostatniej stacji banku przewijamy do pierwszej.
           changeStation();
           displayRadio();
-          u8g2.sendBuffer();
+          oledFlush();
         }
       }
       else if (ir_code == rcCmdArrowLeft) // strzałka w lewo - poprzednia stacja, bank lub nastawy equalizera
@@ -9518,7 +9979,7 @@ void loop()
           if (station_nr < 1) { station_nr = stationsCount; } // Przwijanie listy stacji w pętli po osiągnieciu ostatniej stacji banku przewijamy do pierwszej.
           changeStation();
           displayRadio();
-          u8g2.sendBuffer();
+          oledFlush();
         }
       }
       else if ((ir_code == rcCmdArrowUp) && (volumeSet == false) && (equalizerMenuEnable == true))
@@ -9642,7 +10103,7 @@ void loop()
           else if (urlPlaying) { webUrlStationPlay();}
           clearFlags();                                             // Czyscimy wszystkie flagi przebywania w różnych menu
           displayRadio();
-          u8g2.sendBuffer();
+          oledFlush();
         }
         equalizerMenuEnable = false; // Kasujemy flage ustawiania equalizera
         volumeSet = false; // Kasujemy flage ustawiania głośnosci
@@ -9662,7 +10123,7 @@ void loop()
         displayDimmer(0);
         clearFlags();   // Zerujemy wszystkie flagi
         displayRadio(); // Ładujemy erkran radia
-        u8g2.sendBuffer(); // Wysyłamy bufor na wyswietlacz
+        oledFlush(); // Wysyłamy bufor na wyswietlacz
         currentSelection = station_nr - 1; // Przywracamy zaznaczenie obecnie grajacej stacji
       }
       else if (ir_code == rcCmdMute) 
@@ -9767,6 +10228,48 @@ void loop()
   }
   
   
+  if (displayScriptPending) // Stan zadany z /displayScript (zrzuty ekranu do porównania ze wzorcem)
+  {
+    static bool   scriptActive = false;
+    static uint8_t savedMode;
+    static bool   savedMute;
+    static String savedName, savedString;
+    displayScriptPending = false;
+
+    if (!scriptActive && !displayScriptReq.off)
+    {
+      scriptActive = true;
+      savedMode = displayMode;
+      savedMute = volumeMute;
+      savedName = stationName;
+      savedString = stationString;
+    }
+    if (displayScriptReq.off)
+    {
+      if (scriptActive)
+      {
+        scriptActive = false;
+        displayMode = savedMode;
+        volumeMute = savedMute;
+        stationName = savedName;
+        stationString = savedString;
+      }
+    }
+    else
+    {
+      displayMode = displayScriptReq.mode;
+      volumeMute = displayScriptReq.mute;
+      if (displayScriptReq.setText)
+      {
+        stationName = displayScriptReq.station;
+        stationString = displayScriptReq.title;
+      }
+    }
+    oledInvalidate();
+    displayRadio();
+    ActionNeedUpdateTime = true;
+  }
+
   /*---------------------  FUNKCJA PETLI MILLIS SCROLLER / Odswiezanie VU Meter, Time, Scroller, OLED, WiFi ver. 1 ---------------------*/ 
   if ((millis() - scrollingStationStringTime > scrollingRefresh) && (displayActive == false)) 
   {
@@ -9808,8 +10311,29 @@ void loop()
       }
     }
 
+    // Stan dla stylów 5-12 – z zadaniem OLED rysuje je zadanie, loop() tylko publikuje
+    OledFrameState oledSt;
+    oledSt.displayMode = displayMode;
+    oledSt.volume      = volumeValue;
+    oledSt.mute        = volumeMute;
+    oledSt.audioFill   = 100;
+    if (audio.isRunning())
+    {
+      uint32_t inFilled = audio.inBufferFilled();
+      uint32_t inTotal  = inFilled + audio.inBufferFree();
+      if (inTotal > 0) oledSt.audioFill = (uint8_t)((uint64_t)inFilled * 100 / inTotal);
+    }
+    const String& oledStation = (stationName.length() > 0) ? stationName :
+                                (stationNameStream.length() > 0) ? stationNameStream : stationStringWeb;
+    strlcpy(oledSt.station, oledStation.c_str(), sizeof(oledSt.station));
+    bool analyzerInTask = vuMeterOn && (displayMode >= 5) && (displayMode <= 12) && oledRenderActive();
+    oledSt.analyzer = analyzerInTask;
+    oledPostState(oledSt);
+
     if (vuMeterOn)
     { 
+      uint32_t vuDrawT0 = micros();  // czas rysowania stylu -> /displayStats (drawUs)
+
       // Style 0, 3, 4 tylko gdy nie mute
       if (volumeMute == false) {
         if (displayMode == 0) {vuMeterMode0();}
@@ -9826,17 +10350,25 @@ void loop()
             }
           }
         }
+        if (displayMode == 0 || displayMode == 3 || displayMode == 4) {oledNoteDrawTime(displayMode, micros() - vuDrawT0);}
       }
       
-      // Style 5-9 zawsze (również podczas mute dla animacji)
-      if (displayMode == 5) {vuMeterMode5();}
-      if (displayMode == 6) {vuMeterMode6();}
-      if (displayMode == 7) {vuMeterMode7();}  // Nowy styl: Okrągły
-      if (displayMode == 8) {vuMeterMode8();}  // Nowy styl: Liniowy
-      if (displayMode == 9) {vuMeterMode9();}  // Nowy styl: Spadające gwiazdki jak śnieg
+      // Style 5-12 zawsze (również podczas mute dla animacji); z zadaniem OLED rysuje je zadanie
+      if (!analyzerInTask && (displayMode < 5 || displayMode > 12 || analyzerFrameDue(oledSt)))
+      {
+        if (displayMode == 5) {vuMeterMode5();}
+        if (displayMode == 6) {vuMeterMode6();}
+        if (displayMode == 7) {vuMeterMode7();}  // Nowy styl: Okrągły
+        if (displayMode == 8) {vuMeterMode8();}  // Nowy styl: Liniowy
+        if (displayMode == 9) {vuMeterMode9();}  // Nowy styl: Spadające gwiazdki jak śnieg
+        if (displayMode == 10) {vuMeterMode10();} // Waterfall – historia pasm
+        if (displayMode == 11) {vuMeterMode11();} // Oscyloskop z tapu przebiegu
+        if (displayMode == 12) {vuMeterMode12();} // Lissajous X/Y
+        if (displayMode >= 5 && displayMode <= 12) {oledNoteDrawTime(displayMode, micros() - vuDrawT0);}
+      }
         
-      // Powiedz analizatorowi, że ma spać gdy style 5-9 nie są aktywne
-      if (displayMode < 5 || displayMode > 9) {
+      // Powiedz analizatorowi, że ma spać gdy style 5-12 nie są aktywne
+      if (displayMode < 5 || displayMode > 12) {
         eq_analyzer_set_runtime_active(false);
       }
     }
@@ -9866,8 +10398,11 @@ void loop()
       displayRadio();
     }
     
-    displayRadioScroller();  // wykonujemy przewijanie tekstu station stringi przygotowujemy bufor ekranu
-    u8g2.sendBuffer();  // rysujemy całą zawartosc ekranu.
+    if (!analyzerInTask)  // ekran stylów 5-12 należy do zadania OLED
+    {
+      displayRadioScroller();  // wykonujemy przewijanie tekstu station stringi przygotowujemy bufor ekranu
+      oledFlush();  // rysujemy całą zawartosc ekranu.
+    }
     
     //if (f_callInfo) {f_callInfo = false; displayBasicInfo();}  
     
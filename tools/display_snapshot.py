@@ -0,0 +1,167 @@
+#!/usr/bin/env python3
+"""Testy zrzutów ekranu OLED na radiu w sieci.
+
+Dla każdego przypadku z display_cases.json ustawia stan przez POST
+/displayScript (tryb, mute, nazwa stacji, tytuł, poziomy VU w dBFS), czeka
+settle_ms, pobiera /display.pbm i porównuje z wzorcem display_ref/<nazwa>.pbm.
+Piksele w prostokątach "mask" (zegar, WiFi, parametry strumienia) są pomijane.
+Na końcu /displayScript off=1 przywraca tryb, mute i teksty sprzed testu.
+
+  python3 tools/display_snapshot.py 192.168.1.50             # porównanie
+  python3 tools/display_snapshot.py 192.168.1.50 --record    # nowe wzorce
+  python3 tools/display_snapshot.py 192.168.1.50 --only mode4_needles
+
+Wzorce nagrywa się na płytce referencyjnej (--record) i commituje razem ze
+zmianą, która świadomie zmienia wygląd. Przy różnicy zapisuje <nazwa>.actual.pbm
+i <nazwa>.diff.pbm do --out. Kod wyjścia 1 = różnica albo brak wzorca.
+"""
+
+import argparse
+import json
+import os
+import sys
+import time
+import urllib.parse
+import urllib.request
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+
+
+def read_pbm(data):
+    """P4 → (szerokość, wysokość, wiersze bajtów)."""
+    fields = []
+    pos = 0
+    while len(fields) < 3:
+        while data[pos:pos + 1].isspace():
+            pos += 1
+        if data[pos:pos + 1] == b"#":
+            pos = data.index(b"\n", pos) + 1
+            continue
+        end = pos
+        while not data[end:end + 1].isspace():
+            end += 1
+        fields.append(data[pos:end])
+        pos = end
+    if fields[0] != b"P4":
+        raise ValueError("to nie jest PBM P4")
+    w, h = int(fields[1]), int(fields[2])
+    pos += 1  # jeden biały znak po nagłówku
+    stride = (w + 7) // 8
+    body = data[pos:pos + stride * h]
+    if len(body) != stride * h:
+        raise ValueError("PBM ucięty")
+    return w, h, [body[y * stride:(y + 1) * stride] for y in range(h)]
+
+
+def write_pbm(path, w, h, rows):
+    with open(path, "wb") as f:
+        f.write(b"P4\n%d %d\n" % (w, h))
+        for r in rows:
+            f.write(bytes(r))
+
+
+def masked(x, y, masks):
+    return any(mx <= x < mx + mw and my <= y < my + mh for mx, my, mw, mh in masks)
+
+
+def compare(ref, act, masks):
+    """Liczba różnych pikseli poza maskami i obraz różnicy."""
+    w, h, rrows = ref
+    aw, ah, arows = act
+    if (w, h) != (aw, ah):
+        raise ValueError("rozmiar %dx%d, wzorzec %dx%d" % (aw, ah, w, h))
+    diff = 0
+    drows = []
+    for y in range(h):
+        row = bytearray(len(rrows[y]))
+        for bx, (rb, ab) in enumerate(zip(rrows[y], arows[y])):
+            x = rb ^ ab
+            if not x:
+                continue
+            for bit in range(8):
+                if x & (0x80 >> bit) and not masked(bx * 8 + bit, y, masks):
+                    row[bx] |= 0x80 >> bit
+                    diff += 1
+        drows.append(row)
+    return diff, drows
+
+
+def post_state(base, state, timeout):
+    body = urllib.parse.urlencode(state).encode()
+    req = urllib.request.Request(base + "/displayScript", data=body, method="POST")
+    for _ in range(20):
+        try:
+            urllib.request.urlopen(req, timeout=timeout).read()
+            return
+        except urllib.error.HTTPError as e:
+            if e.code != 409:  # 409 = poprzedni stan jeszcze nie zastosowany
+                raise
+            time.sleep(0.1)
+    raise RuntimeError("/displayScript zajęty")
+
+
+def fetch_pbm(base, timeout):
+    return urllib.request.urlopen(base + "/display.pbm", timeout=timeout).read()
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("host", help="adres radia, np. 192.168.1.50")
+    ap.add_argument("--cases", default=os.path.join(HERE, "display_cases.json"))
+    ap.add_argument("--ref", default=os.path.join(HERE, "display_ref"))
+    ap.add_argument("--out", default="display_out", help="katalog na zrzuty z różnicą")
+    ap.add_argument("--record", action="store_true", help="zapisz zrzuty jako nowe wzorce")
+    ap.add_argument("--only", action="append", help="tylko podane przypadki")
+    ap.add_argument("--tolerance", type=int, default=0, help="dopuszczalna liczba różnych pikseli")
+    ap.add_argument("--timeout", type=float, default=5.0)
+    args = ap.parse_args()
+
+    base = args.host if args.host.startswith("http") else "http://" + args.host
+    with open(args.cases, encoding="utf-8") as f:
+        spec = json.load(f)
+    settle = spec.get("settle_ms", 1500) / 1000.0
+    cases = [c for c in spec["cases"] if not args.only or c["name"] in args.only]
+
+    if args.record:
+        os.makedirs(args.ref, exist_ok=True)
+    failed = 0
+    try:
+        for case in cases:
+            name = case["name"]
+            post_state(base, case["state"], args.timeout)
+            time.sleep(settle)
+            act = read_pbm(fetch_pbm(base, args.timeout))
+            ref_path = os.path.join(args.ref, name + ".pbm")
+
+            if args.record:
+                write_pbm(ref_path, *act)
+                print("%-16s zapisany wzorzec" % name)
+                continue
+            if not os.path.exists(ref_path):
+                print("%-16s BRAK WZORCA (%s) – nagraj z --record" % (name, ref_path))
+                failed += 1
+                continue
+
+            with open(ref_path, "rb") as f:
+                ref = read_pbm(f.read())
+            diff, drows = compare(ref, act, case.get("mask", []))
+            if diff <= args.tolerance:
+                print("%-16s OK (%d px)" % (name, diff))
+                continue
+            failed += 1
+            os.makedirs(args.out, exist_ok=True)
+            write_pbm(os.path.join(args.out, name + ".actual.pbm"), *act)
+            write_pbm(os.path.join(args.out, name + ".diff.pbm"), act[0], act[1], drows)
+            print("%-16s RÓŻNICA %d px → %s" % (name, diff, args.out))
+    finally:
+        post_state(base, {"off": 1}, args.timeout)
+
+    if args.record:
+        print("zapisano %d wzorców w %s" % (len(cases), args.ref))
+    else:
+        print("%d/%d przypadków z błędem" % (failed, len(cases)) if failed else "wszystkie zgodne")
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())